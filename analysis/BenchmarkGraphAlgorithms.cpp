@@ -22,7 +22,10 @@
 #include "Molassembler/Temple/constexpr/Numeric.h"
 
 #include <chrono>
+#include <cmath>
+#include <fstream>
 #include <iomanip>
+#include <random>
 
 using namespace Scine;
 using namespace Molassembler;
@@ -37,7 +40,7 @@ std::ostream& nl(std::ostream& os) {
 template<typename TimingCallable, size_t N>
 std::pair<double, double> timeFunctor(
   const Molecule& molecule,
-  const DistanceGeometry::SpatialModel::BoundsMatrix& bounds,
+  const DistanceGeometry::PairwiseBounds& bounds,
   DistanceGeometry::Partiality partiality
 ) {
   using namespace std::chrono;
@@ -49,7 +52,7 @@ std::pair<double, double> timeFunctor(
   std::array<double, N> timings;
 
   for(std::size_t n = 0; n < N; ++n) {
-    Eigen::MatrixXd boundsCopy = bounds;
+    DistanceGeometry::PairwiseBounds boundsCopy = bounds;
     start = steady_clock::now();
     functor(molecule, std::move(boundsCopy), partiality);
     end = steady_clock::now();
@@ -69,11 +72,11 @@ template<class Graph>
 struct Gor1Functor {
   Eigen::MatrixXd operator() (
     const Molecule& molecule,
-    DistanceGeometry::SpatialModel::BoundsMatrix boundsMatrix,
+    DistanceGeometry::PairwiseBounds boundsMatrix,
     DistanceGeometry::Partiality partiality
   ) {
 
-    Graph graph {molecule.graph().inner(), std::move(boundsMatrix)};
+    Graph graph {molecule.graph().inner(), boundsMatrix.toMatrix()};
     if(auto distanceMatrixResult = graph.makeDistanceMatrix(randomnessEngine(), partiality)) {
       return distanceMatrixResult.value();
     }
@@ -86,10 +89,10 @@ struct Gor1Functor {
 struct DBM_FW_Functor {
   Eigen::MatrixXd operator() (
     const Molecule& molecule,
-    DistanceGeometry::SpatialModel::BoundsMatrix boundsMatrix,
+    DistanceGeometry::PairwiseBounds boundsMatrix,
     DistanceGeometry::Partiality partiality
   ) {
-    DistanceGeometry::DistanceBoundsMatrix bounds {molecule.graph().inner(), std::move(boundsMatrix)};
+    DistanceGeometry::DistanceBoundsMatrix bounds {molecule.graph().inner(), boundsMatrix.toMatrix()};
 
     bounds.smooth();
 
@@ -242,6 +245,111 @@ void benchmark(
   }
 }
 
+/* Textbook triangle smoothing with unblocked, branchy access into a single
+ * bounds matrix, as a baseline for DistanceBoundsMatrix::smooth
+ */
+void textbookSmooth(Eigen::MatrixXd& matrix) {
+  const unsigned N = matrix.cols();
+
+  for(AtomIndex k = 0; k < N; ++k) {
+    for(AtomIndex i = 0; i < N - 1; ++i) {
+      const double upperIK = DistanceGeometry::DistanceBoundsMatrix::upperBound(matrix, i, k);
+      const double lowerIK = DistanceGeometry::DistanceBoundsMatrix::lowerBound(matrix, i, k);
+
+      for(AtomIndex j = i + 1; j < N; ++j) {
+        double& upperIJ = matrix(i, j);
+        double& lowerIJ = matrix(j, i);
+
+        const double upperJK = DistanceGeometry::DistanceBoundsMatrix::upperBound(matrix, j, k);
+        const double lowerJK = DistanceGeometry::DistanceBoundsMatrix::lowerBound(matrix, j, k);
+
+        if(upperIJ > upperIK + upperJK) {
+          upperIJ = upperIK + upperJK;
+        }
+
+        if(lowerIJ < lowerIK - upperJK) {
+          lowerIJ = lowerIK - upperJK;
+        } else if(lowerIJ < lowerJK - upperIK) {
+          lowerIJ = lowerJK - upperIK;
+        }
+      }
+    }
+  }
+}
+
+/* Bounds resembling a molecule: Tight bounds on pairs close in sequence
+ * around distances between random positions, loose bounds otherwise. Since
+ * the positions are real, the bounds are consistent.
+ */
+Eigen::MatrixXd syntheticBounds(const unsigned N, std::mt19937& prng) {
+  std::uniform_real_distribution<double> coordinate {0.0, std::cbrt(10.0 * N)};
+  Eigen::Matrix3Xd positions(3, N);
+  for(unsigned i = 0; i < N; ++i) {
+    positions.col(i) << coordinate(prng), coordinate(prng), coordinate(prng);
+  }
+
+  Eigen::MatrixXd bounds(N, N);
+  for(unsigned i = 0; i < N; ++i) {
+    bounds(i, i) = 0.0;
+    for(unsigned j = i + 1; j < N; ++j) {
+      const double distance = (positions.col(i) - positions.col(j)).norm();
+      if(j - i <= 3) {
+        bounds(i, j) = 1.05 * distance;
+        bounds(j, i) = 0.95 * distance;
+      } else {
+        bounds(i, j) = DistanceGeometry::DistanceBoundsMatrix::defaultUpper;
+        bounds(j, i) = 0.0;
+      }
+    }
+  }
+
+  return bounds;
+}
+
+void benchmarkSmoothing(const unsigned maxN) {
+  using namespace std::chrono;
+
+  std::mt19937 prng {1042};
+
+  std::ofstream benchmarkFile ("smoothing_timings.csv");
+  benchmarkFile << "\"N\", \"Textbook\", \"Blocked\"" << nl;
+  benchmarkFile << std::scientific << std::setprecision(6);
+
+  std::cout << std::setw(8) << "N"
+    << std::setw(16) << "Textbook / s"
+    << std::setw(16) << "Blocked / s"
+    << std::setw(10) << "Speedup" << nl;
+
+  for(const unsigned N : {100u, 200u, 500u, 1000u, 2000u, 5000u}) {
+    if(N > maxN) {
+      break;
+    }
+
+    const Eigen::MatrixXd bounds = syntheticBounds(N, prng);
+
+    Eigen::MatrixXd textbook = bounds;
+    auto start = steady_clock::now();
+    textbookSmooth(textbook);
+    const double textbookTime = duration<double>(steady_clock::now() - start).count();
+
+    Eigen::MatrixXd blocked = bounds;
+    start = steady_clock::now();
+    DistanceGeometry::DistanceBoundsMatrix::smooth(blocked);
+    const double blockedTime = duration<double>(steady_clock::now() - start).count();
+
+    if(!blocked.isApprox(textbook, 1e-10)) {
+      std::cout << "Blocked smoothing deviates from textbook smoothing for N = " << N << nl;
+    }
+
+    std::cout << std::setw(8) << N
+      << std::setw(16) << std::setprecision(4) << textbookTime
+      << std::setw(16) << blockedTime
+      << std::setw(10) << std::setprecision(2) << (textbookTime / blockedTime) << nl;
+
+    benchmarkFile << N << ", " << textbookTime << ", " << blockedTime << nl;
+  }
+}
+
 using namespace std::string_literals;
 const std::string algorithmChoices =
   "  0 - Matrix Floyd-Warshall\n"
@@ -263,6 +371,7 @@ int main(int argc, char* argv[]) {
     ("c", boost::program_options::value<unsigned>(), "Specify algorithm / graph combination to benchmark")
     ("p", boost::program_options::value<unsigned>(), "Specify partiality")
     ("m", boost::program_options::value<std::string>(), "Path to MOLFiles to benchmark")
+    ("s", boost::program_options::value<unsigned>(), "Benchmark triangle smoothing on synthetic bounds up to the specified system size")
   ;
 
   // Parse
@@ -279,6 +388,11 @@ int main(int argc, char* argv[]) {
     return 0;
   }
 
+  if(options_variables_map.count("s") > 0) {
+    benchmarkSmoothing(options_variables_map["s"].as<unsigned>());
+    return 0;
+  }
+
   if(options_variables_map.count("m") == 0) {
     std::cout << "You have not specified any path to MOLFiles that could be used" << nl;
     return 0;
@@ -191,7 +191,9 @@ boost::optional<unsigned> eigenRefine(
   const std::vector<DistanceGeometry::ChiralConstraint>& chiralConstraints,
   const std::vector<DistanceGeometry::DihedralConstraint>& dihedralConstraints,
   const Eigen::MatrixXd& positions,
-  OptimizerParameters optimizerParameters = {}
+  OptimizerParameters optimizerParameters = {},
+  const double gradNorm = 1e-5,
+  Eigen::VectorXd* refinedPositions = nullptr
 ) {
   unsigned iterationCount = 0;
 
@@ -257,6 +259,7 @@ boost::optional<unsigned> eigenRefine(
   refinementFunctor.compressFourthDimension = true;
 
   GradientOrIterLimitStop<FloatType> gradientChecker;
+  gradientChecker.gradNorm = gradNorm;
 
   unsigned iterations;
   try {
@@ -280,9 +283,52 @@ boost::optional<unsigned> eigenRefine(
 
   iterationCount += iterations;
 
+  if(refinedPositions != nullptr) {
+    *refinedPositions = transformedPositions.template cast<double>();
+  }
+
   return iterationCount;
 }
 
+/* Refines coarsely in single precision with SIMD, then continues in double
+ * precision to the same convergence criterion as eigenRefine
+ */
+template<unsigned dimensionality>
+boost::optional<unsigned> mixedPrecisionRefine(
+  const Eigen::MatrixXd& squaredBounds,
+  const std::vector<DistanceGeometry::ChiralConstraint>& chiralConstraints,
+  const std::vector<DistanceGeometry::DihedralConstraint>& dihedralConstraints,
+  const Eigen::MatrixXd& positions
+) {
+  Eigen::VectorXd coarsePositions;
+  const auto coarseIterations = eigenRefine<dimensionality, float, true>(
+    squaredBounds,
+    chiralConstraints,
+    dihedralConstraints,
+    positions,
+    {},
+    1e-3,
+    &coarsePositions
+  );
+
+  if(!coarseIterations) {
+    return boost::none;
+  }
+
+  const auto fineIterations = eigenRefine<dimensionality, double, false>(
+    squaredBounds,
+    chiralConstraints,
+    dihedralConstraints,
+    coarsePositions
+  );
+
+  if(!fineIterations) {
+    return boost::none;
+  }
+
+  return coarseIterations.value() + fineIterations.value();
+}
+
 
 template<unsigned dimensionality, typename FloatType, bool SIMD>
 struct EigenFunctor final : public TimingFunctor {
@@ -319,6 +365,27 @@ struct EigenFunctor final : public TimingFunctor {
   }
 };
 
+template<unsigned dimensionality>
+struct MixedPrecisionFunctor final : public TimingFunctor {
+  boost::optional<unsigned> value(
+    const Eigen::MatrixXd& squaredBounds,
+    const std::vector<DistanceGeometry::ChiralConstraint>& chiralConstraints,
+    const std::vector<DistanceGeometry::DihedralConstraint>& dihedralConstraints,
+    const Eigen::MatrixXd& positions
+  ) final {
+    return mixedPrecisionRefine<dimensionality>(
+      squaredBounds,
+      chiralConstraints,
+      dihedralConstraints,
+      positions
+    );
+  }
+
+  std::string name() final {
+    return "Mixed<" + std::to_string(dimensionality) + ">";
+  }
+};
+
 void writeHeaders(
   std::ofstream& benchmarkFile
 ) {
@@ -327,7 +394,8 @@ void writeHeaders(
     "N",
     "E",
     "Eigen",
-    "EigenSIMD"
+    "EigenSIMD",
+    "Mixed"
   };
 
   for(unsigned i = 0; i < 2; ++i) {
@@ -351,7 +419,8 @@ enum class Algorithm {
   EigenDouble,
   EigenFloat,
   EigenSIMDDouble,
-  EigenSIMDFloat
+  EigenSIMDFloat,
+  MixedPrecision
 };
 
 void benchmark(
@@ -425,6 +494,14 @@ void benchmark(
     );
   }
 
+  if(algorithmChoice == Algorithm::All || algorithmChoice == Algorithm::MixedPrecision) {
+    functors.emplace_back(
+      std::make_unique<
+        MixedPrecisionFunctor<4>
+      >()
+    );
+  }
+
   auto results = timeFunctors<nExperiments>(molecule, functors);
 
   double smallestAverage = std::min_element(
@@ -475,7 +552,8 @@ const std::string algorithmChoices =
   "  1 - Eigen<dimensionality=4, double, SIMD=false>\n"
   "  2 - Eigen<dimensionality=4, float, SIMD=false>\n"
   "  3 - Eigen<dimensionality=4, double, SIMD=true>\n"
-  "  4 - Eigen<dimensionality=4, float, SIMD=true>\n";
+  "  4 - Eigen<dimensionality=4, float, SIMD=true>\n"
+  "  5 - Eigen<dimensionality=4, float, SIMD=true>, then Eigen<dimensionality=4, double, SIMD=false>\n";
 
 constexpr const char* description =
   "Benchmarks various refinement error functions and optimizer combinations\n"
@@ -523,7 +601,7 @@ int main(int argc, char* argv[]) {
   if(options_variables_map.count("c") > 0) {
     unsigned combination = options_variables_map["c"].as<unsigned>();
 
-    if(combination > 4) {
+    if(combination > 5) {
       std::cout << "Specified algorithm is out of bounds. Valid choices are:" << nl
         << algorithmChoices;
       return 0;
@@ -0,0 +1,680 @@
+/*!@file
+ * @copyright This code is licensed under the 3-clause BSD license.
+ *   Copyright ETH Zurich, Laboratory of Physical Chemistry, Reiher Group.
+ *   See LICENSE.txt for details.
+ *
+ * Benchmarks key pipeline stages on a directory of molecules (by default the
+ * CBOR serializations in test/data) and reports robust timing statistics.
+ *
+ * Each benchmark is warmed up once and then repeated until both a minimum
+ * number of repetitions and a minimum total runtime are reached. Reported are
+ * the median, the median absolute deviation (scaled to be consistent with the
+ * standard deviation for normally distributed timings), minimum and maximum.
+ * Results are written as JSON for tracking across commits.
+ *
+ * Smiles parsing benchmarks compare the Boost.Spirit parser with bulk parsing
+ * of newline-delimited smiles, either on a built-in set or on a supplied
+ * smiles file, and report throughput in molecules per second.
+ *
+ * Molecule copies are timed alone and followed by a stereopermutator
+ * assignment. On Linux, the resident memory growth per copy is reported too.
+ *
+ * Subgraph matching benchmarks compare the Boost VF2 path with the modes of
+ * the native matcher on the same needle.
+ */
+
+#define BOOST_FILESYSTEM_NO_DEPRECATED
+
+#include "boost/filesystem.hpp"
+#include "boost/program_options.hpp"
+
+#include "Molassembler/DistanceGeometry/ConformerGeneration.h"
+#include "Molassembler/DistanceGeometry/DistanceBoundsMatrix.h"
+#include "Molassembler/DistanceGeometry/ExplicitBoundsGraph.h"
+#include "Molassembler/DistanceGeometry/MetricMatrix.h"
+#include "Molassembler/Graph/Canonicalization.h"
+#include "Molassembler/Graph/PrivateGraph.h"
+#include "Molassembler/Molecule/AtomEnvironmentHash.h"
+#include "Molassembler/Shapes/ContinuousMeasures.h"
+#include "Molassembler/Shapes/Data.h"
+
+#include "Molassembler/AtomStereopermutator.h"
+#include "Molassembler/Conformers.h"
+#include "Molassembler/Graph.h"
+#include "Molassembler/Interpret.h"
+#include "Molassembler/IO.h"
+#include "Molassembler/IO/SmilesParser.h"
+#include "Molassembler/Molecule.h"
+#include "Molassembler/Options.h"
+#include "Molassembler/Profiling.h"
+#include "Molassembler/Serialization.h"
+#include "Molassembler/StereopermutatorList.h"
+#include "Molassembler/Subgraphs.h"
+
+#include "Utils/Geometry/AtomCollection.h"
+#include "Utils/Bonds/BondOrderCollection.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+using namespace Scine;
+using namespace Molassembler;
+
+std::ostream& nl(std::ostream& os) {
+  os << '\n';
+  return os;
+}
+
+//! Prevents the compiler from eliding computation of a value
+template<typename T>
+void doNotOptimize(const T& value) {
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+struct RepetitionSettings {
+  unsigned minRepetitions = 5;
+  unsigned maxRepetitions = 1000;
+  double minSeconds = 0.5;
+};
+
+struct Statistics {
+  std::string name;
+  std::string molecule;
+  unsigned N = 0;
+  unsigned repetitions = 0;
+  double median = 0;
+  double mad = 0;
+  double min = 0;
+  double max = 0;
+};
+
+double median(std::vector<double> values) {
+  assert(!values.empty());
+  const auto middle = std::begin(values) + values.size() / 2;
+  std::nth_element(std::begin(values), middle, std::end(values));
+  if(values.size() % 2 == 1) {
+    return *middle;
+  }
+
+  const double upper = *middle;
+  const double lower = *std::max_element(std::begin(values), middle);
+  return (lower + upper) / 2;
+}
+
+Statistics summarize(const std::vector<double>& timings) {
+  Statistics stats;
+  stats.repetitions = timings.size();
+  stats.median = median(timings);
+  std::vector<double> deviations(timings.size());
+  std::transform(
+    std::begin(timings),
+    std::end(timings),
+    std::begin(deviations),
+    [&](const double t) { return std::fabs(t - stats.median); }
+  );
+  // Consistency factor for normally distributed data
+  stats.mad = 1.4826 * median(deviations);
+  stats.min = *std::min_element(std::begin(timings), std::end(timings));
+  stats.max = *std::max_element(std::begin(timings), std::end(timings));
+  return stats;
+}
+
+class Suite {
+public:
+  Suite(RepetitionSettings settings, std::string filter)
+    : settings_(settings), filter_(std::move(filter)) {}
+
+  /*! @brief Benchmark a callable
+   *
+   * @param setup Callable run before each repetition, untimed. Its return
+   *   value is passed to @p f.
+   * @param f Timed callable
+   *
+   * @return Whether the benchmark was run, i.e. not filtered out
+   */
+  template<typename Setup, typename F>
+  bool run(
+    const std::string& name,
+    const std::string& moleculeName,
+    const unsigned N,
+    Setup&& setup,
+    F&& f
+  ) {
+    if(!filter_.empty() && name.find(filter_) == std::string::npos) {
+      return false;
+    }
+
+    using namespace std::chrono;
+
+    // Warm up caches and lazily initialized data
+    {
+      auto input = setup();
+      doNotOptimize(f(input));
+    }
+
+    std::vector<double> timings;
+    double totalSeconds = 0;
+    while(
+      timings.size() < settings_.maxRepetitions
+      && (timings.size() < settings_.minRepetitions || totalSeconds < settings_.minSeconds)
+    ) {
+      auto input = setup();
+      const auto start = steady_clock::now();
+      doNotOptimize(f(input));
+      const auto end = steady_clock::now();
+      const double seconds = duration_cast<duration<double>>(end - start).count();
+      timings.push_back(seconds * 1e6);
+      totalSeconds += seconds;
+    }
+
+    Statistics stats = summarize(timings);
+    stats.name = name;
+    stats.molecule = moleculeName;
+    stats.N = N;
+
+    std::cout << std::left << std::setw(36) << name
+      << std::setw(28) << moleculeName.substr(0, 27)
+      << std::right << std::setw(6) << N
+      << std::fixed << std::setprecision(1)
+      << std::setw(14) << stats.median
+      << std::setw(12) << stats.mad
+      << std::setw(8) << stats.repetitions << nl;
+
+    results_.push_back(std::move(stats));
+    return true;
+  }
+
+  //! Statistics of the most recent benchmark run
+  const Statistics& latest() const {
+    assert(!results_.empty());
+    return results_.back();
+  }
+
+  //! Benchmark a callable without per-repetition setup
+  template<typename F>
+  bool run(
+    const std::string& name,
+    const std::string& moleculeName,
+    const unsigned N,
+    F&& f
+  ) {
+    return run(name, moleculeName, N, []() { return 0; }, [&](int /* unused */) { return f(); });
+  }
+
+  void writeJSON(std::ostream& os, const std::string& tag) const {
+    os << "{\n  \"tag\": \"" << tag << "\",\n"
+      << "  \"unit\": \"us\",\n"
+      << "  \"min_repetitions\": " << settings_.minRepetitions << ",\n"
+      << "  \"min_seconds\": " << settings_.minSeconds << ",\n"
+      << "  \"benchmarks\": [\n";
+    os << std::setprecision(9);
+    for(unsigned i = 0; i < results_.size(); ++i) {
+      const Statistics& stats = results_[i];
+      os << "    {\"name\": \"" << stats.name
+        << "\", \"molecule\": \"" << stats.molecule
+        << "\", \"N\": " << stats.N
+        << ", \"repetitions\": " << stats.repetitions
+        << ", \"median\": " << stats.median
+        << ", \"mad\": " << stats.mad
+        << ", \"min\": " << stats.min
+        << ", \"max\": " << stats.max << "}";
+      if(i + 1 != results_.size()) {
+        os << ",";
+      }
+      os << nl;
+    }
+    os << "  ]";
+    if(Profiling::enabled()) {
+      os << ",\n  \"profile\": " << Profiling::json();
+    }
+    os << "\n}\n";
+  }
+
+private:
+  RepetitionSettings settings_;
+  std::string filter_;
+  std::vector<Statistics> results_;
+};
+
+//! Resident set size of this process in bytes, zero where unavailable
+std::size_t residentBytes() {
+#ifdef __linux__
+  std::ifstream statm("/proc/self/statm");
+  std::size_t totalPages = 0;
+  std::size_t residentPages = 0;
+  if(statm >> totalPages >> residentPages) {
+    return residentPages * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  }
+#endif
+  return 0;
+}
+
+void benchmarkMolecule(Suite& suite, const boost::filesystem::path& filePath) {
+  const Molecule molecule = IO::read(filePath.string());
+  const std::string name = filePath.stem().string();
+  const unsigned N = molecule.graph().N();
+
+  /* Construction, ranking, canonicalization */
+  suite.run("Molecule.construct", name, N, [&]() {
+    return Molecule {molecule.graph()};
+  });
+
+  /* Overhead of finding automorphism orbits during construction, which is
+   * only recovered if ranking symmetry-equivalent atoms is skipped
+   */
+  const PrivateGraph& inner = molecule.graph().inner();
+  const auto orbitHashes = Hashes::generate(
+    inner,
+    boost::none,
+    AtomEnvironmentComponents::ElementTypes | AtomEnvironmentComponents::BondOrders
+  );
+  suite.run("Canonicalization.automorphisms", name, N, [&]() {
+    return AutomorphismOrbits {N, automorphismGenerators(inner, orbitHashes)}.size();
+  });
+
+  /* Copying, which shares graph and stereopermutators until modified, and
+   * the additional memory each copy holds on to
+   */
+  if(suite.run("Molecule.copy", name, N, [&]() { return Molecule {molecule}; })) {
+    const std::size_t before = residentBytes();
+    std::vector<Molecule> copies(256, molecule);
+    const std::size_t after = residentBytes();
+    doNotOptimize(copies);
+    if(before > 0 && after >= before) {
+      std::cout << "  " << (after - before) / copies.size() << " bytes per copy" << nl;
+    }
+  }
+
+  boost::optional<AtomIndex> assignable;
+  unsigned assignment = 0;
+  for(const AtomStereopermutator& permutator : molecule.stereopermutators().atomStereopermutators()) {
+    if(permutator.numAssignments() > 1) {
+      assignable = permutator.placement();
+      assignment = (permutator.assigned().value_or(0) + 1) % permutator.numAssignments();
+      break;
+    }
+  }
+  if(assignable) {
+    const AtomIndex i = *assignable;
+    suite.run("Molecule.copyAndAssign", name, N, [&]() {
+      Molecule copy {molecule};
+      copy.assignStereopermutator(i, assignment);
+      return copy;
+    });
+  }
+
+  suite.run("Molecule.rankAll", name, N, [&]() {
+    unsigned sites = 0;
+    for(AtomIndex i = 0; i < N; ++i) {
+      sites += molecule.rankPriority(i).sites.size();
+    }
+    return sites;
+  });
+
+  suite.run(
+    "Molecule.canonicalize",
+    name,
+    N,
+    [&]() { return molecule; },
+    [](Molecule& copy) { return copy.canonicalize(); }
+  );
+
+  /* Serialization */
+  const auto cbor = JsonSerialization(molecule).toBinary(JsonSerialization::BinaryFormat::CBOR);
+  suite.run("Serialization.toCBOR", name, N, [&]() {
+    return JsonSerialization(molecule).toBinary(JsonSerialization::BinaryFormat::CBOR);
+  });
+  suite.run("Serialization.fromCBOR", name, N, [&]() {
+    return static_cast<Molecule>(
+      JsonSerialization(cbor, JsonSerialization::BinaryFormat::CBOR)
+    );
+  });
+
+  /* Subgraph matching of a three-carbon chain */
+  Molecule needle {Utils::ElementType::C, Utils::ElementType::C};
+  needle.addAtom(Utils::ElementType::C, 1);
+  suite.run("Subgraphs.complete", name, N, [&]() {
+    return Subgraphs::complete(needle, molecule);
+  });
+
+  // Native matcher modes on the same needle for comparison with the Boost path
+  molecule.graph().inner().populateProperties();
+  const Subgraphs::Matcher matcher {needle.graph()};
+  suite.run("Subgraphs.Matcher.find", name, N, [&]() {
+    return matcher.find(molecule.graph());
+  });
+  suite.run("Subgraphs.Matcher.count", name, N, [&]() {
+    return matcher.count(molecule.graph());
+  });
+  suite.run("Subgraphs.Matcher.first", name, N, [&]() {
+    return matcher.first(molecule.graph());
+  });
+  const Subgraphs::Matcher uniqueMatcher {
+    needle.graph(),
+    Subgraphs::VertexStrictness::ElementType,
+    Subgraphs::EdgeStrictness::Topographic,
+    true
+  };
+  suite.run("Subgraphs.Matcher.countUnique", name, N, [&]() {
+    return uniqueMatcher.count(molecule.graph());
+  });
+
+  // Anytime maximum common subgraph with itself within a node budget
+  Subgraphs::SearchBudget budget;
+  budget.nodes = 10000;
+  suite.run("Subgraphs.anytimeMaximum", name, N, [&]() {
+    return Subgraphs::anytimeMaximum(molecule.graph(), molecule.graph(), budget).mapping.size();
+  });
+
+  /* Distance geometry stages */
+  if(molecule.stereopermutators().hasZeroAssignmentStereopermutators()) {
+    std::cout << "Skipping DG stages of " << name << " due to zero-assignment stereopermutators" << nl;
+    return;
+  }
+
+  DistanceGeometry::Configuration configuration;
+  auto& engine = randomnessEngine();
+  const Molecule narrowed = DistanceGeometry::Detail::narrow(molecule, engine);
+
+  suite.run("DG.spatialModel", name, N, [&]() {
+    return DistanceGeometry::gatherDGInformation(narrowed, configuration);
+  });
+
+  auto DgDataPtr = std::make_shared<DistanceGeometry::MoleculeDGInformation>(
+    DistanceGeometry::gatherDGInformation(narrowed, configuration)
+  );
+
+  const DistanceGeometry::ExplicitBoundsGraph explicitGraph {
+    narrowed.graph().inner(),
+    DgDataPtr->bounds
+  };
+
+  suite.run("DG.distanceBounds", name, N, [&]() {
+    return explicitGraph.makeDistanceBounds();
+  });
+
+  suite.run(
+    "DG.distanceMatrix",
+    name,
+    N,
+    [&]() { return explicitGraph; },
+    [&](DistanceGeometry::ExplicitBoundsGraph& graph) {
+      return graph.makeDistanceMatrix(engine, configuration.partiality);
+    }
+  );
+
+  auto distanceMatrixResult = DistanceGeometry::ExplicitBoundsGraph {explicitGraph}.makeDistanceMatrix(engine);
+  if(!distanceMatrixResult) {
+    std::cout << "Skipping further DG stages of " << name << ": " << distanceMatrixResult.error().message() << nl;
+    return;
+  }
+  const Eigen::MatrixXd distances = distanceMatrixResult.value();
+
+  suite.run("DG.embed", name, N, [&]() {
+    return DistanceGeometry::MetricMatrix {distances}.embed();
+  });
+
+  const Eigen::MatrixXd embedded = DistanceGeometry::MetricMatrix {distances}.embed();
+  const DistanceGeometry::DistanceBoundsMatrix distanceBounds {
+    explicitGraph.makeDistanceBounds().value()
+  };
+
+  suite.run("DG.refine", name, N, [&]() {
+    return DistanceGeometry::refine(embedded, distanceBounds, configuration, DgDataPtr);
+  });
+
+  DistanceGeometry::Configuration mixedConfiguration = configuration;
+  mixedConfiguration.mixedPrecisionRefinement = true;
+  suite.run("DG.refineMixedPrecision", name, N, [&]() {
+    return DistanceGeometry::refine(embedded, distanceBounds, mixedConfiguration, DgDataPtr);
+  });
+
+  /* Compare time per successful conformer with and without aborting
+   * stagnating refinements. Difficult inorganic complexes in
+   * test/data/inorganics show the difference best.
+   */
+  auto conformerBenchmark = [&](
+    const std::string& benchmarkName,
+    const DistanceGeometry::Configuration& conformerConfiguration
+  ) {
+    unsigned attempts = 0;
+    unsigned successes = 0;
+    const bool ran = suite.run(benchmarkName, name, N, [&]() {
+      auto result = generateRandomConformation(molecule, conformerConfiguration);
+      ++attempts;
+      if(result) {
+        ++successes;
+      }
+      return result;
+    });
+
+    if(ran) {
+      std::cout << "  " << successes << "/" << attempts << " successful";
+      if(successes > 0) {
+        std::cout << ", " << suite.latest().median * attempts / successes
+          << " us per successful conformer";
+      }
+      std::cout << nl;
+    }
+  };
+
+  conformerBenchmark("DG.conformer", configuration);
+
+  DistanceGeometry::Configuration abortConfiguration = configuration;
+  abortConfiguration.abortStagnantRefinement = true;
+  conformerBenchmark("DG.conformerAbortStagnant", abortConfiguration);
+
+  /* Avoiding infeasible stereopermutator assignments only pays off across an
+   * ensemble of a molecule with unassigned stereopermutators
+   */
+  if(molecule.stereopermutators().hasUnassignedStereopermutators()) {
+    auto ensembleBenchmark = [&](
+      const std::string& benchmarkName,
+      const DistanceGeometry::Configuration& ensembleConfiguration
+    ) {
+      const unsigned ensembleSize = 16;
+      unsigned successes = 0;
+      unsigned ensembles = 0;
+      const bool ran = suite.run(benchmarkName, name, N, [&]() {
+        auto ensemble = generateRandomEnsemble(molecule, ensembleSize, ensembleConfiguration);
+        ++ensembles;
+        successes += std::count_if(
+          std::begin(ensemble),
+          std::end(ensemble),
+          [](const auto& result) -> bool { return static_cast<bool>(result); }
+        );
+        return ensemble.size();
+      });
+
+      if(ran) {
+        std::cout << "  " << successes << "/" << (ensembles * ensembleSize) << " successful";
+        if(successes > 0) {
+          std::cout << ", " << suite.latest().median * ensembles / successes
+            << " us per successful conformer";
+        }
+        std::cout << nl;
+      }
+    };
+
+    ensembleBenchmark("DG.ensemble", configuration);
+
+    DistanceGeometry::Configuration avoidConfiguration = configuration;
+    avoidConfiguration.avoidInfeasibleAssignments = true;
+    ensembleBenchmark("DG.ensembleAvoidInfeasible", avoidConfiguration);
+  }
+
+  /* Interpretation of generated positions */
+  auto conformerResult = generateConformation(molecule, 1, configuration);
+  if(!conformerResult) {
+    std::cout << "Skipping interpretation of " << name << nl;
+    return;
+  }
+  const auto exchange = IO::exchangeFormat(molecule, conformerResult.value());
+  suite.run("Interpret.molecules", name, N, [&]() {
+    return Interpret::molecules(exchange.first, exchange.second);
+  });
+}
+
+void benchmarkShapes(Suite& suite) {
+  for(const Shapes::Shape shape : Shapes::allShapes) {
+    const unsigned S = Shapes::size(shape);
+    Shapes::Continuous::PositionCollection positions(3, S + 1);
+    positions.leftCols(S) = Shapes::coordinates(shape);
+    positions.col(S) = Eigen::Vector3d::Zero();
+    // Perturb the ideal shape a little
+    positions += 0.05 * Shapes::Continuous::PositionCollection::Random(3, S + 1);
+    const auto normalized = Shapes::Continuous::normalize(positions);
+
+    suite.run("Shapes.continuousMeasure", Shapes::spaceFreeName(shape), S, [&]() {
+      return Shapes::Continuous::shapeCentroidLast(normalized, shape).measure;
+    });
+  }
+}
+
+void benchmarkSmiles(Suite& suite, const std::string& smilesFile) {
+  std::string lines;
+  std::string name;
+  if(smilesFile.empty()) {
+    // Small drug-like set without aromaticity, which is not yet supported
+    const std::vector<std::string> smiles {
+      "CC(=O)OC1=CC=CC=C1C(=O)O",
+      "CN1C=NC2=C1C(=O)N(C(=O)N2C)C",
+      "CC(C)CC1=CC=C(C=C1)C(C)C(=O)O",
+      "N[C@@H](C)C(=O)O",
+      "OCC(O)C(O)C(O)C(O)C=O",
+      "CCN(CC)CC",
+      "F/C=C/F",
+      "CC(C)(C)OC(=O)NC1CCCCC1",
+      "[NH4+].[O-]S(=O)(=O)[O-]",
+      "C12(CCCCC1)CCCCC2"
+    };
+    for(unsigned repeat = 0; repeat < 100; ++repeat) {
+      for(const auto& line : smiles) {
+        lines += line + "\n";
+      }
+    }
+    name = "builtin";
+  } else {
+    std::ifstream file(smilesFile);
+    lines.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    name = boost::filesystem::path(smilesFile).stem().string();
+  }
+
+  std::vector<std::string> splitLines;
+  std::istringstream lineStream(lines);
+  std::string line;
+  while(std::getline(lineStream, line)) {
+    splitLines.push_back(line.substr(0, line.find_first_of(" \t\r")));
+  }
+  const unsigned N = splitLines.size();
+
+  auto reportThroughput = [&]() {
+    std::cout << "  " << std::fixed << std::setprecision(0)
+      << N / (suite.latest().median * 1e-6) << " molecules / s" << nl;
+  };
+
+  if(suite.run("Smiles.spirit", name, N, [&]() {
+    unsigned count = 0;
+    for(const auto& smiles : splitLines) {
+      try {
+        count += IO::Experimental::parseSmiles(smiles).size();
+      } catch(const std::exception& /* e */) {}
+    }
+    return count;
+  })) {
+    reportThroughput();
+  }
+
+  if(suite.run("Smiles.bulk", name, N, [&]() {
+    return IO::Experimental::parseSmilesLines(lines);
+  })) {
+    reportThroughput();
+  }
+
+  if(suite.run("Smiles.bulkDeferred", name, N, [&]() {
+    return IO::Experimental::parseSmilesLines(lines, true);
+  })) {
+    reportThroughput();
+  }
+}
+
+int main(int argc, char* argv[]) {
+  // Set up option parsing
+  boost::program_options::options_description options_description("Recognized options");
+  options_description.add_options()
+    ("help", "Produce help message")
+    ("m", boost::program_options::value<std::string>()->default_value("test/data/cbor"), "Path to molecule files to benchmark")
+    ("o", boost::program_options::value<std::string>()->default_value("benchmarks.json"), "JSON output file")
+    ("f", boost::program_options::value<std::string>()->default_value(""), "Run only benchmarks whose name contains this string")
+    ("t", boost::program_options::value<std::string>()->default_value(""), "Tag to identify the run in the output, e.g. a commit hash")
+    ("r", boost::program_options::value<unsigned>()->default_value(5), "Minimum number of repetitions")
+    ("s", boost::program_options::value<double>()->default_value(0.5), "Minimum time per benchmark in seconds")
+    ("smiles", boost::program_options::value<std::string>()->default_value(""), "Newline-delimited smiles file for parsing benchmarks. Uses a built-in set if empty")
+  ;
+
+  // Parse
+  boost::program_options::variables_map options_variables_map;
+  boost::program_options::store(
+    boost::program_options::parse_command_line(argc, argv, options_description),
+    options_variables_map
+  );
+  boost::program_options::notify(options_variables_map);
+
+  if(options_variables_map.count("help") > 0) {
+    std::cout << options_description << std::endl;
+    return 0;
+  }
+
+  const boost::filesystem::path molPath = options_variables_map["m"].as<std::string>();
+  if(!boost::filesystem::is_directory(molPath)) {
+    std::cout << "Molecule path " << molPath << " is not a directory" << nl;
+    return 1;
+  }
+
+  RepetitionSettings settings;
+  settings.minRepetitions = std::max(options_variables_map["r"].as<unsigned>(), 1u);
+  settings.minSeconds = options_variables_map["s"].as<double>();
+
+  // Make runs comparable
+  randomnessEngine().seed(42);
+
+  Suite suite {settings, options_variables_map["f"].as<std::string>()};
+
+  std::cout << std::left << std::setw(36) << "Benchmark"
+    << std::setw(28) << "Molecule"
+    << std::right << std::setw(6) << "N"
+    << std::setw(14) << "Median / us"
+    << std::setw(12) << "MAD / us"
+    << std::setw(8) << "Reps" << nl;
+
+  // Sort paths so that the output order is stable
+  std::vector<boost::filesystem::path> paths;
+  for(const auto& entry : boost::filesystem::directory_iterator(molPath)) {
+    const auto extension = entry.path().extension();
+    if(extension == ".cbor" || extension == ".mol" || extension == ".json") {
+      paths.push_back(entry.path());
+    }
+  }
+  std::sort(std::begin(paths), std::end(paths));
+
+  for(const auto& path : paths) {
+    benchmarkMolecule(suite, path);
+  }
+
+  benchmarkShapes(suite);
+  benchmarkSmiles(suite, options_variables_map["smiles"].as<std::string>());
+
+  std::ofstream outputFile(options_variables_map["o"].as<std::string>());
+  suite.writeJSON(outputFile, options_variables_map["t"].as<std::string>());
+
+  return 0;
+}
@@ -382,7 +382,7 @@ int main(int argc, char* argv[]) {
 
     DistanceGeometry::ImplicitBoundsGraph shortestPathsGraph {
       mol.graph().inner(),
-      spatialModel.makePairwiseBounds()
+      spatialModel.makePairwiseBounds().toMatrix()
     };
 
     /* Prep */
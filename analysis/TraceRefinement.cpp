@@ -503,12 +503,14 @@ MoleculeDGInformation gatherDGInformation(
   data.rotatableGroups = MoleculeDGInformation::make(data.dihedralConstraints, molecule);
 
   if(applyTetrangleSmoothing) {
+    Eigen::MatrixXd bounds = data.bounds.toMatrix();
+
     /* Add implicit lower and upper bounds */
     const AtomIndex N = molecule.graph().N();
     for(AtomIndex i = 0; i < N; ++i) {
       for(AtomIndex j = i + 1; j < N; ++j) {
-        double& lower = data.bounds(j, i);
-        double& upper = data.bounds(i, j);
+        double& lower = bounds(j, i);
+        double& upper = bounds(i, j);
 
         if(lower == 0.0 && upper == 0.0) {
           double vdwLowerBound = (
@@ -523,10 +525,22 @@ MoleculeDGInformation gatherDGInformation(
     }
 
     // Triangle smooth
-    DistanceBoundsMatrix::smooth(data.bounds);
+    DistanceBoundsMatrix::smooth(bounds);
     // Tetrangle smooth
-    unsigned iterations = tetrangleSmooth(data.bounds);
+    unsigned iterations = tetrangleSmooth(bounds);
     std::cout << "Applied " << iterations << " iterations of tetrangle smoothing\n";
+
+    // All pairs are explicitly bounded after smoothing
+    std::vector<PairwiseBounds::Entry> entries;
+    entries.reserve(N * (N - 1) / 2);
+    for(AtomIndex i = 0; i < N; ++i) {
+      for(AtomIndex j = i + 1; j < N; ++j) {
+        entries.push_back(
+          PairwiseBounds::Entry {i, j, ValueBounds {bounds(j, i), bounds(i, j)}}
+        );
+      }
+    }
+    data.bounds = PairwiseBounds {N, std::move(entries)};
   }
 
   if(printBounds) {
@@ -534,15 +548,13 @@ MoleculeDGInformation gatherDGInformation(
     for(AtomIndex i = 0; i < N; ++i) {
       auto iGraphDistances = distance(i, molecule.graph());
 
-      for(AtomIndex j = i + 1; j < N; ++j) {
-        const double lower = data.bounds(j, i);
-        const double upper = data.bounds(i, j);
+      for(auto iter = data.bounds.rowBegin(i); iter != data.bounds.rowEnd(i); ++iter) {
+        const double lower = iter->bounds.lower;
+        const double upper = iter->bounds.upper;
 
-        if(lower != 0.0 || upper != 0.0) {
-          std::cout << i << " - " << j
-            << " = [" << lower << ", " << upper << "], width = " << (upper - lower)
-            << ", graph distance " << iGraphDistances.at(j) << "\n";
-        }
+        std::cout << i << " - " << iter->j
+          << " = [" << lower << ", " << upper << "], width = " << (upper - lower)
+          << ", graph distance " << iGraphDistances.at(iter->j) << "\n";
       }
     }
   }
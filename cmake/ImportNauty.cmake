@@ -73,6 +73,9 @@ macro(import_nauty)
       )
 
       add_library(nauty STATIC ${NAUTY_HEADERS} ${NAUTY_SOURCES})
+      # Thread-local static workspaces make concurrent calls safe. This must
+      # be visible to consumers of the headers as well.
+      target_compile_definitions(nauty PUBLIC USE_TLS)
       target_include_directories(nauty PUBLIC
         $<BUILD_INTERFACE:${CMAKE_CURRENT_BINARY_DIR}>
         $<INSTALL_INTERFACE:$<INSTALL_PREFIX>/include>
@@ -71,6 +71,51 @@ void init_configuration(pybind11::module& dg) {
     "Sets the gradient at which a refinement is considered complete. Defaults to 1e-5."
   );
 
+  configuration.def_readwrite(
+    "mixed_precision_refinement",
+    &DistanceGeometry::Configuration::mixedPrecisionRefinement,
+    "Run the chirality inversion and fourth dimension compression refinement "
+    "stages in single precision. Defaults to false."
+  );
+
+  configuration.def_readwrite(
+    "abort_stagnant_refinement",
+    &DistanceGeometry::Configuration::abortStagnantRefinement,
+    "Abort refinements whose error, gradient and chiral constraint signs stop "
+    "improving. Defaults to false."
+  );
+
+  configuration.def_readwrite(
+    "aborted_refinement_retries",
+    &DistanceGeometry::Configuration::abortedRefinementRetries,
+    "Number of times an aborted refinement is retried with new distances. "
+    "Defaults to three."
+  );
+
+  configuration.def_readwrite(
+    "avoid_infeasible_assignments",
+    &DistanceGeometry::Configuration::avoidInfeasibleAssignments,
+    "Remember random stereopermutator assignments that repeatedly fail to "
+    "yield conformers and redraw them. Makes parallel ensemble generation "
+    "irreproducible. Defaults to false."
+  );
+
+  configuration.def_readwrite(
+    "deduplication_rmsd",
+    &DistanceGeometry::Configuration::deduplicationRmsd,
+    "RMSD threshold in bohr below which generated conformers of an ensemble "
+    "are rejected as duplicates. Makes parallel ensemble generation "
+    "irreproducible. Disabled at zero, the default."
+  );
+
+  configuration.def_readwrite(
+    "symmetry_aware_deduplication",
+    &DistanceGeometry::Configuration::symmetryAwareDeduplication,
+    "Allow relabeling conformers by graph automorphisms when comparing "
+    "them for duplicates. The search over automorphisms is local, so some "
+    "duplicates may be missed. Defaults to false."
+  );
+
   configuration.def_readwrite(
     "spatial_model_loosening",
     &DistanceGeometry::Configuration::spatialModelLoosening,
@@ -90,6 +135,14 @@ void init_configuration(pybind11::module& dg) {
     )delim"
   );
 
+  configuration.def_readwrite(
+    "freeze_fixed_positions",
+    &DistanceGeometry::Configuration::freezeFixedPositions,
+    "Treat fixed positions as constants during refinement instead of fitting "
+    "the refined structure onto them afterwards. Faster if most atoms are "
+    "fixed. Defaults to false."
+  );
+
   configuration.def(
     "__repr__",
     [](pybind11::object settings) -> std::string {
@@ -97,8 +150,15 @@ void init_configuration(pybind11::module& dg) {
         "partiality",
         "refinement_step_limit",
         "refinement_gradient_target",
+        "mixed_precision_refinement",
+        "abort_stagnant_refinement",
+        "aborted_refinement_retries",
+        "avoid_infeasible_assignments",
+        "deduplication_rmsd",
+        "symmetry_aware_deduplication",
         "spatial_model_loosening",
-        "fixed_positions"
+        "fixed_positions",
+        "freeze_fixed_positions"
       };
 
       std::string repr = "(";
@@ -251,6 +311,28 @@ void init_error(pybind11::module& dg) {
     DgError::UnknownException,
     "Unknown exception occurred. Please report this as an issue to the developers!"
   );
+
+  error.value(
+    "RefinementAborted",
+    DgError::RefinementAborted,
+    R"delim(
+      Refinement stopped making progress and was aborted early
+
+      Only occurs if stagnant refinements are aborted in the configuration and
+      all retries with new distances were aborted, too. Generate more
+      conformers.
+    )delim"
+  );
+
+  error.value(
+    "DuplicateConformer",
+    DgError::DuplicateConformer,
+    R"delim(
+      Conformer is redundant with a previously generated conformer
+
+      Only occurs if conformers are deduplicated in the configuration.
+    )delim"
+  );
 }
 
 } // namespace
@@ -365,13 +365,22 @@ void init_directed_conformer_generator(pybind11::module& m) {
     "Configuration for conformer generation scheme"
   );
 
+  enumerationSettings.def_readwrite(
+    "indexed_enumeration",
+    &DirectedConformerGenerator::EnumerationSettings::indexedEnumeration,
+    "Enumerate decision lists by index without sharing state between "
+    "threads. Conformers are passed to the callback in order of decision "
+    "list index after all are generated."
+  );
+
   enumerationSettings.def(
     "__repr__",
     [](pybind11::object settings) -> std::string {
       const std::vector<std::string> members {
         "dihedral_retries",
         "fitting",
-        "configuration"
+        "configuration",
+        "indexed_enumeration"
       };
 
       std::string repr = "(";
@@ -526,6 +526,41 @@ void init_molecule(pybind11::module& m) {
     )delim"
   );
 
+  molecule.def(
+    "begin_edit",
+    &Molecule::beginEdit,
+    R"delim(
+      Open an edit transaction.
+
+      Until the transaction is committed, edits propagate only
+      stereopermutators whose number of sites changes. All other ranking
+      changes are propagated once on committing the outermost transaction.
+
+      Commit in a ``finally`` clause so that a failing edit does not leave
+      the transaction open.
+
+      >>> import scine_utilities as utils
+      >>> ethane = io.experimental.from_smiles("CC")
+      >>> ethane.begin_edit()
+      >>> try:
+      ...     _ = ethane.add_atom(utils.ElementType.Br, 0)
+      ...     _ = ethane.add_atom(utils.ElementType.Cl, 1)
+      ... finally:
+      ...     ethane.commit_edit()
+    )delim"
+  );
+
+  molecule.def(
+    "commit_edit",
+    &Molecule::commitEdit,
+    R"delim(
+      Commit an edit transaction.
+
+      If this closes the outermost transaction, stereopermutators are
+      propagated through all edits made since :meth:`begin_edit`.
+    )delim"
+  );
+
   /* Information */
   molecule.def(
     "dump_graphviz",
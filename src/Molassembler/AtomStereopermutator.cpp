@@ -18,7 +18,7 @@ AtomStereopermutator::AtomStereopermutator(
   const AtomIndex centerAtom,
   RankingInformation ranking
 ) : pImpl_(
-  std::make_unique<Impl>(
+  std::make_shared<Impl>(
     graph,
     shape,
     centerAtom,
@@ -29,13 +29,9 @@ AtomStereopermutator::AtomStereopermutator(
 AtomStereopermutator::AtomStereopermutator(AtomStereopermutator&& other) noexcept = default;
 AtomStereopermutator& AtomStereopermutator::operator = (AtomStereopermutator&& other) noexcept = default;
 
-AtomStereopermutator::AtomStereopermutator(const AtomStereopermutator& other) : pImpl_(
-  std::make_unique<Impl>(*other.pImpl_)
-) {}
-AtomStereopermutator& AtomStereopermutator::operator = (const AtomStereopermutator& other) {
-  *pImpl_ = *other.pImpl_;
-  return *this;
-}
+// Copies share their implementation until either is modified
+AtomStereopermutator::AtomStereopermutator(const AtomStereopermutator& other) = default;
+AtomStereopermutator& AtomStereopermutator::operator = (const AtomStereopermutator& other) = default;
 
 AtomStereopermutator::~AtomStereopermutator() = default;
 
@@ -48,14 +44,17 @@ Shapes::Shape AtomStereopermutator::down(const Shapes::Shape shape, const Shapes
 }
 
 void AtomStereopermutator::assign(boost::optional<unsigned> assignment) {
+  detach_();
   pImpl_->assign(std::move(assignment));
 }
 
 void AtomStereopermutator::assignRandom(Random::Engine& engine) {
+  detach_();
   pImpl_->assignRandom(engine);
 }
 
 void AtomStereopermutator::applyPermutation(const std::vector<AtomIndex>& permutation) {
+  detach_();
   pImpl_->applyPermutation(permutation);
 }
 
@@ -63,6 +62,7 @@ boost::optional<AtomStereopermutator::ShapeMap> AtomStereopermutator::fit(
   const Graph& graph,
   const AngstromPositions& angstromWrapper
 ) {
+  detach_();
   return pImpl_->fit(graph, angstromWrapper);
 }
 
@@ -71,6 +71,7 @@ boost::optional<AtomStereopermutator::PropagatedState> AtomStereopermutator::pro
   RankingInformation newRanking,
   boost::optional<Shapes::Shape> shapeOption
 ) {
+  detach_();
   return pImpl_->propagate(
     graph,
     std::move(newRanking),
@@ -79,6 +80,7 @@ boost::optional<AtomStereopermutator::PropagatedState> AtomStereopermutator::pro
 }
 
 void AtomStereopermutator::propagateVertexRemoval(const AtomIndex removedIndex) {
+  detach_();
   pImpl_->propagateVertexRemoval(removedIndex);
 }
 
@@ -86,6 +88,7 @@ void AtomStereopermutator::setShape(
   const Shapes::Shape shape,
   const Graph& graph
 ) {
+  detach_();
   pImpl_->setShape(shape, graph);
 }
 
@@ -166,5 +169,11 @@ bool AtomStereopermutator::operator < (const AtomStereopermutator& other) const
   return *pImpl_ < *other.pImpl_;
 }
 
+void AtomStereopermutator::detach_() {
+  if(pImpl_.use_count() > 1) {
+    pImpl_ = std::make_shared<Impl>(*pImpl_);
+  }
+}
+
 } // namespace Molassembler
 } // namespace Scine
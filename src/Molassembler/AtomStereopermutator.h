@@ -75,6 +75,9 @@ struct ChiralConstraint;
  * @note An instance of this class on a given central atom does not indicate
  *   that that atom is a stereocenter. That is only the case if there are
  *   multiple stereopermutations of the ranked substituents / ligands.
+ *
+ * @note Copies share their state until either is modified, so copying is
+ *   @math{\Theta(1)}.
  */
 class MASM_EXPORT AtomStereopermutator {
 public:
@@ -435,7 +438,11 @@ public:
 
 private:
   class Impl;
-  std::unique_ptr<Impl> pImpl_;
+  //! Shared between copies until either is modified
+  std::shared_ptr<Impl> pImpl_;
+
+  //! Ensures the implementation is not shared before a modification
+  void detach_();
 };
 
 } // namespace Molassembler
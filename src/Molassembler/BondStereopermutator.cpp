@@ -19,13 +19,9 @@ constexpr double BondStereopermutator::assignmentAcceptanceParameter;
 BondStereopermutator::BondStereopermutator(BondStereopermutator&& other) noexcept = default;
 BondStereopermutator& BondStereopermutator::operator = (BondStereopermutator&& other) noexcept = default;
 
-BondStereopermutator::BondStereopermutator(const BondStereopermutator& other) : pImpl_(
-  std::make_unique<Impl>(*other.pImpl_)
-) {}
-BondStereopermutator& BondStereopermutator::operator = (const BondStereopermutator& other) {
-  *pImpl_ = *other.pImpl_;
-  return *this;
-}
+// Copies share their implementation until either is modified
+BondStereopermutator::BondStereopermutator(const BondStereopermutator& other) = default;
+BondStereopermutator& BondStereopermutator::operator = (const BondStereopermutator& other) = default;
 BondStereopermutator::~BondStereopermutator() = default;
 
 BondStereopermutator::BondStereopermutator(
@@ -34,7 +30,7 @@ BondStereopermutator::BondStereopermutator(
   const BondIndex& edge,
   const Alignment alignment
 ) {
-  pImpl_ = std::make_unique<Impl>(
+  pImpl_ = std::make_shared<Impl>(
     stereopermutatorA,
     stereopermutatorB,
     edge,
@@ -48,7 +44,7 @@ BondStereopermutator::BondStereopermutator(
   const BondIndex& edge,
   const Alignment alignment
 ) {
-  pImpl_ = std::make_unique<Impl>(
+  pImpl_ = std::make_shared<Impl>(
     graph,
     stereopermutators,
     edge,
@@ -57,14 +53,17 @@ BondStereopermutator::BondStereopermutator(
 }
 
 void BondStereopermutator::assign(boost::optional<unsigned> assignment) {
+  detach_();
   pImpl_->assign(std::move(assignment));
 }
 
 void BondStereopermutator::assignRandom(Random::Engine& engine) {
+  detach_();
   pImpl_->assignRandom(engine);
 }
 
 void BondStereopermutator::applyPermutation(const std::vector<AtomIndex>& permutation) {
+  detach_();
   pImpl_->applyPermutation(permutation);
 }
 
@@ -73,6 +72,7 @@ void BondStereopermutator::fit(
   std::pair<FittingReferences, FittingReferences> fittingReferences,
   const FittingMode mode
 ) {
+  detach_();
   pImpl_->fit(angstromWrapper, std::move(fittingReferences), mode);
 }
 
@@ -82,6 +82,7 @@ void BondStereopermutator::propagateGraphChange(
   const PrivateGraph& inner,
   const StereopermutatorList& permutators
 ) {
+  detach_();
   pImpl_->propagateGraphChange(
     oldPermutator,
     newPermutator,
@@ -158,5 +159,11 @@ bool BondStereopermutator::operator != (const BondStereopermutator& other) const
   );
 }
 
+void BondStereopermutator::detach_() {
+  if(pImpl_.use_count() > 1) {
+    pImpl_ = std::make_shared<Impl>(*pImpl_);
+  }
+}
+
 } // namespace Molassembler
 } // namespace Scine
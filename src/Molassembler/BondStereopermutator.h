@@ -42,6 +42,9 @@ struct ChiralConstraint;
  *
  * This class exists to model rotational barriers along bonds joining an
  * arbitrary pair of idealized shapes.
+ *
+ * @note Copies share their state until either is modified, so copying is
+ *   @math{\Theta(1)}.
  */
 class MASM_EXPORT BondStereopermutator {
 public:
@@ -323,7 +326,11 @@ public:
 
 private:
   struct Impl;
-  std::unique_ptr<Impl> pImpl_;
+  //! Shared between copies until either is modified
+  std::shared_ptr<Impl> pImpl_;
+
+  //! Ensures the implementation is not shared before a modification
+  void detach_();
 };
 
 } // namespace Molassembler
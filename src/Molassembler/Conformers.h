@@ -99,6 +99,82 @@ struct MASM_EXPORT Configuration {
    */
   double refinementGradientTarget {1e-5};
 
+  /**
+   * @brief Run the early refinement stages in single precision
+   *
+   * Inverting chiral constraints and compressing out the fourth spatial
+   * dimension only need coarse accuracy. If set, these stages are run in
+   * single precision and the final refinement stage with dihedral terms in
+   * double precision. This can be faster for large molecules, but may
+   * increase the refinement failure rate.
+   *
+   * Disabled by default.
+   */
+  bool mixedPrecisionRefinement {false};
+
+  /**
+   * @brief Abort refinements that stop making progress
+   *
+   * If set, the refinement error, gradient norm and proportion of correctly
+   * signed chiral constraints are monitored. If none of these improve over
+   * about a thousand steps, refinement is aborted with
+   * DgError::RefinementAborted instead of running until the refinement step
+   * limit.
+   *
+   * Disabled by default.
+   */
+  bool abortStagnantRefinement {false};
+
+  /**
+   * @brief Number of times to retry an aborted refinement
+   *
+   * Each retry starts over with a new distance matrix. Only has an effect if
+   * stagnant refinements are aborted. Applies to all conformer generation
+   * functions, including those of DirectedConformerGenerator. Defaults to
+   * three.
+   */
+  unsigned abortedRefinementRetries {3};
+
+  /**
+   * @brief Avoid stereopermutator assignments that repeatedly fail
+   *
+   * If a molecule has unassigned stereopermutators, each conformer is
+   * generated from a random assignment. If set, assignments that fail to
+   * yield a conformer several times without ever succeeding are remembered
+   * over the generation of an ensemble and redrawn in later conformers.
+   *
+   * Which assignments are avoided depends on the order in which conformers
+   * finish, so parallel ensemble generation is no longer reproducible from a
+   * seed. Disabled by default.
+   */
+  bool avoidInfeasibleAssignments {false};
+
+  /**
+   * @brief RMSD threshold below which generated conformers are duplicates
+   *
+   * If positive, each generated conformer of an ensemble is fitted onto the
+   * previously accepted conformers. Conformers within this RMSD of an
+   * accepted conformer are rejected with DgError::DuplicateConformer.
+   *
+   * Which of two duplicates is rejected depends on which finishes first, so
+   * parallel ensemble generation is no longer reproducible from a seed.
+   * Disabled by default.
+   *
+   * @note In bohr length units
+   */
+  double deduplicationRmsd {0.0};
+
+  /**
+   * @brief Whether deduplication may exchange symmetry-equivalent atoms
+   *
+   * If set, conformers may be relabeled by automorphisms of the molecular
+   * graph when comparing them for duplicates, e.g. exchanging the hydrogen
+   * atoms of methyl groups. Only genuine automorphisms are applied, but the
+   * search over them is local, so some duplicates may be missed. Only has an
+   * effect if deduplicationRmsd is positive.
+   */
+  bool symmetryAwareDeduplication {false};
+
   /**
    * @brief Sets the loosening of the spatial model
    *
@@ -127,6 +203,19 @@ struct MASM_EXPORT Configuration {
   std::vector<
     std::pair<AtomIndex, Utils::Position>
   > fixedPositions;
+
+  /**
+   * @brief Treat fixed positions as constants during refinement
+   *
+   * By default, atoms with fixed positions are refined like any other atom
+   * and the result is fitted onto the fixed positions afterwards. If set,
+   * fixed atoms are placed at their positions before refinement and removed
+   * from the refinement variables. Refinement then scales with the number
+   * of free atoms, which is much faster if most atoms are fixed.
+   *
+   * Disabled by default.
+   */
+  bool freezeFixedPositions {false};
 };
 
 } // namespace DistanceGeometry
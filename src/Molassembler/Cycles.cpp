@@ -15,6 +15,8 @@
 #include "RingDecomposerLib.h"
 #include "boost/variant.hpp"
 
+#include <limits>
+
 namespace Scine {
 namespace Molassembler {
 namespace {
@@ -41,6 +43,9 @@ inline std::vector<unsigned> intersect(
   return intersection;
 }
 
+//! Marks vertices without a counterpart in relabeled RDL data
+constexpr unsigned noRdlVertex = std::numeric_limits<unsigned>::max();
+
 } // namespace
 
 /* Cycles member Type declarations */
@@ -51,8 +56,30 @@ struct Cycles::RdlDataPtrs {
   //! Raw pointer to calculated graph cycle data
   RDL_data* dataPtr;
 
+  /*! @brief Number of vertices of the source graph
+   *
+   * The source graph may have gained disconnected vertices or bridges since.
+   * These are part of no cycle.
+   */
+  unsigned N;
+
+  /*! @brief Owner of the RDL data if vertices are relabeled
+   *
+   * Relabeled instances share the RDL data of the instance they were
+   * calculated in and translate vertex indices on access.
+   */
+  std::shared_ptr<RdlDataPtrs> base;
+  //! Map from vertex indices to RDL vertex indices, empty if not relabeled
+  std::vector<unsigned> toRdl;
+  //! Map from RDL vertex indices to vertex indices, empty if not relabeled
+  std::vector<AtomIndex> fromRdl;
+
   RdlDataPtrs() = delete;
   RdlDataPtrs(const PrivateGraph& sourceGraph, bool ignoreEtaBonds);
+  RdlDataPtrs(
+    const std::shared_ptr<RdlDataPtrs>& unpermuted,
+    const std::vector<AtomIndex>& permutation
+  );
 
   RdlDataPtrs(const RdlDataPtrs& other) = delete;
   RdlDataPtrs(RdlDataPtrs&& other) = delete;
@@ -61,6 +88,30 @@ struct Cycles::RdlDataPtrs {
   ~RdlDataPtrs();
 
   bool bondExists(const BondIndex& bond) const;
+
+  bool atomExists(const AtomIndex atom) const {
+    if(toRdl.empty()) {
+      return atom < N;
+    }
+
+    return atom < toRdl.size() && toRdl[atom] != noRdlVertex;
+  }
+
+  //! Index of an existing vertex in the RDL data
+  unsigned rdlVertex(const AtomIndex atom) const {
+    assert(atomExists(atom));
+    return toRdl.empty() ? atom : toRdl[atom];
+  }
+
+  //! Vertex index of an RDL vertex
+  AtomIndex vertex(const unsigned rdlVertex) const {
+    return fromRdl.empty() ? rdlVertex : fromRdl.at(rdlVertex);
+  }
+
+  //! Bond in RDL vertex indices to bond in vertex indices
+  BondIndex bond(const RDL_edge& edge) const {
+    return {vertex(edge[0]), vertex(edge[1])};
+  }
 };
 
 Cycles::Cycles(const Graph& sourceGraph, const bool ignoreEtaBonds)
@@ -98,11 +149,23 @@ unsigned Cycles::numCycleFamilies() const {
 }
 
 unsigned Cycles::numCycleFamilies(const BondIndex& bond) const {
-  return RDL_getNofURFContainingEdge(rdlPtr_->dataPtr, bond.first, bond.second);
+  if(!rdlPtr_->bondExists(bond)) {
+    return 0;
+  }
+
+  return RDL_getNofURFContainingEdge(
+    rdlPtr_->dataPtr,
+    rdlPtr_->rdlVertex(bond.first),
+    rdlPtr_->rdlVertex(bond.second)
+  );
 }
 
 unsigned Cycles::numCycleFamilies(const AtomIndex index) const {
-  return RDL_getNofURFContainingNode(rdlPtr_->dataPtr, index);
+  if(!rdlPtr_->atomExists(index)) {
+    return 0;
+  }
+
+  return RDL_getNofURFContainingNode(rdlPtr_->dataPtr, rdlPtr_->rdlVertex(index));
 }
 
 //! Returns the number of relevant cycles (RCs)
@@ -111,11 +174,23 @@ unsigned Cycles::numRelevantCycles() const {
 }
 
 unsigned Cycles::numRelevantCycles(const AtomIndex index) const {
-  return RDL_getNofRCFContainingNode(rdlPtr_->dataPtr, index);
+  if(!rdlPtr_->atomExists(index)) {
+    return 0;
+  }
+
+  return RDL_getNofRCFContainingNode(rdlPtr_->dataPtr, rdlPtr_->rdlVertex(index));
 }
 
 unsigned Cycles::numRelevantCycles(const BondIndex& bond) const {
-  return RDL_getNofRCFContainingEdge(rdlPtr_->dataPtr, bond.first, bond.second);
+  if(!rdlPtr_->bondExists(bond)) {
+    return 0;
+  }
+
+  return RDL_getNofRCFContainingEdge(
+    rdlPtr_->dataPtr,
+    rdlPtr_->rdlVertex(bond.first),
+    rdlPtr_->rdlVertex(bond.second)
+  );
 }
 
 Cycles::AllCyclesIterator Cycles::begin() const {
@@ -131,6 +206,8 @@ Cycles::AllCyclesIterator Cycles::end() const {
 
 /* Cycles::RdlCyclePtrs */
 struct Cycles::RdlCyclePtrs {
+  //! Translates RDL vertex indices, owned by the iterator
+  const RdlDataPtrs* labelsPtr;
   RDL_cycleIterator* cycleIterPtr = nullptr;
   RDL_cycle* cyclePtr = nullptr;
   unsigned rCycleIndex = 0;
@@ -139,13 +216,13 @@ struct Cycles::RdlCyclePtrs {
   RdlCyclePtrs() = delete;
 
   //! Construct cycle ptrs just from cycle data (get all RCycles)
-  RdlCyclePtrs(const RdlDataPtrs& dataPtrs) {
+  RdlCyclePtrs(const RdlDataPtrs& dataPtrs) : labelsPtr(&dataPtrs) {
     cycleIterPtr = RDL_getRCyclesIterator(dataPtrs.dataPtr);
     initializeCycle();
   }
 
   //! Construct cycle ptrs from a particular URF ID
-  RdlCyclePtrs(const RdlDataPtrs& dataPtrs, const unsigned URFID) {
+  RdlCyclePtrs(const RdlDataPtrs& dataPtrs, const unsigned URFID) : labelsPtr(&dataPtrs) {
     cycleIterPtr = RDL_getRCyclesForURFIterator(dataPtrs.dataPtr, URFID);
     initializeCycle();
   }
@@ -197,10 +274,7 @@ struct Cycles::RdlCyclePtrs {
     bonds.reserve(size);
 
     for(unsigned i = 0; i < size; ++i) {
-      bonds.emplace_back(
-        cyclePtr->edges[i][0],
-        cyclePtr->edges[i][1]
-      );
+      bonds.push_back(labelsPtr->bond(cyclePtr->edges[i]));
     }
   }
 
@@ -301,6 +375,31 @@ RDL_data* Cycles::dataPtr() const {
   return rdlPtr_->dataPtr;
 }
 
+unsigned Cycles::rdlVertex(const AtomIndex atom) const {
+  return rdlPtr_->rdlVertex(atom);
+}
+
+AtomIndex Cycles::vertex(const unsigned rdlVertex) const {
+  return rdlPtr_->vertex(rdlVertex);
+}
+
+void Cycles::applyPermutation(const std::vector<AtomIndex>& permutation) {
+  rdlPtr_ = std::make_shared<RdlDataPtrs>(rdlPtr_, permutation);
+
+  decltype(urfMap_) permutedUrfMap;
+  permutedUrfMap.reserve(urfMap_.size());
+  for(auto& mapPair : urfMap_) {
+    permutedUrfMap.emplace(
+      BondIndex {
+        permutation.at(mapPair.first.first),
+        permutation.at(mapPair.first.second)
+      },
+      std::move(mapPair.second)
+    );
+  }
+  urfMap_ = std::move(permutedUrfMap);
+}
+
 bool Cycles::operator == (const Cycles& other) const {
   return rdlPtr_ == other.rdlPtr_;
 }
@@ -315,7 +414,8 @@ Cycles::RdlDataPtrs::RdlDataPtrs(
   const bool ignoreEtaBonds
 ) {
   // Initialize a new graph
-  graphPtr = RDL_initNewGraph(sourceGraph.N());
+  N = sourceGraph.N();
+  graphPtr = RDL_initNewGraph(N);
 
   if(ignoreEtaBonds) {
     for(const auto edge : sourceGraph.edges()) {
@@ -351,13 +451,40 @@ Cycles::RdlDataPtrs::RdlDataPtrs(
   assert(dataPtr != nullptr);
 }
 
+Cycles::RdlDataPtrs::RdlDataPtrs(
+  const std::shared_ptr<RdlDataPtrs>& unpermuted,
+  const std::vector<AtomIndex>& permutation
+) : graphPtr(unpermuted->graphPtr),
+    dataPtr(unpermuted->dataPtr),
+    N(unpermuted->N),
+    base(unpermuted->base ? unpermuted->base : unpermuted),
+    toRdl(permutation.size(), noRdlVertex),
+    fromRdl(N)
+{
+  // Relabel relative to the RDL data instead of chaining relabelings
+  for(unsigned v = 0; v < N; ++v) {
+    const AtomIndex permuted = permutation.at(unpermuted->vertex(v));
+    fromRdl[v] = permuted;
+    toRdl.at(permuted) = v;
+  }
+}
+
 Cycles::RdlDataPtrs::~RdlDataPtrs() {
+  // Relabeled instances do not own their data
+  if(base) {
+    return;
+  }
+
   // Awfully enough, calling this frees both dataPtr and graphPtr
   RDL_deleteData(dataPtr);
 }
 
 bool Cycles::RdlDataPtrs::bondExists(const BondIndex& bond) const {
-  const unsigned bondID = RDL_getEdgeId(dataPtr, bond.first, bond.second);
+  if(!atomExists(bond.first) || !atomExists(bond.second)) {
+    return false;
+  }
+
+  const unsigned bondID = RDL_getEdgeId(dataPtr, rdlVertex(bond.first), rdlVertex(bond.second));
   return bondID != RDL_INVALID_RESULT;
 }
 
@@ -481,10 +608,14 @@ struct Cycles::UrfIdsCycleIterator::UrfHelper {
     AtomIndex atom,
     const RdlDataPtrs& dataPtrs
   ) {
+    if(!dataPtrs.atomExists(atom)) {
+      return {};
+    }
+
     return getURFsHelper(
       dataPtrs,
       &RDL_getURFsContainingNode,
-      atom
+      dataPtrs.rdlVertex(atom)
     );
   }
 
@@ -497,8 +628,8 @@ struct Cycles::UrfIdsCycleIterator::UrfHelper {
     return getURFsHelper(
       dataPtrs,
       &RDL_getURFsContainingEdge,
-      bond.first,
-      bond.second
+      dataPtrs.rdlVertex(bond.first),
+      dataPtrs.rdlVertex(bond.second)
     );
   }
 
@@ -212,8 +212,42 @@ public:
    */
   unsigned numRelevantCycles(const BondIndex& bond) const;
 
-  //! Provide access to calculated data
+  /*! @brief Provide access to calculated data
+   *
+   * Vertex indices in the data are those of the graph the cycles were
+   * calculated from. Translate with rdlVertex() and vertex() if the cycles
+   * were relabeled since.
+   */
   RDL_data* dataPtr() const;
+
+  /*! @brief Index of a vertex in the data behind dataPtr()
+   *
+   * @complexity{@math{\Theta(1)}}
+   * @pre The vertex is part of the graph the cycles were calculated from
+   */
+  unsigned rdlVertex(AtomIndex atom) const;
+
+  /*! @brief Vertex index of a vertex in the data behind dataPtr()
+   *
+   * @complexity{@math{\Theta(1)}}
+   */
+  AtomIndex vertex(unsigned rdlVertex) const;
+//!@}
+
+//!@name Modification
+//!@{
+  /*! @brief Relabels the vertices of the cycle data
+   *
+   * The calculated cycle data is shared with unpermuted copies. Vertex indices
+   * are translated on access instead.
+   *
+   * @param permutation Map from current to new vertex indices. May cover
+   *   vertices added to the graph after the cycles were calculated.
+   *
+   * @complexity{@math{\Theta(V + C)} where @math{C} is the number of bonds
+   * in cycles}
+   */
+  void applyPermutation(const std::vector<AtomIndex>& permutation);
 //!@}
 
 //!@name Iterators
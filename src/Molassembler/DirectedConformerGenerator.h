@@ -437,6 +437,14 @@ public:
     BondStereopermutator::FittingMode fitting = BondStereopermutator::FittingMode::Nearest;
     //! Conformer generation settings
     DistanceGeometry::Configuration configuration;
+    /*! @brief Enumerate decision lists by index instead of drawing them
+     *
+     * Decision lists are decoded from their index in the mixed-radix product
+     * of the bounds, so threads need not share the set of decision lists.
+     * Results are passed to the callback in order of decision list index as
+     * soon as the conformers of all lower indices are generated.
+     */
+    bool indexedEnumeration = false;
   };
 
   /*! @brief Enumerate all conformers of the captured molecule
@@ -456,6 +464,12 @@ public:
    * environment variable to control the number of threads used. Callback
    * invocations are unsequenced but the arguments are reproducible.
    * @endparblock
+   *
+   * @parblock @note If the configuration's deduplicationRmsd is positive,
+   * conformers redundant with a previously generated conformer are not passed
+   * to the callback. Which of two redundant conformers is passed on is then
+   * not reproducible in parallel execution.
+   * @endparblock
    */
   void enumerate(
     std::function<void(const DecisionList&, Utils::PositionCollection)> callback,
@@ -481,6 +495,11 @@ public:
    * invocations are unsequenced but the arguments are reproducible.
    * @endparblock
    *
+   * @parblock @note If the configuration's deduplicationRmsd is positive,
+   * conformers redundant with a previously generated conformer are not passed
+   * to the callback.
+   * @endparblock
+   *
    * @parblock @note This function advances the state of the global PRNG.
    * @endparblock
    */
@@ -12,11 +12,13 @@
 
 #include "Molassembler/BondStereopermutator.h"
 #include "Molassembler/DistanceGeometry/EigenRefinement.h"
+#include "Molassembler/DistanceGeometry/EnsembleFilter.h"
 #include "Molassembler/DistanceGeometry/Error.h"
 #include "Molassembler/DistanceGeometry/ExplicitBoundsGraph.h"
 #include "Molassembler/DistanceGeometry/MetricMatrix.h"
 #include "Molassembler/DistanceGeometry/RefinementMeta.h"
 #include "Molassembler/Graph/GraphAlgorithms.h"
+#include "Molassembler/Profiling.h"
 #include "Utils/Math/QuaternionFit.h"
 
 #include "Molassembler/Detail/Cartesian.h"
@@ -25,7 +27,11 @@
 #include "Molassembler/Temple/Functional.h"
 #include "Molassembler/Temple/Random.h"
 
+#include <algorithm>
+#include <array>
 #include <iostream>
+#include <limits>
+#include <tuple>
 
 namespace Scine {
 namespace Molassembler {
@@ -54,23 +60,14 @@ AngstromPositions convertToAngstromPositions(const Eigen::MatrixXd& positions) {
   return angstromWrapper;
 }
 
-Eigen::MatrixXd fitAndSetFixedPositions(
-  const Eigen::MatrixXd& positions,
+//! Reference matrix of fixed positions in angstrom and their fit weights
+std::pair<Eigen::MatrixXd, Eigen::VectorXd> fixedPositionsReference(
+  const unsigned N,
   const Configuration& configuration
 ) {
-  /* Fixed positions postprocessing:
-   * - Rotate and translate the generated coordinates towards the fixed
-   *   positions indicated for each.
-   *
-   * Maybe?
-   * - Assuming the fit isn't absolutely exact, overwrite the existing
-   *   positions with the fixed ones
-   */
   /* Construct a reference matrix from the fixed positions (these are still in
    * bohr!) and a weights vector
    */
-  assert(positions.cols() == 3);
-  const unsigned N = positions.rows();
   Eigen::MatrixXd referenceMatrix = Eigen::MatrixXd::Zero(N, 3);
   Eigen::VectorXd weights = Eigen::VectorXd::Zero(N);
   for(const auto& indexPositionPair : configuration.fixedPositions) {
@@ -80,12 +77,146 @@ Eigen::MatrixXd fitAndSetFixedPositions(
 
   referenceMatrix *= Utils::Constants::angstrom_per_bohr;
 
+  return {std::move(referenceMatrix), std::move(weights)};
+}
+
+Eigen::MatrixXd fitAndSetFixedPositions(
+  const Eigen::MatrixXd& positions,
+  const Configuration& configuration
+) {
+  /* Fixed positions postprocessing:
+   * - Rotate and translate the generated coordinates towards the fixed
+   *   positions indicated for each.
+   *
+   * Maybe?
+   * - Assuming the fit isn't absolutely exact, overwrite the existing
+   *   positions with the fixed ones
+   */
+  assert(positions.cols() == 3);
+  Eigen::MatrixXd referenceMatrix;
+  Eigen::VectorXd weights;
+  std::tie(referenceMatrix, weights) = fixedPositionsReference(positions.rows(), configuration);
+
   // Perform the QuaternionFit
   Utils::QuaternionFit fit(referenceMatrix, positions, weights);
 
   return fit.getFittedData();
 }
 
+void alignToFixedPositions(
+  Eigen::Ref<Eigen::VectorXd> vectorizedPositions,
+  const Configuration& configuration
+) {
+  constexpr unsigned dimensionality = 4;
+  const unsigned N = vectorizedPositions.size() / dimensionality;
+
+  Eigen::MatrixXd referenceMatrix;
+  Eigen::VectorXd weights;
+  std::tie(referenceMatrix, weights) = fixedPositionsReference(N, configuration);
+
+  /* The embedding can be a mirror image of the fixed positions. A rotation
+   * cannot fix that, so fit both and keep the closer one.
+   */
+  const Eigen::MatrixXd positions = gather(vectorizedPositions);
+  Eigen::MatrixXd mirroredPositions = positions;
+  mirroredPositions.col(1) *= -1;
+
+  const Eigen::MatrixXd fitted = Utils::QuaternionFit(referenceMatrix, positions, weights).getFittedData();
+  const Eigen::MatrixXd mirroredFitted = Utils::QuaternionFit(referenceMatrix, mirroredPositions, weights).getFittedData();
+
+  const auto fixedSquaredDeviation = [&](const Eigen::MatrixXd& fit) -> double {
+    return (fit - referenceMatrix).rowwise().squaredNorm().dot(weights);
+  };
+
+  const Eigen::MatrixXd& closerFit = (
+    fixedSquaredDeviation(mirroredFitted) < fixedSquaredDeviation(fitted)
+    ? mirroredFitted
+    : fitted
+  );
+
+  for(unsigned i = 0; i < N; ++i) {
+    if(weights(i) > 0) {
+      vectorizedPositions.template segment<3>(dimensionality * i) = referenceMatrix.row(i).transpose();
+      vectorizedPositions(dimensionality * i + 3) = 0;
+    } else {
+      vectorizedPositions.template segment<3>(dimensionality * i) = closerFit.row(i).transpose();
+    }
+  }
+}
+
+//! Plane through a point with a unit normal
+struct MirrorPlane {
+  Eigen::Vector3d point;
+  Eigen::Vector3d normal;
+};
+
+/*! @brief Finds a mirror plane containing all fixed atoms, if there is one
+ *
+ * Fixed atoms lying in a common plane, in particular up to three fixed atoms,
+ * do not determine the handedness of a structure: Reflecting through that
+ * plane leaves them in place. Without fixed atoms, this is the xz plane.
+ */
+boost::optional<MirrorPlane> fixedAtomsMirrorPlane(
+  const Eigen::VectorXd& positions,
+  const unsigned dimensionality,
+  const std::vector<AtomIndex>& fixedAtoms
+) {
+  constexpr double tolerance = 1e-2;
+
+  if(fixedAtoms.empty()) {
+    return MirrorPlane {Eigen::Vector3d::Zero(), Eigen::Vector3d::UnitY()};
+  }
+
+  auto position = [&](const AtomIndex i) -> Eigen::Vector3d {
+    return positions.segment<3>(dimensionality * i);
+  };
+
+  const Eigen::Vector3d origin = position(fixedAtoms.front());
+
+  // Fixed atom farthest from the first one
+  Eigen::Vector3d direction = Eigen::Vector3d::Zero();
+  for(const AtomIndex i : fixedAtoms) {
+    const Eigen::Vector3d difference = position(i) - origin;
+    if(difference.norm() > direction.norm()) {
+      direction = difference;
+    }
+  }
+
+  // All fixed atoms coincide: Any plane through them will do
+  if(direction.norm() < tolerance) {
+    return MirrorPlane {origin, Eigen::Vector3d::UnitY()};
+  }
+  direction.normalize();
+
+  // Fixed atom farthest from the line through the first two
+  Eigen::Vector3d offLine = Eigen::Vector3d::Zero();
+  for(const AtomIndex i : fixedAtoms) {
+    const Eigen::Vector3d difference = position(i) - origin;
+    const Eigen::Vector3d perpendicular = difference - difference.dot(direction) * direction;
+    if(perpendicular.norm() > offLine.norm()) {
+      offLine = perpendicular;
+    }
+  }
+
+  // Collinear fixed atoms: Pick any plane containing the line
+  if(offLine.norm() < tolerance) {
+    Eigen::Vector3d axis = Eigen::Vector3d::Zero();
+    Eigen::Index minimalComponent;
+    direction.cwiseAbs().minCoeff(&minimalComponent);
+    axis(minimalComponent) = 1;
+    return MirrorPlane {origin, direction.cross(axis).normalized()};
+  }
+
+  const Eigen::Vector3d normal = direction.cross(offLine).normalized();
+  for(const AtomIndex i : fixedAtoms) {
+    if(std::fabs((position(i) - origin).dot(normal)) > tolerance) {
+      return boost::none;
+    }
+  }
+
+  return MirrorPlane {origin, normal};
+}
+
 Molecule narrow(Molecule molecule, Random::Engine& engine) {
   const auto& stereopermutatorList = molecule.stereopermutators();
 
@@ -151,16 +282,27 @@ struct InversionOrIterLimitStop {
 
   template<typename StepValues>
   bool shouldContinue(unsigned iteration, const StepValues& step) {
+    if(monitor.enabled) {
+      monitor.observe(
+        iteration,
+        step.values.current,
+        step.gradients.current.template cast<double>().norm(),
+        refinementFunctorReference.proportionChiralConstraintsCorrectSign
+      );
+    }
+
     return (
       iteration < iterLimit
       && refinementFunctorReference.proportionChiralConstraintsCorrectSign < 1.0
       && (step.parameters.proposed - step.parameters.current).norm() > minParameterDiffNorm
+      && !monitor.doomed
     );
   }
 
   const unsigned iterLimit;
   const EigenRefinementType& refinementFunctorReference;
   double minParameterDiffNorm = 1e-3;
+  StagnationMonitor monitor;
 };
 
 template<typename FloatType>
@@ -169,18 +311,222 @@ struct GradientOrIterLimitStop {
 
   template<typename StepValues>
   bool shouldContinue(unsigned iteration, const StepValues& step) {
+    const double gradientNorm = step.gradients.current.template cast<double>().norm();
+    if(monitor.enabled) {
+      monitor.observe(iteration, step.values.current, gradientNorm);
+    }
+
     return (
       iteration < iterLimit
-      && step.gradients.current.template cast<double>().norm() > gradNorm
+      && gradientNorm > gradNorm
       && (step.parameters.proposed - step.parameters.current).norm() > minParameterDiffNorm
+      && !monitor.doomed
     );
   }
 
   unsigned iterLimit = 10000;
   double gradNorm = 1e-5;
   double minParameterDiffNorm = 1e-3;
+  StagnationMonitor monitor;
+};
+
+//! Forwards to a refinement functor, counting function evaluations
+template<typename EigenRefinementType>
+struct EvaluationCounter {
+  using VectorType = typename EigenRefinementType::VectorType;
+  using FloatType = typename EigenRefinementType::FloatingPointType;
+
+  explicit EvaluationCounter(const EigenRefinementType& functor)
+    : refinementFunctorReference(functor) {}
+
+  void operator() (const VectorType& parameters, FloatType& value, Eigen::Ref<VectorType> gradient) {
+    ++evaluations;
+    refinementFunctorReference(parameters, value, gradient);
+  }
+
+  const EigenRefinementType& refinementFunctorReference;
+  unsigned evaluations = 0;
+};
+
+//! Iterations spent in the first two refinement stages
+struct FourthDimensionIterations {
+  unsigned invertChirals = 0;
+  unsigned compressFourthDimension = 0;
 };
 
+//! Sets up a refinement problem for a molecule's constraints
+template<typename RefinementType>
+std::unique_ptr<RefinementType> makeRefinementProblem(
+  const Eigen::MatrixXd& squaredBounds,
+  const MoleculeDGInformation& DgData,
+  const unsigned parallelChunks
+) {
+  auto refinementFunctorPtr = std::make_unique<RefinementType>(
+    squaredBounds,
+    DgData.chiralConstraints,
+    DgData.dihedralConstraints
+  );
+  refinementFunctorPtr->parallelChunks = parallelChunks;
+  return refinementFunctorPtr;
+}
+
+/*! @brief Inverts chiral constraints and compresses out the fourth dimension
+ *
+ * Refines in the floating-point type of the template arguments. The
+ * linearized positions are copied into that type and written back in double
+ * precision.
+ *
+ * Afterwards, @p refinementFunctor compresses the fourth dimension and has
+ * the fixed atoms removed from its variables, so that it can be reused for
+ * further refinement.
+ */
+template<unsigned dimensionality, typename FloatType, bool SIMD>
+outcome::result<FourthDimensionIterations> refineFourthDimension(
+  Eigen::VectorXd& positions,
+  EigenRefinementProblem<dimensionality, FloatType, SIMD>& refinementFunctor,
+  const Configuration& configuration,
+  const std::vector<AtomIndex>& fixedAtoms
+) {
+  using RefinementType = EigenRefinementProblem<dimensionality, FloatType, SIMD>;
+  using VectorType = typename RefinementType::VectorType;
+
+  VectorType transformedPositions = positions.template cast<FloatType>();
+  const unsigned N = transformedPositions.size() / dimensionality;
+
+  /* If a count of chiral constraints reveals that more than half are
+   * incorrect, we can invert the structure (by multiplying e.g. all y
+   * coordinates with -1) and then have more than half of chirality
+   * constraints correct! In the count, chiral constraints with a target
+   * value of zero are not considered (this would skew the count as those
+   * chiral constraints should not have to pass an energetic maximum to
+   * converge properly as opposed to tetrahedra with volume).
+   *
+   * Fixed atoms are already aligned to their positions. They must stay in
+   * place, so the structure is reflected through a plane containing all of
+   * them. If there is no such plane, the fixed atoms determine the handedness
+   * and the structure cannot be inverted.
+   */
+  double initiallyCorrectChiralConstraints = refinementFunctor.calculateProportionChiralConstraintsCorrectSign(transformedPositions);
+  if(initiallyCorrectChiralConstraints < 0.5) {
+    if(const auto planeOption = fixedAtomsMirrorPlane(positions, dimensionality, fixedAtoms)) {
+      for(unsigned i = 0; i < N; ++i) {
+        const Eigen::Vector3d x = transformedPositions.template segment<3>(dimensionality * i).template cast<double>();
+        const double height = (x - planeOption->point).dot(planeOption->normal);
+        transformedPositions.template segment<3>(dimensionality * i) = (
+          x - 2 * height * planeOption->normal
+        ).template cast<FloatType>();
+      }
+
+      for(const AtomIndex i : fixedAtoms) {
+        transformedPositions.template segment<dimensionality>(dimensionality * i) = positions.template segment<dimensionality>(dimensionality * i).template cast<FloatType>();
+      }
+
+      initiallyCorrectChiralConstraints = 1 - initiallyCorrectChiralConstraints;
+    }
+  }
+
+  // Optimize only the free atoms' positions
+  refinementFunctor.fixAtoms(fixedAtoms, transformedPositions);
+  transformedPositions = refinementFunctor.reduce(transformedPositions);
+
+  FourthDimensionIterations iterations;
+
+  /* Refinement without penalty on fourth dimension only necessary if not all
+   * chiral centers are correct. Of course, for molecules without chiral
+   * centers at all, this stage is unnecessary
+   */
+  if(initiallyCorrectChiralConstraints < 1) {
+    MOLASSEMBLER_PROFILE_SCOPE("Refinement.invertChirals");
+    InversionOrIterLimitStop<RefinementType> inversionChecker {
+      configuration.refinementStepLimit,
+      refinementFunctor
+    };
+    inversionChecker.monitor.enabled = configuration.abortStagnantRefinement;
+    EvaluationCounter<RefinementType> counter {refinementFunctor};
+
+    Temple::Lbfgs<FloatType, 32> optimizer;
+
+    try {
+      auto result = optimizer.minimize(
+        transformedPositions,
+        counter,
+        inversionChecker
+      );
+      iterations.invertChirals = result.iterations;
+    } catch(std::runtime_error& e) {
+      return DgError::RefinementException;
+    }
+
+    MOLASSEMBLER_PROFILE_COUNT("Refinement.invertChirals.iterations", iterations.invertChirals);
+    MOLASSEMBLER_PROFILE_COUNT("Refinement.invertChirals.evaluations", counter.evaluations);
+
+    if(inversionChecker.monitor.doomed) {
+      return DgError::RefinementAborted;
+    }
+
+    if(iterations.invertChirals >= configuration.refinementStepLimit) {
+      return DgError::RefinementMaxIterationsReached;
+    }
+
+    if(refinementFunctor.proportionChiralConstraintsCorrectSign < 1.0) {
+      return DgError::RefinedChiralsWrong;
+    }
+  }
+
+  /* Set up the second stage of refinement where we compress out the fourth
+   * dimension that we allowed expansion into to invert the chiralities.
+   */
+  refinementFunctor.compressFourthDimension = true;
+
+  GradientOrIterLimitStop<FloatType> gradientChecker;
+  gradientChecker.gradNorm = 1e-3;
+  gradientChecker.iterLimit = configuration.refinementStepLimit - iterations.invertChirals;
+  gradientChecker.monitor.enabled = configuration.abortStagnantRefinement;
+
+  {
+    MOLASSEMBLER_PROFILE_SCOPE("Refinement.compressFourthDimension");
+    EvaluationCounter<RefinementType> counter {refinementFunctor};
+
+    try {
+      Temple::Lbfgs<FloatType, 32> optimizer;
+
+      auto result = optimizer.minimize(
+        transformedPositions,
+        counter,
+        gradientChecker
+      );
+      iterations.compressFourthDimension = result.iterations;
+    } catch(std::out_of_range& e) {
+      return DgError::RefinementException;
+    }
+
+    MOLASSEMBLER_PROFILE_COUNT("Refinement.compressFourthDimension.iterations", iterations.compressFourthDimension);
+    MOLASSEMBLER_PROFILE_COUNT("Refinement.compressFourthDimension.evaluations", counter.evaluations);
+  }
+
+  if(gradientChecker.monitor.doomed) {
+    return DgError::RefinementAborted;
+  }
+
+  // Max iterations reached
+  if(iterations.compressFourthDimension >= gradientChecker.iterLimit) {
+    return DgError::RefinementMaxIterationsReached;
+  }
+
+  // Not all chiral constraints have the right sign
+  if(refinementFunctor.proportionChiralConstraintsCorrectSign < 1) {
+    return DgError::RefinedChiralsWrong;
+  }
+
+  // Fixed atoms keep their positions exactly, irrespective of FloatType
+  Eigen::VectorXd refinedPositions = refinementFunctor.expand(transformedPositions).template cast<double>();
+  for(const AtomIndex i : fixedAtoms) {
+    refinedPositions.template segment<dimensionality>(dimensionality * i) = positions.template segment<dimensionality>(dimensionality * i);
+  }
+  positions = std::move(refinedPositions);
+  return iterations;
+}
+
 template<unsigned dimensionality>
 Eigen::Vector3d averagePosition(
   const Eigen::VectorXd& linearPositions,
@@ -202,7 +548,8 @@ template<unsigned dimensionality>
 void twistRotatableDihedrals(
   Eigen::Ref<Eigen::VectorXd> positions,
   const std::vector<DihedralConstraint>& constraints,
-  const MoleculeDGInformation::GroupMapType& rotatableGroupMap
+  const MoleculeDGInformation::GroupMapType& rotatableGroupMap,
+  const std::vector<bool>& isFixed
 ) {
   for(const DihedralConstraint& constraint : constraints) {
     const AtomIndex j = constraint.sites.at(1).front();
@@ -216,6 +563,18 @@ void twistRotatableDihedrals(
 
     const MoleculeDGInformation::RotatableGroup& group = findIter->second;
 
+    // Twisting must not move fixed atoms
+    if(
+      !isFixed.empty()
+      && std::any_of(
+        std::begin(group.vertices),
+        std::end(group.vertices),
+        [&](const AtomIndex i) -> bool { return isFixed.at(i); }
+      )
+    ) {
+      continue;
+    }
+
     const Eigen::Vector3d jVector = positions.template segment<3>(dimensionality * j);
     const Eigen::Vector3d kVector = positions.template segment<3>(dimensionality * k);
 
@@ -309,8 +668,11 @@ outcome::result<AngstromPositions> refine(
   Eigen::MatrixXd embeddedPositions,
   const DistanceBoundsMatrix& distanceBounds,
   const Configuration& configuration,
-  const std::shared_ptr<MoleculeDGInformation>& DgDataPtr
+  const std::shared_ptr<MoleculeDGInformation>& DgDataPtr,
+  const unsigned parallelChunks
 ) {
+  MOLASSEMBLER_PROFILE_SCOPE("Refinement");
+
   /* Refinement problem compile-time settings
    * - Dimensionality four is needed to ensure chiral constraints invert
    *   nicely
@@ -318,6 +680,10 @@ outcome::result<AngstromPositions> refine(
    *   doesn't affect speed
    * - Using the alternative SIMD implementations of the refinement problems
    *   hardly affects speed at all, in fact, it commonly worsens it.
+   *
+   * With mixed precision refinement, the first two stages are run in float
+   * with the SIMD implementation, which fits twice as many terms into each
+   * vector register as double does.
    */
   constexpr unsigned dimensionality = 4;
   using FloatType = double;
@@ -332,101 +698,64 @@ outcome::result<AngstromPositions> refine(
     embeddedPositions.cols() * embeddedPositions.rows()
   ).template cast<FloatType>().eval();
 
-  const unsigned N = transformedPositions.size() / dimensionality;
-
   const auto squaredBounds = static_cast<Eigen::MatrixXd>(
     distanceBounds.access().cwiseProduct(distanceBounds.access())
   );
 
-  FullRefinementType refinementFunctor {
-    squaredBounds,
-    DgDataPtr->chiralConstraints,
-    DgDataPtr->dihedralConstraints
-  };
-
-  /* If a count of chiral constraints reveals that more than half are
-   * incorrect, we can invert the structure (by multiplying e.g. all y
-   * coordinates with -1) and then have more than half of chirality
-   * constraints correct! In the count, chiral constraints with a target
-   * value of zero are not considered (this would skew the count as those
-   * chiral constraints should not have to pass an energetic maximum to
-   * converge properly as opposed to tetrahedra with volume).
+  /* Optionally remove atoms with fixed positions from refinement. These are
+   * placed at their fixed positions beforehand.
    */
-  double initiallyCorrectChiralConstraints = refinementFunctor.calculateProportionChiralConstraintsCorrectSign(transformedPositions);
-  if(initiallyCorrectChiralConstraints < 0.5) {
-    // Invert y coordinates
-    for(unsigned i = 0; i < N; ++i) {
-      transformedPositions(dimensionality * i + 1) *= -1;
-    }
-
-    initiallyCorrectChiralConstraints = 1 - initiallyCorrectChiralConstraints;
-  }
-
-  /* Refinement without penalty on fourth dimension only necessary if not all
-   * chiral centers are correct. Of course, for molecules without chiral
-   * centers at all, this stage is unnecessary
-   */
-  unsigned firstStageIterations = 0;
-  if(initiallyCorrectChiralConstraints < 1) {
-    Detail::InversionOrIterLimitStop<FullRefinementType> inversionChecker {
-      configuration.refinementStepLimit,
-      refinementFunctor
-    };
-
-    Temple::Lbfgs<FloatType, 32> optimizer;
-
-    try {
-      auto result = optimizer.minimize(
-        transformedPositions,
-        refinementFunctor,
-        inversionChecker
-      );
-      firstStageIterations = result.iterations;
-    } catch(std::runtime_error& e) {
-      return DgError::RefinementException;
-    }
-
-    if(firstStageIterations >= configuration.refinementStepLimit) {
-      return DgError::RefinementMaxIterationsReached;
+  const unsigned N = transformedPositions.size() / dimensionality;
+  std::vector<AtomIndex> fixedAtoms;
+  std::vector<bool> isFixed;
+  if(configuration.freezeFixedPositions && !configuration.fixedPositions.empty()) {
+    isFixed.resize(N, false);
+    for(const auto& indexPositionPair : configuration.fixedPositions) {
+      fixedAtoms.push_back(indexPositionPair.first);
+      isFixed.at(indexPositionPair.first) = true;
     }
 
-    if(refinementFunctor.proportionChiralConstraintsCorrectSign < 1.0) {
-      return DgError::RefinedChiralsWrong;
-    }
+    Detail::alignToFixedPositions(transformedPositions, configuration);
   }
 
-  /* Set up the second stage of refinement where we compress out the fourth
-   * dimension that we allowed expansion into to invert the chiralities.
+  /* The full precision problem is set up once and reused for the dihedral
+   * stage. Mixed precision refinement sets up a single precision problem for
+   * the first two stages and the full precision problem only afterwards.
    */
-  refinementFunctor.compressFourthDimension = true;
-
-  unsigned secondStageIterations = 0;
-  Detail::GradientOrIterLimitStop<FloatType> gradientChecker;
-  gradientChecker.gradNorm = 1e-3;
-  gradientChecker.iterLimit = configuration.refinementStepLimit - firstStageIterations;
-
-  try {
-    Temple::Lbfgs<FloatType, 32> optimizer;
-
-    auto result = optimizer.minimize(
+  std::unique_ptr<FullRefinementType> refinementFunctorPtr;
+  outcome::result<Detail::FourthDimensionIterations> fourthDimensionResult = Detail::FourthDimensionIterations {};
+  if(configuration.mixedPrecisionRefinement) {
+    using MixedRefinementType = EigenRefinementProblem<dimensionality, float, true>;
+    auto mixedFunctorPtr = Detail::makeRefinementProblem<MixedRefinementType>(
+      squaredBounds,
+      *DgDataPtr,
+      parallelChunks
+    );
+    fourthDimensionResult = Detail::refineFourthDimension(
       transformedPositions,
-      refinementFunctor,
-      gradientChecker
+      *mixedFunctorPtr,
+      configuration,
+      fixedAtoms
+    );
+  } else {
+    refinementFunctorPtr = Detail::makeRefinementProblem<FullRefinementType>(
+      squaredBounds,
+      *DgDataPtr,
+      parallelChunks
+    );
+    fourthDimensionResult = Detail::refineFourthDimension(
+      transformedPositions,
+      *refinementFunctorPtr,
+      configuration,
+      fixedAtoms
     );
-    secondStageIterations = result.iterations;
-  } catch(std::out_of_range& e) {
-    return DgError::RefinementException;
   }
-
-  // Max iterations reached
-  if(secondStageIterations >= gradientChecker.iterLimit) {
-    return DgError::RefinementMaxIterationsReached;
+  if(!fourthDimensionResult) {
+    return fourthDimensionResult.as_failure();
   }
 
-  // Not all chiral constraints have the right sign
-  if(refinementFunctor.proportionChiralConstraintsCorrectSign < 1) {
-    return DgError::RefinedChiralsWrong;
-  }
+  const unsigned firstStageIterations = fourthDimensionResult.value().invertChirals;
+  const unsigned secondStageIterations = fourthDimensionResult.value().compressFourthDimension;
 
   /* Twist all freely rotatable dihedrals to their target values to avoid
    * conflicts between distance and dihedral errors to prevent rotations to
@@ -435,38 +764,70 @@ outcome::result<AngstromPositions> refine(
   Detail::twistRotatableDihedrals<dimensionality>(
     transformedPositions,
     DgDataPtr->dihedralConstraints,
-    DgDataPtr->rotatableGroups
+    DgDataPtr->rotatableGroups,
+    isFixed
   );
 
-  /* Add dihedral terms and refine again */
+  /* Add dihedral terms and refine again. Without mixed precision, the
+   * problem of the previous stages is reused. It already compresses the
+   * fourth dimension and has the fixed atoms removed, whose positions the
+   * twist leaves unchanged.
+   */
+  if(!refinementFunctorPtr) {
+    refinementFunctorPtr = Detail::makeRefinementProblem<FullRefinementType>(
+      squaredBounds,
+      *DgDataPtr,
+      parallelChunks
+    );
+    refinementFunctorPtr->compressFourthDimension = true;
+    refinementFunctorPtr->fixAtoms(fixedAtoms, transformedPositions);
+  }
+  FullRefinementType& refinementFunctor = *refinementFunctorPtr;
+  VectorType refinementParameters = refinementFunctor.reduce(transformedPositions);
+
   unsigned thirdStageIterations = 0;
-  gradientChecker = Detail::GradientOrIterLimitStop<FloatType> {};
+  Detail::GradientOrIterLimitStop<FloatType> gradientChecker;
   gradientChecker.gradNorm = 1e-3;
   gradientChecker.iterLimit = (
     configuration.refinementStepLimit
     - firstStageIterations
     - secondStageIterations
   );
+  gradientChecker.monitor.enabled = configuration.abortStagnantRefinement;
 
   refinementFunctor.dihedralTerms = true;
 
-  try {
-    Temple::Lbfgs<FloatType, 32> optimizer;
+  {
+    MOLASSEMBLER_PROFILE_SCOPE("Refinement.dihedrals");
+    Detail::EvaluationCounter<FullRefinementType> counter {refinementFunctor};
 
-    auto result = optimizer.minimize(
-      transformedPositions,
-      refinementFunctor,
-      gradientChecker
-    );
-    thirdStageIterations = result.iterations;
-  } catch(std::out_of_range& e) {
-    return DgError::RefinementException;
+    try {
+      Temple::Lbfgs<FloatType, 32> optimizer;
+
+      auto result = optimizer.minimize(
+        refinementParameters,
+        counter,
+        gradientChecker
+      );
+      thirdStageIterations = result.iterations;
+    } catch(std::out_of_range& e) {
+      return DgError::RefinementException;
+    }
+
+    MOLASSEMBLER_PROFILE_COUNT("Refinement.dihedrals.iterations", thirdStageIterations);
+    MOLASSEMBLER_PROFILE_COUNT("Refinement.dihedrals.evaluations", counter.evaluations);
+  }
+
+  if(gradientChecker.monitor.doomed) {
+    return DgError::RefinementAborted;
   }
 
   if(thirdStageIterations >= gradientChecker.iterLimit) {
     return DgError::RefinementMaxIterationsReached;
   }
 
+  transformedPositions = refinementFunctor.expand(refinementParameters);
+
   // Structure inacceptable
   if(
     !finalStructureAcceptable(
@@ -480,7 +841,8 @@ outcome::result<AngstromPositions> refine(
 
   auto gatheredPositions = Detail::gather(transformedPositions);
 
-  if(!configuration.fixedPositions.empty()) {
+  // Frozen fixed positions are already in place
+  if(!configuration.fixedPositions.empty() && fixedAtoms.empty()) {
     return Detail::convertToAngstromPositions(
       Detail::fitAndSetFixedPositions(gatheredPositions, configuration)
     );
@@ -489,25 +851,92 @@ outcome::result<AngstromPositions> refine(
   return Detail::convertToAngstromPositions(gatheredPositions);
 }
 
-outcome::result<AngstromPositions> generateConformer(
-  const Molecule& molecule,
-  const Configuration& configuration,
-  std::shared_ptr<MoleculeDGInformation>& DgDataPtr,
-  bool regenerateDGDataEachStep,
-  Random::Engine& engine
-) {
-  if(regenerateDGDataEachStep) {
-    auto moleculeCopy = Detail::narrow(molecule, engine);
+constexpr unsigned AssignmentFailureMemo::failureThreshold;
+
+AssignmentFailureMemo::Key AssignmentFailureMemo::key(const Molecule& molecule) {
+  // Kind, placement and assignment of each stereopermutator
+  std::vector<std::array<unsigned, 4>> entries;
+  const unsigned unassigned = std::numeric_limits<unsigned>::max();
+  for(const auto& permutator : molecule.stereopermutators().atomStereopermutators()) {
+    entries.push_back({{
+      0,
+      static_cast<unsigned>(permutator.placement()),
+      0,
+      permutator.assigned().value_or(unassigned)
+    }});
+  }
+  for(const auto& permutator : molecule.stereopermutators().bondStereopermutators()) {
+    const BondIndex placement = permutator.placement();
+    entries.push_back({{
+      1,
+      static_cast<unsigned>(placement.first),
+      static_cast<unsigned>(placement.second),
+      permutator.assigned().value_or(unassigned)
+    }});
+  }
 
-    if(moleculeCopy.stereopermutators().hasZeroAssignmentStereopermutators()) {
-      return DgError::ZeroAssignmentStereopermutators;
+  // Stereopermutator list iteration order is unspecified
+  std::sort(std::begin(entries), std::end(entries));
+
+  Key key;
+  key.reserve(4 * entries.size());
+  for(const auto& entry : entries) {
+    key.insert(std::end(key), std::begin(entry), std::end(entry));
+  }
+  return key;
+}
+
+void AssignmentFailureMemo::record(const Key& key, const bool success) {
+#pragma omp critical(assignmentFailureMemo)
+  {
+    Tally& tally = tallies_[key];
+    if(success) {
+      tally.succeeded = true;
+    } else {
+      ++tally.failures;
     }
+  }
+}
 
-    DgDataPtr = std::make_shared<MoleculeDGInformation>(
-      gatherDGInformation(moleculeCopy, configuration)
+bool AssignmentFailureMemo::infeasible(const Key& key) const {
+  bool isInfeasible = false;
+#pragma omp critical(assignmentFailureMemo)
+  {
+    const auto findIter = tallies_.find(key);
+    isInfeasible = (
+      findIter != std::end(tallies_)
+      && !findIter->second.succeeded
+      && findIter->second.failures >= failureThreshold
     );
   }
+  return isInfeasible;
+}
+
+void AssignmentFailureMemo::recordRedraw() {
+#pragma omp critical(assignmentFailureMemo)
+  {
+    ++redraws_;
+  }
+}
 
+unsigned AssignmentFailureMemo::redraws() const {
+  unsigned count = 0;
+#pragma omp critical(assignmentFailureMemo)
+  {
+    count = redraws_;
+  }
+  return count;
+}
+
+namespace Detail {
+
+outcome::result<AngstromPositions> modelConformer(
+  const Molecule& molecule,
+  const Configuration& configuration,
+  const std::shared_ptr<MoleculeDGInformation>& DgDataPtr,
+  Random::Engine& engine,
+  const unsigned parallelChunks
+) {
   ExplicitBoundsGraph explicitGraph {
     molecule.graph().inner(),
     DgDataPtr->bounds
@@ -548,10 +977,77 @@ outcome::result<AngstromPositions> generateConformer(
     std::move(embeddedPositions),
     distanceBounds,
     configuration,
-    DgDataPtr
+    DgDataPtr,
+    parallelChunks
   );
 }
 
+} // namespace Detail
+
+outcome::result<AngstromPositions> generateConformer(
+  const Molecule& molecule,
+  const Configuration& configuration,
+  std::shared_ptr<MoleculeDGInformation>& DgDataPtr,
+  bool regenerateDGDataEachStep,
+  Random::Engine& engine,
+  const unsigned parallelChunks,
+  AssignmentFailureMemo* failureMemo
+) {
+  MOLASSEMBLER_PROFILE_SCOPE("DistanceGeometry.generateConformer");
+
+  if(!regenerateDGDataEachStep) {
+    return Detail::modelConformer(molecule, configuration, DgDataPtr, engine, parallelChunks);
+  }
+
+  auto moleculeCopy = Detail::narrow(molecule, engine);
+
+  AssignmentFailureMemo::Key assignmentKey;
+  if(failureMemo != nullptr) {
+    /* Redraw assignments known to be infeasible. The number of redraws is
+     * limited since all assignments may be infeasible.
+     */
+    constexpr unsigned maxRedraws = 10;
+    assignmentKey = AssignmentFailureMemo::key(moleculeCopy);
+    for(
+      unsigned redraw = 0;
+      redraw < maxRedraws && failureMemo->infeasible(assignmentKey);
+      ++redraw
+    ) {
+      MOLASSEMBLER_PROFILE_COUNT("DistanceGeometry.infeasibleAssignmentRedraws", 1);
+      failureMemo->recordRedraw();
+      moleculeCopy = Detail::narrow(molecule, engine);
+      assignmentKey = AssignmentFailureMemo::key(moleculeCopy);
+    }
+  }
+
+  auto result = [&]() -> outcome::result<AngstromPositions> {
+    if(moleculeCopy.stereopermutators().hasZeroAssignmentStereopermutators()) {
+      return DgError::ZeroAssignmentStereopermutators;
+    }
+
+    DgDataPtr = std::make_shared<MoleculeDGInformation>(
+      gatherDGInformation(moleculeCopy, configuration)
+    );
+
+    return Detail::modelConformer(molecule, configuration, DgDataPtr, engine, parallelChunks);
+  }();
+
+  // Only failures caused by the assignment itself are recorded
+  if(failureMemo != nullptr) {
+    if(result) {
+      failureMemo->record(assignmentKey, true);
+    } else if(
+      result.error() == DgError::ZeroAssignmentStereopermutators
+      || result.error() == DgError::GraphImpossible
+      || result.error() == DgError::RefinedChiralsWrong
+    ) {
+      failureMemo->record(assignmentKey, false);
+    }
+  }
+
+  return result;
+}
+
 std::vector<
   outcome::result<AngstromPositions>
 > run(
@@ -625,6 +1121,47 @@ std::vector<
     backgroundEngine
   );
 
+  /* Conformers are generated in parallel if there are enough of them to
+   * occupy all threads. Otherwise, a large molecule's conformers are
+   * generated sequentially and the evaluation of the refinement error
+   * function of each is parallelized instead. Below a few hundred atoms, the
+   * distance terms are too cheap to benefit from splitting.
+   *
+   * Chunking changes the summation order of the error function terms, so
+   * conformers refined in parallel may differ in the last digits from those
+   * refined serially. Chunks are used only if refinement is parallelized.
+   * Their number is independent of the number of threads, so parallel
+   * refinement yields the same conformers with any number of threads.
+   */
+  constexpr unsigned parallelRefinementMinimumAtoms = 200;
+  const bool parallelizeRefinement = (
+    molecule.graph().N() >= parallelRefinementMinimumAtoms
+    && numConformers < nThreads
+  );
+  const unsigned refinementChunks = parallelizeRefinement ? 32 : 1;
+
+  /* Random stereopermutator assignments that keep failing are shared across
+   * all conformers of the ensemble
+   */
+  AssignmentFailureMemo failureMemo;
+  AssignmentFailureMemo* failureMemoPtr = nullptr;
+  if(regenerateEachStep && configuration.avoidInfeasibleAssignments) {
+    failureMemoPtr = &failureMemo;
+  }
+
+  // Conformers redundant with previously accepted ones are rejected
+  boost::optional<EnsembleFilter> filterOption;
+  if(configuration.deduplicationRmsd > 0) {
+    filterOption.emplace(
+      configuration.deduplicationRmsd * Utils::Constants::angstrom_per_bohr,
+      (
+        configuration.symmetryAwareDeduplication
+        ? EnsembleFilter::automorphisms(molecule)
+        : std::vector<std::vector<AtomIndex>> {}
+      )
+    );
+  }
+
   /* Each thread has its own DgDataPtr, for the following reason: If we do
    * not need to regenerate the SpatialModel data, then having all threads
    * share access the underlying data to generate conformers is fine. If,
@@ -632,7 +1169,7 @@ std::vector<
    * conformer, then each thread will reset its pointer to its self-generated
    * SpatialModel data, creating thread-private state.
    */
-#pragma omp parallel for firstprivate(DgDataPtr) schedule(dynamic)
+#pragma omp parallel for firstprivate(DgDataPtr) schedule(dynamic) if(!parallelizeRefinement)
   for(unsigned i = 0; i < numConformers; ++i) {
     // Get thread-specific randomness engine reference
 #ifdef _OPENMP
@@ -650,15 +1187,30 @@ std::vector<
      * environment and exceptions are not propagated anywhere
      */
     try {
-      // Generate the conformer
-      auto conformerResult = generateConformer(
-        molecule,
-        configuration,
-        DgDataPtr,
-        regenerateEachStep,
-        engine
+      // Generate the conformer, retrying aborted refinements
+      auto conformerResult = retryAbortedRefinements(
+        configuration.abortedRefinementRetries,
+        [&]() {
+          return generateConformer(
+            molecule,
+            configuration,
+            DgDataPtr,
+            regenerateEachStep,
+            engine,
+            refinementChunks,
+            failureMemoPtr
+          );
+        }
       );
 
+      if(
+        filterOption
+        && conformerResult
+        && !filterOption->accept(conformerResult.value().positions)
+      ) {
+        conformerResult = DgError::DuplicateConformer;
+      }
+
       results.at(i) = std::move(conformerResult);
     } catch(std::exception& e) {
 #pragma omp critical(outputWarning)
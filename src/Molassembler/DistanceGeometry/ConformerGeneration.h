@@ -11,8 +11,12 @@
 #ifndef INCLUDE_MOLASSEMBLER_DISTANCE_GEOMETRY_CONFORMER_GENERATION_H
 #define INCLUDE_MOLASSEMBLER_DISTANCE_GEOMETRY_CONFORMER_GENERATION_H
 
+#include "Molassembler/DistanceGeometry/Error.h"
 #include "Molassembler/DistanceGeometry/SpatialModel.h"
 #include "Molassembler/Log.h"
+#include "Molassembler/Profiling.h"
+
+#include <map>
 
 namespace Scine {
 namespace Molassembler {
@@ -50,6 +54,25 @@ Eigen::MatrixXd fitAndSetFixedPositions(
   const Configuration& configuration
 );
 
+/**
+ * @brief Moves four-dimensional linear positions into the frame of the fixed
+ *   positions
+ *
+ * Fits the positions or their mirror image, whichever is closer, onto the
+ * fixed positions. Then places the fixed atoms exactly onto their fixed
+ * positions with zero fourth dimension component.
+ *
+ * If the fixed atoms are coplanar, both fits are equally close and the choice
+ * is arbitrary. Refinement then chooses the handedness by reflecting through
+ * that plane if needed.
+ *
+ * @complexity{Two quaternion fits, linear in the number of atoms}
+ */
+void alignToFixedPositions(
+  Eigen::Ref<Eigen::VectorXd> vectorizedPositions,
+  const Configuration& configuration
+);
+
 /*!
  * @brief Assigns any unassigned stereopermutators in a molecule at random
  *
@@ -82,7 +105,7 @@ struct MoleculeDGInformation {
     const Molecule& molecule
   );
 
-  SpatialModel::BoundsMatrix bounds;
+  PairwiseBounds bounds;
   std::vector<ChiralConstraint> chiralConstraints;
   std::vector<DihedralConstraint> dihedralConstraints;
   GroupMapType rotatableGroups;
@@ -99,23 +122,114 @@ MoleculeDGInformation gatherDGInformation(
   const Configuration& configuration
 );
 
-//! @brief Distance Geometry refinement
+/*! @brief Thread-safe record of stereopermutator assignments that fail modeling
+ *
+ * Assignments are keyed by the sorted placements and assignment indices of all
+ * stereopermutators of a fully assigned molecule. An assignment is considered
+ * infeasible once it has failed to yield a conformer a few times without ever
+ * succeeding.
+ */
+class AssignmentFailureMemo {
+public:
+  using Key = std::vector<unsigned>;
+
+  //! Number of failures without success until an assignment is infeasible
+  static constexpr unsigned failureThreshold = 3;
+
+  /*! @brief Generates the key of a molecule's stereopermutator assignments
+   *
+   * @complexity{@math{\Theta(S \log S)} where @math{S} is the number of
+   * stereopermutators}
+   */
+  static Key key(const Molecule& molecule);
+
+  /*! @brief Records the outcome of modeling an assignment
+   *
+   * @complexity{@math{O(\log K)} where @math{K} is the number of recorded
+   * assignments}
+   */
+  void record(const Key& key, bool success);
+
+  /*! @brief Whether an assignment has failed repeatedly and never succeeded
+   *
+   * @complexity{@math{O(\log K)} where @math{K} is the number of recorded
+   * assignments}
+   */
+  bool infeasible(const Key& key) const;
+
+  /*! @brief Records that an assignment known to be infeasible was redrawn
+   *
+   * @complexity{@math{\Theta(1)}}
+   */
+  void recordRedraw();
+
+  /*! @brief Number of assignments redrawn for being infeasible
+   *
+   * @complexity{@math{\Theta(1)}}
+   */
+  unsigned redraws() const;
+
+private:
+  struct Tally {
+    unsigned failures = 0;
+    bool succeeded = false;
+  };
+
+  std::map<Key, Tally> tallies_;
+  unsigned redraws_ = 0;
+};
+
+/*! @brief Distance Geometry refinement
+ *
+ * @param parallelChunks Number of chunks to split refinement error function
+ *   terms into for parallel evaluation. One chunk evaluates serially.
+ */
 outcome::result<AngstromPositions> refine(
   Eigen::MatrixXd embeddedPositions,
   const DistanceBoundsMatrix& distanceBounds,
   const Configuration& configuration,
-  const std::shared_ptr<MoleculeDGInformation>& DgDataPtr
+  const std::shared_ptr<MoleculeDGInformation>& DgDataPtr,
+  unsigned parallelChunks = 1
 );
 
-// @brief Individual conformer generation routine
+/*! @brief Individual conformer generation routine
+ *
+ * @param failureMemo If supplied and the spatial model is regenerated for
+ *   each conformer, random stereopermutator assignments known to be
+ *   infeasible are redrawn and the outcome of modeling is recorded.
+ */
 outcome::result<AngstromPositions> generateConformer(
   const Molecule& molecule,
   const Configuration& configuration,
   std::shared_ptr<MoleculeDGInformation>& DgDataPtr,
   bool regenerateDGDataEachStep,
-  Random::Engine& engine
+  Random::Engine& engine,
+  unsigned parallelChunks = 1,
+  AssignmentFailureMemo* failureMemo = nullptr
 );
 
+/*! @brief Retries conformer generation while refinement is aborted
+ *
+ * Calls @p generate, then calls it again up to @p retries times for as long
+ * as its refinement is aborted for stagnating.
+ *
+ * @param retries Maximum number of retries
+ * @param generate Nullary callable yielding an outcome::result
+ */
+template<typename F>
+auto retryAbortedRefinements(const unsigned retries, F&& generate) -> decltype(generate()) {
+  auto result = generate();
+  for(
+    unsigned retry = 0;
+    retry < retries && !result && result.error() == DgError::RefinementAborted;
+    ++retry
+  ) {
+    MOLASSEMBLER_PROFILE_COUNT("DistanceGeometry.abortedRefinementRetries", 1);
+    result = generate();
+  }
+  return result;
+}
+
 /** @brief Main and parallel implementation of Distance Geometry. Generates an
  *   ensemble of 3D structures of a given Molecule
  *
@@ -15,11 +15,16 @@
 #include "Molassembler/Temple/Functional.h"
 #include "Molassembler/Temple/Optionals.h"
 #include "Molassembler/Temple/Random.h"
+#include "Molassembler/DistanceGeometry/EnsembleFilter.h"
 #include "Molassembler/DistanceGeometry/Error.h"
 
 #include "Utils/Geometry/AtomCollection.h"
 #include "boost/variant.hpp"
 
+#include <algorithm>
+#include <iterator>
+#include <map>
+
 namespace Scine {
 namespace Molassembler {
 namespace Detail {
@@ -264,6 +269,7 @@ DirectedConformerGenerator::Impl::Impl(
   }
 
   // Add the BondStereopermutators to our underlying molecule's stereopermutator list
+  molecule_.pImpl_->materializeStereopermutators_();
   for(auto& bondStereopermutator : bondStereopermutators) {
     molecule_.pImpl_->stereopermutators_.add(
       std::move(bondStereopermutator)
@@ -299,6 +305,20 @@ DirectedConformerGenerator::Impl::generateNewDecisionList(Random::Engine& engine
   return decisionLists_.generateNewEntry(chooseFunctor);
 }
 
+DirectedConformerGenerator::DecisionList
+DirectedConformerGenerator::Impl::decisionListFromIndex(unsigned index) const {
+  assert(index < idealEnsembleSize());
+  const auto& bounds = decisionLists_.bounds();
+  const unsigned B = bounds.size();
+  DecisionList decisionList(B);
+  for(unsigned i = 0; i < B; ++i) {
+    const unsigned digit = B - 1 - i;
+    decisionList.at(digit) = index % bounds.at(digit);
+    index /= bounds.at(digit);
+  }
+  return decisionList;
+}
+
 Molecule DirectedConformerGenerator::Impl::conformationMolecule(const DecisionList& decisionList) const {
   StereopermutatorList permutators = molecule_.stereopermutators();
 
@@ -494,41 +514,106 @@ void DirectedConformerGenerator::Impl::enumerate(
   clear();
   const unsigned size = idealEnsembleSize();
 
-#pragma omp parallel for
-  for(unsigned increment = 0; increment < size; ++increment) {
-    Random::Engine localEngine(seed + increment);
-
-    DecisionList decisionList;
-#pragma omp critical(decisionSetAccess)
-    {
-      decisionList = generateNewDecisionList(localEngine);
-    }
+  // Conformers redundant with previously accepted ones are not passed on
+  boost::optional<DistanceGeometry::EnsembleFilter> filterOption;
+  if(settings.configuration.deduplicationRmsd > 0) {
+    filterOption.emplace(
+      settings.configuration.deduplicationRmsd,
+      (
+        settings.configuration.symmetryAwareDeduplication
+        ? DistanceGeometry::EnsembleFilter::automorphisms(molecule_)
+        : std::vector<std::vector<AtomIndex>> {}
+      )
+    );
+  }
 
+  /* Deduplication is applied across the enumerated ensemble, not within the
+   * generation of each individual conformer
+   */
+  EnumerationSettings conformerSettings = settings;
+  conformerSettings.configuration.deduplicationRmsd = 0;
+
+  auto generate = [&](
+    const DecisionList& decisionList,
+    Random::Engine& engine
+  ) -> outcome::result<Utils::PositionCollection> {
+    outcome::result<Utils::PositionCollection> conformer {DgError::DecisionListMismatch};
     for(unsigned i = 0; i < settings.dihedralRetries; ++i) {
-      outcome::result<Utils::PositionCollection> conformer {DgError::DecisionListMismatch};
-
+      conformer = DgError::DecisionListMismatch;
       try {
         conformer = generateConformation(
           decisionList,
-          localEngine(),
-          settings.configuration,
-          settings.fitting
+          engine(),
+          conformerSettings.configuration,
+          conformerSettings.fitting
         );
       } catch(...) {}
 
+      /* Only allow decision list failure retries for retries, break on
+       * anything else
+       */
+      if(conformer || conformer.error() != DgError::DecisionListMismatch) {
+        break;
+      }
+    }
+    return conformer;
+  };
+
+  if(settings.indexedEnumeration) {
+    /* Each thread decodes its decision lists from their indices. Refinement
+     * costs vary between decision lists, so indices are handed out
+     * dynamically. Results are passed on in order of decision list index:
+     * whichever thread completes the next index in order also passes on all
+     * consecutive results that are already complete. Only results waiting on
+     * an earlier, unfinished index are held back.
+     */
+    std::map<unsigned, boost::optional<Utils::PositionCollection>> pending;
+    unsigned nextIndex = 0;
+
+#pragma omp parallel for schedule(dynamic)
+    for(unsigned index = 0; index < size; ++index) {
+      Random::Engine localEngine(seed + index);
+      auto conformer = generate(decisionListFromIndex(index), localEngine);
+      boost::optional<Utils::PositionCollection> positionsOption;
       if(conformer) {
+        positionsOption = std::move(conformer.value());
+      }
+
 #pragma omp critical(guardCallback)
-        {
-          callback(decisionList, conformer.value());
+      {
+        pending.emplace(index, std::move(positionsOption));
+        auto pendingIter = std::begin(pending);
+        while(pendingIter != std::end(pending) && pendingIter->first == nextIndex) {
+          const DecisionList decisionList = decisionListFromIndex(nextIndex);
+          insert(decisionList);
+          auto& positions = pendingIter->second;
+          if(positions && (!filterOption || filterOption->accept(positions.value()))) {
+            callback(decisionList, std::move(positions.value()));
+          }
+          pendingIter = pending.erase(pendingIter);
+          ++nextIndex;
         }
-        break;
       }
+    }
 
-      if(conformer.error() != DgError::DecisionListMismatch) {
-        /* Only allow decision list failure retries for retries, break on
-         * anything else
-         */
-        break;
+    return;
+  }
+
+#pragma omp parallel for
+  for(unsigned increment = 0; increment < size; ++increment) {
+    Random::Engine localEngine(seed + increment);
+
+    DecisionList decisionList;
+#pragma omp critical(decisionSetAccess)
+    {
+      decisionList = generateNewDecisionList(localEngine);
+    }
+
+    auto conformer = generate(decisionList, localEngine);
+    if(conformer && (!filterOption || filterOption->accept(conformer.value()))) {
+#pragma omp critical(guardCallback)
+      {
+        callback(decisionList, conformer.value());
       }
     }
   }
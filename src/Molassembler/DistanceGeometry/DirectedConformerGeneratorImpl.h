@@ -38,6 +38,16 @@ public:
 
   DecisionList generateNewDecisionList(Random::Engine& engine);
 
+  /*! @brief Decodes a decision list from its index in the mixed-radix product
+   *   of the bounds
+   *
+   * The first decision is the most significant digit, so decision lists are
+   * ordered lexicographically by index.
+   *
+   * @complexity{@math{\Theta(B)} where @math{B} is the number of bonds}
+   */
+  DecisionList decisionListFromIndex(unsigned index) const;
+
   bool insert(const DecisionList& decisionList) {
     return decisionLists_.insert(decisionList);
   }
@@ -8,6 +8,7 @@
 
 #include "Molassembler/DistanceGeometry/Error.h"
 #include "Molassembler/Options.h"
+#include "Molassembler/Profiling.h"
 
 #include "Molassembler/Temple/Random.h"
 
@@ -17,6 +18,47 @@
 namespace Scine {
 namespace Molassembler {
 namespace DistanceGeometry {
+namespace {
+
+//! Edge length of square tiles in blocked triangle smoothing
+constexpr unsigned smoothingBlockSize = 64;
+
+/* Floyd-Warshall pivot updates for pivots [kBegin, kEnd) of the tile spanning
+ * rows [iBegin, iEnd) and columns [jBegin, jEnd) of symmetric upper and lower
+ * bound matrices
+ */
+void smoothTile(
+  Eigen::MatrixXd& upper,
+  Eigen::MatrixXd& lower,
+  const unsigned iBegin,
+  const unsigned iEnd,
+  const unsigned jBegin,
+  const unsigned jEnd,
+  const unsigned kBegin,
+  const unsigned kEnd
+) {
+  for(unsigned k = kBegin; k < kEnd; ++k) {
+    const double* const upperK = upper.col(k).data();
+    const double* const lowerK = lower.col(k).data();
+
+    for(unsigned j = jBegin; j < jEnd; ++j) {
+      const double upperKJ = upper(k, j);
+      const double lowerKJ = lower(k, j);
+      double* const upperJ = upper.col(j).data();
+      double* const lowerJ = lower.col(j).data();
+
+      for(unsigned i = iBegin; i < iEnd; ++i) {
+        upperJ[i] = std::min(upperJ[i], upperK[i] + upperKJ);
+        lowerJ[i] = std::max(
+          lowerJ[i],
+          std::max(lowerK[i] - upperKJ, lowerKJ - upperK[i])
+        );
+      }
+    }
+  }
+}
+
+} // namespace
 
 constexpr double DistanceBoundsMatrix::defaultLower;
 constexpr double DistanceBoundsMatrix::defaultUpper;
@@ -56,54 +98,95 @@ bool DistanceBoundsMatrix::setLowerBound(const AtomIndex i, const AtomIndex j, c
 }
 
 void DistanceBoundsMatrix::smooth(Eigen::Ref<Eigen::MatrixXd> matrix) {
+  MOLASSEMBLER_PROFILE_SCOPE("DistanceBoundsMatrix.smooth");
+
   /* Floyd's algorithm: O(N³) */
   const unsigned N = matrix.cols();
+  if(N < 2) {
+    return;
+  }
+
+  /* Split into symmetric upper and lower bound matrices so that the pivot
+   * updates are branch-free and contiguous along columns
+   */
+  Eigen::MatrixXd upper(N, N);
+  Eigen::MatrixXd lower(N, N);
+  for(unsigned j = 0; j < N; ++j) {
+    for(unsigned i = 0; i < j; ++i) {
+      upper(i, j) = matrix(i, j);
+      lower(i, j) = matrix(j, i);
+    }
+    upper(j, j) = 0.0;
+    lower(j, j) = 0.0;
+    for(unsigned i = j + 1; i < N; ++i) {
+      upper(i, j) = matrix(j, i);
+      lower(i, j) = matrix(i, j);
+    }
+  }
 
-  for(AtomIndex k = 0; k < N; ++k) {
-    for(AtomIndex i = 0; i < N - 1; ++i) {
-      /* Single-branch references to lower and upper ik parts */
-      auto upperLowerIK = (i < k
-        ? std::pair<double&, double&>(matrix(i, k), matrix(k, i))
-        : std::pair<double&, double&>(matrix(k, i), matrix(i, k))
+  const unsigned blocks = (N + smoothingBlockSize - 1) / smoothingBlockSize;
+  auto blockBegin = [](const unsigned block) -> unsigned {
+    return block * smoothingBlockSize;
+  };
+  auto blockEnd = [N](const unsigned block) -> unsigned {
+    return std::min(N, (block + 1) * smoothingBlockSize);
+  };
+
+  for(unsigned kBlock = 0; kBlock < blocks; ++kBlock) {
+    const unsigned kBegin = blockBegin(kBlock);
+    const unsigned kEnd = blockEnd(kBlock);
+
+    // Pivot tile depends only on itself
+    smoothTile(upper, lower, kBegin, kEnd, kBegin, kEnd, kBegin, kEnd);
+
+    // Pivot row and column tiles depend on themselves and the pivot tile
+#pragma omp parallel for schedule(static) if(blocks > 2)
+    for(unsigned t = 0; t < 2 * blocks; ++t) {
+      const unsigned block = t / 2;
+      if(block == kBlock) {
+        continue;
+      }
+
+      if(t % 2 == 0) {
+        smoothTile(upper, lower, kBegin, kEnd, blockBegin(block), blockEnd(block), kBegin, kEnd);
+      } else {
+        smoothTile(upper, lower, blockBegin(block), blockEnd(block), kBegin, kEnd, kBegin, kEnd);
+      }
+    }
+
+    // All other tiles depend only on the pivot row and column tiles
+#pragma omp parallel for schedule(static) if(blocks > 2)
+    for(unsigned t = 0; t < blocks * blocks; ++t) {
+      const unsigned iBlock = t % blocks;
+      const unsigned jBlock = t / blocks;
+      if(iBlock == kBlock || jBlock == kBlock) {
+        continue;
+      }
+
+      smoothTile(
+        upper,
+        lower,
+        blockBegin(iBlock),
+        blockEnd(iBlock),
+        blockBegin(jBlock),
+        blockEnd(jBlock),
+        kBegin,
+        kEnd
       );
-      double& upperIK = upperLowerIK.first;
-      double& lowerIK = upperLowerIK.second;
+    }
+  }
 
-      if(lowerIK > upperIK) {
+  /* Lower bounds only ever rise and upper bounds only ever fall, so any
+   * inversion encountered along the way persists until here
+   */
+  for(unsigned j = 0; j < N; ++j) {
+    for(unsigned i = 0; i < j; ++i) {
+      if(lower(i, j) > upper(i, j)) {
         throw std::runtime_error("Triangle smoothing encountered bound inversion");
       }
 
-      for(AtomIndex j = i + 1; j < N; ++j) {
-        /* i < j is known, so lower(matrix, i, j) is always matrix(j, i),
-         * and upper(matrix, i, j) always matrix(i, j)
-         */
-        double& upperIJ = matrix(i, j);
-        double& lowerIJ = matrix(j, i);
-
-        /* Single-branch references to lower and upper jk parts */
-        auto upperLowerJK = (j < k
-          ? std::pair<double&, double&>(matrix(j, k), matrix(k, j))
-          : std::pair<double&, double&>(matrix(k, j), matrix(j, k))
-        );
-        double& upperJK = upperLowerJK.first;
-        double& lowerJK = upperLowerJK.second;
-
-        /* Actual algorithm */
-        if(upperIJ > upperIK + upperJK) {
-          upperIJ = upperIK + upperJK;
-        }
-
-        if(lowerIJ < lowerIK - upperJK) {
-          lowerIJ = lowerIK - upperJK;
-        } else if(lowerIJ < lowerJK - upperIK) {
-          lowerIJ = lowerJK - upperIK;
-        }
-
-        // Safety
-        if(lowerIJ > upperIJ) {
-          throw std::runtime_error("Triangle smoothing encountered bound inversion");
-        }
-      }
+      matrix(i, j) = upper(i, j);
+      matrix(j, i) = lower(i, j);
     }
   }
 }
@@ -132,6 +215,8 @@ const Eigen::MatrixXd& DistanceBoundsMatrix::access() const {
 }
 
 outcome::result<Eigen::MatrixXd> DistanceBoundsMatrix::makeDistanceMatrix(Random::Engine& engine, Partiality partiality) const noexcept {
+  MOLASSEMBLER_PROFILE_SCOPE("DistanceBoundsMatrix.makeDistanceMatrix");
+
   auto matrixCopy = matrix_;
 
   const unsigned N = matrix_.cols();
@@ -49,8 +49,15 @@ public:
   }
 
   /*! @brief Uses Floyd's algorithm to smooth the matrix
+   *
+   * Upper and lower bounds are split into separate symmetric matrices and
+   * smoothed in tiles by a blocked Floyd-Warshall variant. The independent
+   * tiles of each pivot block are processed in parallel.
    *
    * @complexity{@math{\Theta(N^3)}}
+   *
+   * @throws std::runtime_error If smoothing yields a lower bound greater than
+   *   the corresponding upper bound
    */
   static void smooth(Eigen::Ref<Eigen::MatrixXd> matrix);
 //!@}
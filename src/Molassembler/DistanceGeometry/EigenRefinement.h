@@ -10,6 +10,10 @@
 
 #include <Eigen/Dense>
 
+#include <algorithm>
+#include <exception>
+#include <numeric>
+
 #include "Molassembler/DistanceGeometry/DistanceBoundsMatrix.h"
 
 namespace Scine {
@@ -173,6 +177,15 @@ public:
   bool compressFourthDimension = false;
   //! Whether to enable dihedral terms
   bool dihedralTerms = false;
+  /*! @brief Number of chunks to split distance terms into
+   *
+   * With more than one chunk, the distance terms are split by rows into this
+   * many chunks of similar size. These, the chiral terms and the dihedral
+   * terms are evaluated in parallel into separate error and gradient
+   * accumulators, which are then summed in a fixed order. Results depend on
+   * the number of chunks, but not on the number of threads.
+   */
+  unsigned parallelChunks = 1;
 //!@}
 
 //!@name Signaling members
@@ -221,6 +234,173 @@ public:
       dihedralConstraintSumsHalved(i) = (constraint.upper + constraint.lower) / 2;
       dihedralConstraintDiffsHalved(i) = (constraint.upper - constraint.lower) / 2;
     }
+
+    // All constraints are active until atoms are fixed
+    activeChiralConstraints_.resize(C);
+    std::iota(std::begin(activeChiralConstraints_), std::end(activeChiralConstraints_), 0);
+    activeDihedralConstraints_.resize(D);
+    std::iota(std::begin(activeDihedralConstraints_), std::end(activeDihedralConstraints_), 0);
+  }
+//!@}
+
+//!@name Fixed atoms
+//!@{
+  /*! @brief Removes atoms from the refinement variables
+   *
+   * Afterwards, the parameters of the call operator are the linearized
+   * positions of the free atoms only, in order of increasing atom index.
+   * Fixed atoms are constants at their positions in @p positions. Terms
+   * involving only fixed atoms are evaluated once here, so that each
+   * evaluation scales with the number of free atoms.
+   *
+   * @complexity{@math{\Theta(N + K^2 + C + D)} for @math{K} fixed atoms}
+   *
+   * @param fixedAtoms Indices of atoms to fix. If empty, all atoms are free
+   *   again.
+   * @param positions Linearized positions of all atoms
+   */
+  void fixAtoms(
+    const std::vector<AtomIndex>& fixedAtoms,
+    const VectorType& positions
+  ) {
+    // Distance chunks are split by free atoms
+    taskGradients_.clear();
+
+    if(fixedAtoms.empty()) {
+      isFixed_.clear();
+      freeAtoms_.clear();
+      activeChiralConstraints_.resize(chiralConstraints.size());
+      std::iota(std::begin(activeChiralConstraints_), std::end(activeChiralConstraints_), 0);
+      activeDihedralConstraints_.resize(dihedralConstraints.size());
+      std::iota(std::begin(activeDihedralConstraints_), std::end(activeDihedralConstraints_), 0);
+      return;
+    }
+
+    const unsigned N = positions.size() / dimensionality;
+    assert(static_cast<unsigned>(upperDistanceBoundsSquared.size()) == N * (N - 1) / 2);
+
+    isFixed_.assign(N, false);
+    for(const AtomIndex i : fixedAtoms) {
+      isFixed_.at(i) = true;
+    }
+
+    freeAtoms_.clear();
+    std::vector<AtomIndex> sortedFixedAtoms;
+    for(unsigned i = 0; i < N; ++i) {
+      if(isFixed_[i]) {
+        sortedFixedAtoms.push_back(i);
+      } else {
+        freeAtoms_.push_back(i);
+      }
+    }
+
+    fixedPositions_ = positions;
+
+    // Precompute distance terms between fixed atoms
+    VectorType dummyGradient = VectorType::Zero(positions.size());
+    fixedError_ = 0;
+    const unsigned K = sortedFixedAtoms.size();
+    for(unsigned a = 0; a < K; ++a) {
+      const AtomIndex i = sortedFixedAtoms[a];
+      for(unsigned b = a + 1; b < K; ++b) {
+        const AtomIndex j = sortedFixedAtoms[b];
+        distancePairContribution(
+          positions,
+          fixedError_,
+          dummyGradient,
+          DefaultTermVisitor {},
+          i,
+          j,
+          rowLinearOffset(N, i) + j - i - 1
+        );
+      }
+    }
+
+    const auto involvesOnlyFixedAtoms = [&](const auto& constraint) -> bool {
+      return std::all_of(
+        std::begin(constraint.sites),
+        std::end(constraint.sites),
+        [&](const auto& site) -> bool {
+          return std::all_of(
+            std::begin(site),
+            std::end(site),
+            [&](const AtomIndex i) -> bool { return isFixed_.at(i); }
+          );
+        }
+      );
+    };
+
+    // Partition constraints into active ones and precomputed ones
+    std::vector<unsigned> fixedChiralConstraints;
+    activeChiralConstraints_.clear();
+    for(unsigned c = 0; c < chiralConstraints.size(); ++c) {
+      if(involvesOnlyFixedAtoms(chiralConstraints[c])) {
+        fixedChiralConstraints.push_back(c);
+      } else {
+        activeChiralConstraints_.push_back(c);
+      }
+    }
+
+    std::vector<unsigned> fixedDihedralConstraints;
+    activeDihedralConstraints_.clear();
+    for(unsigned d = 0; d < dihedralConstraints.size(); ++d) {
+      if(involvesOnlyFixedAtoms(dihedralConstraints[d])) {
+        fixedDihedralConstraints.push_back(d);
+      } else {
+        activeDihedralConstraints_.push_back(d);
+      }
+    }
+
+    /* The chiral contributions overwrite the signaling member, so preserve
+     * it. Dihedral terms may be disabled at the time of an evaluation, so
+     * their constant is kept separately.
+     */
+    const double proportionCorrect = proportionChiralConstraintsCorrectSign;
+    chiralContributionsImpl(positions, fixedError_, dummyGradient, DefaultTermVisitor {}, fixedChiralConstraints);
+    proportionChiralConstraintsCorrectSign = proportionCorrect;
+
+    fixedDihedralError_ = 0;
+    dihedralContributionsImpl(positions, fixedDihedralError_, dummyGradient, DefaultTermVisitor {}, fixedDihedralConstraints);
+  }
+
+  //! Whether any atoms are fixed
+  bool hasFixedAtoms() const {
+    return !isFixed_.empty();
+  }
+
+  /*! @brief Extracts the refinement variables from linearized positions
+   *
+   * @complexity{@math{\Theta(F)} for @math{F} free atoms}
+   */
+  VectorType reduce(const VectorType& positions) const {
+    if(!hasFixedAtoms()) {
+      return positions;
+    }
+
+    const unsigned F = freeAtoms_.size();
+    VectorType parameters(dimensionality * F);
+    for(unsigned f = 0; f < F; ++f) {
+      parameters.template segment<dimensionality>(dimensionality * f) = positions.template segment<dimensionality>(dimensionality * freeAtoms_[f]);
+    }
+    return parameters;
+  }
+
+  /*! @brief Expands refinement variables into linearized positions of all atoms
+   *
+   * @complexity{@math{\Theta(N)}}
+   */
+  VectorType expand(const VectorType& parameters) const {
+    if(!hasFixedAtoms()) {
+      return parameters;
+    }
+
+    assert(static_cast<unsigned>(parameters.size()) == dimensionality * freeAtoms_.size());
+    VectorType positions = fixedPositions_;
+    const unsigned F = freeAtoms_.size();
+    for(unsigned f = 0; f < F; ++f) {
+      positions.template segment<dimensionality>(dimensionality * freeAtoms_[f]) = parameters.template segment<dimensionality>(dimensionality * f);
+    }
+    return positions;
   }
 //!@}
 
@@ -236,7 +416,8 @@ public:
     Eigen::Ref<VectorType> gradient
   ) const {
     // Delegate to SIMD or non-SIMD implementation
-    distanceContributionsImpl(positions, error, gradient, DefaultTermVisitor {});
+    const unsigned N = positions.size() / dimensionality;
+    distanceContributionsImpl(positions, error, gradient, DefaultTermVisitor {}, 0, N);
   }
 
   /*! @brief Adds chiral error and gradient contributions
@@ -248,7 +429,7 @@ public:
     FloatType& error,
     Eigen::Ref<VectorType> gradient
   ) const {
-    chiralContributionsImpl(positions, error, gradient, DefaultTermVisitor {});
+    chiralContributionsImpl(positions, error, gradient, DefaultTermVisitor {}, activeChiralConstraints_);
   }
 
   /*! @brief Adds dihedral error and gradient contributions
@@ -261,7 +442,7 @@ public:
     Eigen::Ref<VectorType> gradient
   ) const {
     if(dihedralTerms) {
-      dihedralContributionsImpl(positions, error, gradient, DefaultTermVisitor {});
+      dihedralContributionsImpl(positions, error, gradient, DefaultTermVisitor {}, activeDihedralConstraints_);
     }
   }
 
@@ -289,12 +470,119 @@ public:
     value = 0;
     gradient.setZero();
 
+    if(hasFixedAtoms()) {
+      fixedAtomContributions(parameters, value, gradient);
+      return;
+    }
+
+    if(parallelChunks > 1) {
+      parallelContributions(parameters, value, gradient);
+      return;
+    }
+
     fourthDimensionContributions(parameters, value, gradient);
     dihedralContributions(parameters, value, gradient);
     distanceContributions(parameters, value, gradient);
     chiralContributions(parameters, value, gradient);
   }
 
+  /*! @brief Calculates all contributions with fixed atoms
+   *
+   * @see fixAtoms
+   *
+   * @complexity{@math{\Theta(F N)} for @math{F} free atoms}
+   */
+  void fixedAtomContributions(
+    const VectorType& parameters,
+    FloatType& value,
+    Eigen::Ref<VectorType> gradient
+  ) const {
+    const VectorType positions = expand(parameters);
+    VectorType positionsGradient = VectorType::Zero(positions.size());
+
+    value = fixedError_;
+    if(dihedralTerms) {
+      value += fixedDihedralError_;
+    }
+
+    if(parallelChunks > 1) {
+      parallelContributions(positions, value, positionsGradient);
+    } else {
+      fourthDimensionContributions(positions, value, positionsGradient);
+      dihedralContributions(positions, value, positionsGradient);
+      distanceContributionsRange(positions, value, positionsGradient, 0, freeAtoms_.size());
+      chiralContributions(positions, value, positionsGradient);
+    }
+
+    gradient = reduce(positionsGradient);
+  }
+
+  /*! @brief Calculates all contributions in parallel chunks
+   *
+   * Accumulators of the parallel tasks are allocated on first use and kept,
+   * so concurrent evaluations of the same instance are not thread-safe.
+   *
+   * @see parallelChunks
+   *
+   * @complexity{@math{\Theta(N^2 / T)} for @math{T} threads, plus
+   * @math{\Theta(K N)} for the reduction of @math{K} chunks}
+   */
+  void parallelContributions(
+    const VectorType& parameters,
+    FloatType& value,
+    Eigen::Ref<VectorType> gradient
+  ) const {
+    const unsigned N = parameters.size() / dimensionality;
+    const unsigned K = std::max(parallelChunks, 1u);
+    // Distance chunks, then chiral and dihedral terms as one task each
+    const unsigned tasks = K + 2;
+
+    if(
+      taskGradients_.size() != tasks
+      || taskGradients_.front().size() != parameters.size()
+    ) {
+      prepareParallelTasks_(N, K, parameters.size());
+    }
+
+    std::vector<std::exception_ptr> exceptions(tasks);
+
+#pragma omp parallel for schedule(dynamic)
+    for(unsigned task = 0; task < tasks; ++task) {
+      try {
+        taskErrors_[task] = 0;
+        taskGradients_[task].setZero();
+        if(task < K) {
+          distanceContributionsRange(
+            parameters,
+            taskErrors_[task],
+            taskGradients_[task],
+            chunkRowSeparators_[task],
+            chunkRowSeparators_[task + 1]
+          );
+        } else if(task == K) {
+          chiralContributions(parameters, taskErrors_[task], taskGradients_[task]);
+        } else {
+          dihedralContributions(parameters, taskErrors_[task], taskGradients_[task]);
+        }
+      } catch(...) {
+        exceptions[task] = std::current_exception();
+      }
+    }
+
+    for(const auto& exceptionPtr : exceptions) {
+      if(exceptionPtr) {
+        std::rethrow_exception(exceptionPtr);
+      }
+    }
+
+    // Reduce in fixed order
+    fourthDimensionContributions(parameters, value, gradient);
+    for(unsigned task = 0; task < tasks; ++task) {
+      value += taskErrors_[task];
+      gradient += taskGradients_[task];
+    }
+  }
+
   /*! @brief Calculates the number of chiral constraints with correct sign
    *
    * @complexity{@math{\Theta(C)} where @math{C} is the number of chiral
@@ -354,9 +642,9 @@ public:
     dummyGradient.setZero();
 
     fourthDimensionContributionsImpl(positions, dummyValue, dummyGradient, visitor);
-    dihedralContributionsImpl(positions, dummyValue, dummyGradient, visitor);
-    distanceContributionsImpl(positions, dummyValue, dummyGradient, visitor);
-    chiralContributionsImpl(positions, dummyValue, dummyGradient, visitor);
+    dihedralContributionsImpl(positions, dummyValue, dummyGradient, visitor, activeDihedralConstraints_);
+    distanceContributionsImpl(positions, dummyValue, dummyGradient, visitor, 0, positions.size() / dimensionality);
+    chiralContributionsImpl(positions, dummyValue, dummyGradient, visitor, activeChiralConstraints_);
   }
 
   /**
@@ -478,71 +766,196 @@ public:
   }
 
 private:
+//!@name Fixed atom state
+//!@{
+  //! Per atom, whether it is fixed. Empty if no atoms are fixed
+  std::vector<bool> isFixed_;
+  //! Indices of atoms that are not fixed, in increasing order
+  std::vector<AtomIndex> freeAtoms_;
+  //! Linearized positions of all atoms, including the fixed atoms
+  VectorType fixedPositions_;
+  //! Error of distance and chiral terms between fixed atoms only
+  FloatType fixedError_ = 0;
+  //! Error of dihedral terms between fixed atoms only
+  FloatType fixedDihedralError_ = 0;
+  //! Indices of chiral constraints involving free atoms
+  std::vector<unsigned> activeChiralConstraints_;
+  //! Indices of dihedral constraints involving free atoms
+  std::vector<unsigned> activeDihedralConstraints_;
+//!@}
+
+//!@name Parallel evaluation state
+//!@{
+  //! Row ranges of the distance chunks, delimited by consecutive entries
+  mutable std::vector<unsigned> chunkRowSeparators_;
+  //! Error accumulators of the parallel tasks
+  mutable std::vector<FloatType> taskErrors_;
+  //! Gradient accumulators of the parallel tasks
+  mutable std::vector<VectorType> taskGradients_;
+//!@}
+
 //!@name Contribution implementations
 //!@{
-  /*!
-   * @brief Adds distance error and gradient contributions (non-SIMD)
+  /*! @brief Splits distance terms into chunks and allocates task accumulators
+   *
+   * Splits the distance terms by row so that each chunk covers roughly the
+   * same number of atom pairs. Row i has N - i - 1 pairs. With fixed atoms,
+   * rows are free atoms, each of which has about N pairs.
    */
-  template<class Visitor, bool dependent = SIMD, std::enable_if_t<!dependent, int>...>
-  void distanceContributionsImpl(
+  void prepareParallelTasks_(
+    const unsigned N,
+    const unsigned K,
+    const Eigen::Index parameterCount
+  ) const {
+    chunkRowSeparators_.assign(K + 1, N);
+    chunkRowSeparators_.front() = 0;
+    if(hasFixedAtoms()) {
+      const unsigned F = freeAtoms_.size();
+      for(unsigned chunk = 1; chunk <= K; ++chunk) {
+        chunkRowSeparators_.at(chunk) = chunk * F / K;
+      }
+    } else {
+      const double pairsPerChunk = static_cast<double>(N) * (N - 1) / 2 / K;
+      double pairs = 0;
+      unsigned chunk = 1;
+      for(unsigned i = 0; i < N && chunk < K; ++i) {
+        pairs += N - i - 1;
+        if(pairs >= chunk * pairsPerChunk) {
+          chunkRowSeparators_.at(chunk) = i + 1;
+          ++chunk;
+        }
+      }
+    }
+
+    const unsigned tasks = K + 2;
+    taskErrors_.assign(tasks, 0);
+    taskGradients_.assign(tasks, VectorType::Zero(parameterCount));
+  }
+
+  //! Index of the first pair of row @p i in the linearized strict upper triangle
+  static unsigned rowLinearOffset(const unsigned N, const unsigned i) {
+    return i * (2 * N - i - 1) / 2;
+  }
+
+  /*! @brief Adds distance contributions of a range of rows
+   *
+   * Without fixed atoms, rows are atoms and each covers its pairs with atoms
+   * of higher index. With fixed atoms, rows are free atoms and each covers
+   * its pairs with fixed atoms and free atoms of higher index.
+   */
+  void distanceContributionsRange(
     const VectorType& positions,
     FloatType& error,
     Eigen::Ref<VectorType> gradient,
-    Visitor&& visitor
+    const unsigned rowBegin,
+    const unsigned rowEnd
   ) const {
-    assert(positions.size() == gradient.size());
+    if(!hasFixedAtoms()) {
+      distanceContributionsImpl(positions, error, gradient, DefaultTermVisitor {}, rowBegin, rowEnd);
+      return;
+    }
+
     const unsigned N = positions.size() / dimensionality;
+    for(unsigned f = rowBegin; f < rowEnd; ++f) {
+      const AtomIndex i = freeAtoms_[f];
+      for(AtomIndex j = 0; j < i; ++j) {
+        if(isFixed_[j]) {
+          distancePairContribution(positions, error, gradient, DefaultTermVisitor {}, j, i, rowLinearOffset(N, j) + i - j - 1);
+        }
+      }
 
-    for(unsigned linearIndex = 0, i = 0; i < N - 1; ++i) {
-      for(unsigned j = i + 1; j < N; ++j, ++linearIndex) {
-        const FloatType lowerBoundSquared = lowerDistanceBoundsSquared(linearIndex);
-        const FloatType upperBoundSquared = upperDistanceBoundsSquared(linearIndex);
-        assert(lowerBoundSquared <= upperBoundSquared);
-
-        // For both
-        const FullDimensionalVector positionDifference = (
-          positions.template segment<dimensionality>(dimensionality * i)
-          - positions.template segment<dimensionality>(dimensionality * j)
-        );
+      const unsigned rowOffset = rowLinearOffset(N, i);
+      for(AtomIndex j = i + 1; j < N; ++j) {
+        distancePairContribution(positions, error, gradient, DefaultTermVisitor {}, i, j, rowOffset + j - i - 1);
+      }
+    }
+  }
+
+  /*! @brief Adds the distance error and gradient contribution of a single pair
+   *
+   * @pre i < j
+   */
+  template<class Visitor>
+  void distancePairContribution(
+    const VectorType& positions,
+    FloatType& error,
+    Eigen::Ref<VectorType> gradient,
+    Visitor&& visitor,
+    const unsigned i,
+    const unsigned j,
+    const unsigned linearIndex
+  ) const {
+    const FloatType lowerBoundSquared = lowerDistanceBoundsSquared(linearIndex);
+    const FloatType upperBoundSquared = upperDistanceBoundsSquared(linearIndex);
+    assert(lowerBoundSquared <= upperBoundSquared);
 
-        const FloatType squareDistance = positionDifference.squaredNorm();
+    // For both
+    const FullDimensionalVector positionDifference = (
+      positions.template segment<dimensionality>(dimensionality * i)
+      - positions.template segment<dimensionality>(dimensionality * j)
+    );
 
-        // Upper term
-        const FloatType upperTerm = squareDistance / upperBoundSquared - 1;
+    const FloatType squareDistance = positionDifference.squaredNorm();
 
-        if(upperTerm > 0) {
-          const FloatType value = upperTerm * upperTerm;
-          error += value;
-          visitor.distanceTerm(i, j, value);
+    // Upper term
+    const FloatType upperTerm = squareDistance / upperBoundSquared - 1;
 
-          const FullDimensionalVector f = 4 * positionDifference * upperTerm / upperBoundSquared;
+    if(upperTerm > 0) {
+      const FloatType value = upperTerm * upperTerm;
+      error += value;
+      visitor.distanceTerm(i, j, value);
 
-          gradient.template segment<dimensionality>(dimensionality * i) += f;
-          gradient.template segment<dimensionality>(dimensionality * j) -= f;
-        } else {
-          // Lower term is only possible if the upper term does not contribute
-          const FloatType quotient = lowerBoundSquared + squareDistance;
-          const FloatType lowerTerm = 2 * lowerBoundSquared / quotient - 1;
+      const FullDimensionalVector f = 4 * positionDifference * upperTerm / upperBoundSquared;
 
-          if(lowerTerm > 0) {
-            const FloatType value = lowerTerm * lowerTerm;
-            error += value;
-            visitor.distanceTerm(i, j, value);
+      gradient.template segment<dimensionality>(dimensionality * i) += f;
+      gradient.template segment<dimensionality>(dimensionality * j) -= f;
+    } else {
+      // Lower term is only possible if the upper term does not contribute
+      const FloatType quotient = lowerBoundSquared + squareDistance;
+      const FloatType lowerTerm = 2 * lowerBoundSquared / quotient - 1;
 
-            const FullDimensionalVector g = 8 * lowerBoundSquared * positionDifference * lowerTerm / (
-              quotient * quotient
-            );
+      if(lowerTerm > 0) {
+        const FloatType value = lowerTerm * lowerTerm;
+        error += value;
+        visitor.distanceTerm(i, j, value);
 
-            /* We use -= because the lower term needs the position vector
-             * difference (j - i), so we reuse positionDifference and just subtract
-             * from the gradient instead of adding to it
-             */
-            gradient.template segment<dimensionality>(dimensionality * i) -= g;
-            gradient.template segment<dimensionality>(dimensionality * j) += g;
-          } else {
-            visitor.distanceTerm(i, j, 0.0);
-          }
-        }
+        const FullDimensionalVector g = 8 * lowerBoundSquared * positionDifference * lowerTerm / (
+          quotient * quotient
+        );
+
+        /* We use -= because the lower term needs the position vector
+         * difference (j - i), so we reuse positionDifference and just subtract
+         * from the gradient instead of adding to it
+         */
+        gradient.template segment<dimensionality>(dimensionality * i) -= g;
+        gradient.template segment<dimensionality>(dimensionality * j) += g;
+      } else {
+        visitor.distanceTerm(i, j, 0.0);
+      }
+    }
+  }
+
+  /*!
+   * @brief Adds distance error and gradient contributions (non-SIMD)
+   *
+   * Covers pairs i < j with i in [@p iBegin, @p iEnd)
+   */
+  template<class Visitor, bool dependent = SIMD, std::enable_if_t<!dependent, int>...>
+  void distanceContributionsImpl(
+    const VectorType& positions,
+    FloatType& error,
+    Eigen::Ref<VectorType> gradient,
+    Visitor&& visitor,
+    const unsigned iBegin,
+    const unsigned iEnd
+  ) const {
+    assert(positions.size() == gradient.size());
+    const unsigned N = positions.size() / dimensionality;
+    assert(iBegin <= iEnd && iEnd <= N);
+
+    for(unsigned linearIndex = rowLinearOffset(N, iBegin), i = iBegin; i < iEnd; ++i) {
+      for(unsigned j = i + 1; j < N; ++j, ++linearIndex) {
+        distancePairContribution(positions, error, gradient, visitor, i, j, linearIndex);
       }
     }
   }
@@ -555,7 +968,9 @@ private:
     const VectorType& positions,
     FloatType& error,
     Eigen::Ref<VectorType> gradient,
-    Visitor&& /* visitor */
+    Visitor&& /* visitor */,
+    const unsigned iBegin,
+    const unsigned iEnd
   ) const {
     assert(positions.size() == gradient.size());
     /* Using the squared distance bounds to avoid unneeded square-root calculations
@@ -591,14 +1006,16 @@ private:
      *
      */
 
-    // Calculate all full-dimensional N(N-1) / 2 position differences
+    // Calculate all full-dimensional position differences of the rows
     const unsigned N = positions.size() / dimensionality;
-    const unsigned differencesCount = N * (N - 1) / 2;
+    assert(iBegin <= iEnd && iEnd <= N);
+    const unsigned linearBegin = rowLinearOffset(N, iBegin);
+    const unsigned differencesCount = rowLinearOffset(N, iEnd) - linearBegin;
 
     FullDimensionalMatrixType positionDifferences(dimensionality, differencesCount);
     {
       unsigned offset = 0;
-      for(unsigned i = 0; i < N - 1; ++i) {
+      for(unsigned i = iBegin; i < iEnd; ++i) {
         auto iPosition = positions.template segment<dimensionality>(dimensionality * i);
         for(unsigned j = i + 1; j < N; ++j) {
           positionDifferences.col(offset) = (
@@ -614,13 +1031,15 @@ private:
     const VectorType squareDistances = positionDifferences.colwise().squaredNorm();
 
     // SIMD
-    const VectorType upperTerms = squareDistances.array() / upperDistanceBoundsSquared.array() - 1;
+    const auto upperBoundsSquared = upperDistanceBoundsSquared.segment(linearBegin, differencesCount);
+    const auto lowerBoundsSquared = lowerDistanceBoundsSquared.segment(linearBegin, differencesCount);
+    const VectorType upperTerms = squareDistances.array() / upperBoundsSquared.array() - 1;
 
 #ifndef NDEBUG
     {
       // Check correctness of results so far
       unsigned offset = 0;
-      for(unsigned i = 0; i < N - 1; ++i) {
+      for(unsigned i = iBegin; i < iEnd; ++i) {
         for(unsigned j = i + 1; j < N; ++j) {
           const FullDimensionalVector positionDifference = (
             positions.template segment<dimensionality>(dimensionality * i)
@@ -634,7 +1053,7 @@ private:
           assert(squareDistance == squareDistances(offset));
 
           // Upper term
-          const FloatType upperTerm = squareDistance / upperDistanceBoundsSquared(offset) - 1;
+          const FloatType upperTerm = squareDistance / upperBoundsSquared(offset) - 1;
 
           assert(upperTerm == upperTerms(offset));
 
@@ -645,7 +1064,7 @@ private:
 #endif
 
     // Traverse upper terms and calculate gradients
-    for(unsigned iOffset = 0, i = 0; i < N - 1; ++i) {
+    for(unsigned iOffset = 0, i = iBegin; i < iEnd; ++i) {
       const unsigned crossTerms = N - i - 1;
       for(unsigned jOffset = 0, j = i + 1;  j < N; ++j, ++jOffset) {
         const FloatType upperTerm = upperTerms(iOffset + jOffset);
@@ -658,7 +1077,7 @@ private:
            */
           const FullDimensionalVector f = (
             4 * positionDifferences.col(iOffset + jOffset) * upperTerm
-            / upperDistanceBoundsSquared(iOffset + jOffset)
+            / upperBoundsSquared(iOffset + jOffset)
           );
 
           // position difference is i - j, not j - i (!)
@@ -667,7 +1086,7 @@ private:
         } else {
           /* This i-j combination MAYBE has a lower value contribution
            */
-          const auto& lowerBoundSquared = lowerDistanceBoundsSquared(iOffset + jOffset);
+          const auto& lowerBoundSquared = lowerBoundsSquared(iOffset + jOffset);
           const FloatType quotient = lowerBoundSquared + squareDistances(iOffset + jOffset);
           const FloatType lowerTerm = 2 * lowerBoundSquared / quotient - 1;
 
@@ -701,12 +1120,14 @@ private:
     const VectorType& positions,
     FloatType& error,
     Eigen::Ref<VectorType> gradient,
-    Visitor&& visitor
+    Visitor&& visitor,
+    const std::vector<unsigned>& constraintIndices
   ) const {
     unsigned nonZeroChiralConstraints = 0;
     unsigned incorrectNonZeroChiralConstraints = 0;
 
-    for(const auto& constraint : chiralConstraints) {
+    for(const unsigned constraintIndex : constraintIndices) {
+      const ChiralConstraint& constraint = chiralConstraints[constraintIndex];
       const ThreeDimensionalVector alpha = getAveragePosition3D(positions, constraint.sites[0]);
       const ThreeDimensionalVector beta = getAveragePosition3D(positions, constraint.sites[1]);
       const ThreeDimensionalVector gamma = getAveragePosition3D(positions, constraint.sites[2]);
@@ -817,12 +1238,14 @@ private:
     const VectorType& positions,
     FloatType& error,
     Eigen::Ref<VectorType> gradient,
-    Visitor&& visitor
+    Visitor&& visitor,
+    const std::vector<unsigned>& constraintIndices
   ) const {
     assert(positions.size() == gradient.size());
     constexpr FloatType reductionFactor = 1.0 / 10;
 
-    for(const DihedralConstraint& constraint : dihedralConstraints) {
+    for(const unsigned constraintIndex : constraintIndices) {
+      const DihedralConstraint& constraint = dihedralConstraints[constraintIndex];
       const ThreeDimensionalVector alpha = getAveragePosition3D(positions, constraint.sites[0]);
       const ThreeDimensionalVector beta = getAveragePosition3D(positions, constraint.sites[1]);
       const ThreeDimensionalVector gamma = getAveragePosition3D(positions, constraint.sites[2]);
@@ -0,0 +1,228 @@
+/*!@file
+ * @copyright This code is licensed under the 3-clause BSD license.
+ *   Copyright ETH Zurich, Laboratory of Physical Chemistry, Reiher Group.
+ *   See LICENSE.txt for details.
+ */
+
+#include "Molassembler/DistanceGeometry/EnsembleFilter.h"
+
+#include <Eigen/Eigenvalues>
+#include "Utils/Math/QuaternionFit.h"
+
+#include "Molassembler/Graph/Canonicalization.h"
+#include "Molassembler/Graph/PrivateGraph.h"
+#include "Molassembler/Graph.h"
+#include "Molassembler/Molecule.h"
+#include "Molassembler/Molecule/AtomEnvironmentHash.h"
+#include "Molassembler/Profiling.h"
+#include "Molassembler/Temple/Functional.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+namespace Scine {
+namespace Molassembler {
+namespace DistanceGeometry {
+
+std::vector<std::vector<AtomIndex>> EnsembleFilter::automorphisms(const Molecule& molecule) {
+  const PrivateGraph& inner = molecule.graph().inner();
+  return automorphismGenerators(
+    inner,
+    Hashes::generate(
+      inner,
+      molecule.stereopermutators(),
+      AtomEnvironmentComponents::All
+    )
+  );
+}
+
+EnsembleFilter::Descriptor EnsembleFilter::descriptor(const Eigen::MatrixXd& positions) {
+  assert(positions.cols() == 3);
+  const Eigen::MatrixXd centered = positions.rowwise() - positions.colwise().mean();
+  const Eigen::Matrix3d gram = centered.transpose() * centered;
+  const Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver(gram, Eigen::EigenvaluesOnly);
+  return (
+    solver.eigenvalues().cwiseMax(0.0).cwiseSqrt()
+    / std::sqrt(static_cast<double>(positions.rows()))
+  );
+}
+
+double EnsembleFilter::rmsd(
+  const Eigen::MatrixXd& reference,
+  const Eigen::MatrixXd& positions
+) {
+  assert(reference.rows() == positions.rows());
+  const Eigen::VectorXd weights = Eigen::VectorXd::Ones(positions.rows());
+  const Eigen::MatrixXd fitted = Utils::QuaternionFit(reference, positions, weights).getFittedData();
+  return std::sqrt((fitted - reference).rowwise().squaredNorm().mean());
+}
+
+double EnsembleFilter::rmsd(
+  const Eigen::MatrixXd& reference,
+  const Eigen::MatrixXd& positions,
+  const std::vector<std::vector<AtomIndex>>& generators
+) {
+  const AtomIndex N = positions.rows();
+  assert(reference.rows() == positions.rows());
+
+  // Descent steps are generators and their inverses
+  std::vector<std::vector<AtomIndex>> steps = generators;
+  for(const auto& generator : generators) {
+    assert(generator.size() == N);
+    std::vector<AtomIndex> inverse(N);
+    for(AtomIndex i = 0; i < N; ++i) {
+      inverse[generator[i]] = i;
+    }
+    steps.push_back(std::move(inverse));
+  }
+
+  /* Atom i of the relabeled positions is atom permutation[i] of the original
+   * positions. Since every accepted step strictly lowers the RMSD, no
+   * permutation is visited twice and the descent terminates.
+   */
+  std::vector<AtomIndex> permutation = Temple::iota<AtomIndex>(N);
+  std::vector<AtomIndex> trialPermutation(N);
+  Eigen::MatrixXd relabeled(N, 3);
+  double best = rmsd(reference, positions);
+  bool improved = true;
+  while(improved) {
+    improved = false;
+    for(const auto& step : steps) {
+      for(AtomIndex i = 0; i < N; ++i) {
+        trialPermutation[i] = permutation[step[i]];
+        relabeled.row(i) = positions.row(trialPermutation[i]);
+      }
+
+      const double trial = rmsd(reference, relabeled);
+      if(trial < best) {
+        best = trial;
+        std::swap(permutation, trialPermutation);
+        improved = true;
+      }
+    }
+  }
+
+  return best;
+}
+
+EnsembleFilter::EnsembleFilter(
+  const double threshold,
+  std::vector<std::vector<AtomIndex>> automorphisms
+) : threshold_(threshold),
+    automorphisms_(std::move(automorphisms))
+{
+  if(threshold_ <= 0) {
+    throw std::invalid_argument("Ensemble filter RMSD threshold must be positive");
+  }
+}
+
+bool EnsembleFilter::accept(const Eigen::MatrixXd& positions) {
+  MOLASSEMBLER_PROFILE_SCOPE("EnsembleFilter.accept");
+
+  auto candidate = std::make_shared<Entry>(Entry {positions, descriptor(positions)});
+  const Cell candidateCell = cell_(candidate->descriptor);
+
+  /* Collect comparands under the lock, but calculate RMSDs outside of it.
+   * Since entries are only ever appended, only the entries accepted in the
+   * meantime need to be compared against before inserting the candidate.
+   */
+  unsigned compared = 0;
+  while(true) {
+    std::vector<std::shared_ptr<const Entry>> comparands;
+    bool inserted = false;
+#pragma omp critical(ensembleFilterAccess)
+    {
+      if(accepted_.size() == compared) {
+        grid_[candidateCell].push_back(accepted_.size());
+        accepted_.push_back(std::move(candidate));
+        inserted = true;
+      } else {
+        comparands = comparands_(*candidate, candidateCell, compared);
+        compared = accepted_.size();
+      }
+    }
+
+    if(inserted) {
+      return true;
+    }
+
+    for(const auto& entryPtr : comparands) {
+      MOLASSEMBLER_PROFILE_COUNT("EnsembleFilter.rmsdEvaluations", 1);
+      if(rmsd_(entryPtr->positions, candidate->positions) < threshold_) {
+        return false;
+      }
+    }
+  }
+}
+
+unsigned EnsembleFilter::size() const {
+  unsigned count = 0;
+#pragma omp critical(ensembleFilterAccess)
+  {
+    count = accepted_.size();
+  }
+  return count;
+}
+
+EnsembleFilter::Cell EnsembleFilter::cell_(const Descriptor& descriptor) const {
+  Cell cell;
+  for(unsigned i = 0; i < 3; ++i) {
+    cell[i] = static_cast<int>(std::floor(descriptor(i) / threshold_));
+  }
+  return cell;
+}
+
+double EnsembleFilter::rmsd_(
+  const Eigen::MatrixXd& reference,
+  const Eigen::MatrixXd& positions
+) const {
+  if(automorphisms_.empty()) {
+    return rmsd(reference, positions);
+  }
+
+  return rmsd(reference, positions, automorphisms_);
+}
+
+std::vector<std::shared_ptr<const EnsembleFilter::Entry>> EnsembleFilter::comparands_(
+  const Entry& candidate,
+  const Cell& candidateCell,
+  const unsigned skip
+) const {
+  std::vector<std::shared_ptr<const Entry>> comparands;
+
+  // Any redundant conformer's descriptor lies in an adjacent grid cell
+  Cell neighbor;
+  for(int a = -1; a <= 1; ++a) {
+    neighbor[0] = candidateCell[0] + a;
+    for(int b = -1; b <= 1; ++b) {
+      neighbor[1] = candidateCell[1] + b;
+      for(int c = -1; c <= 1; ++c) {
+        neighbor[2] = candidateCell[2] + c;
+
+        const auto findIter = grid_.find(neighbor);
+        if(findIter == std::end(grid_)) {
+          continue;
+        }
+
+        for(const unsigned index : findIter->second) {
+          if(index < skip) {
+            continue;
+          }
+
+          const auto& entryPtr = accepted_.at(index);
+          if((entryPtr->descriptor - candidate.descriptor).norm() < threshold_) {
+            comparands.push_back(entryPtr);
+          }
+        }
+      }
+    }
+  }
+
+  return comparands;
+}
+
+} // namespace DistanceGeometry
+} // namespace Molassembler
+} // namespace Scine
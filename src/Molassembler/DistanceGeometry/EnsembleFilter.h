@@ -0,0 +1,174 @@
+/*!@file
+ * @copyright This code is licensed under the 3-clause BSD license.
+ *   Copyright ETH Zurich, Laboratory of Physical Chemistry, Reiher Group.
+ *   See LICENSE.txt for details.
+ * @brief RMSD-based deduplication of generated conformers
+ */
+
+#ifndef INCLUDE_MOLASSEMBLER_DISTANCE_GEOMETRY_ENSEMBLE_FILTER_H
+#define INCLUDE_MOLASSEMBLER_DISTANCE_GEOMETRY_ENSEMBLE_FILTER_H
+
+#include "Molassembler/Types.h"
+
+#include <Eigen/Core>
+
+#include <array>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace Scine {
+namespace Molassembler {
+
+class Molecule;
+
+namespace DistanceGeometry {
+
+/*! @brief Rejects conformers that are within an RMSD threshold of an
+ *   accepted conformer
+ *
+ * Conformers are compared by their minimal RMSD after an optimal rotation and
+ * translation (quaternion fit). Candidates for comparison are found through a
+ * grid over the singular values of the centered positions, whose distance is
+ * a lower bound to the RMSD.
+ *
+ * Optionally, the comparison is symmetry-aware: positions may be relabeled by
+ * graph automorphisms to reduce the RMSD. Only genuine automorphisms are
+ * applied, so conformers are never rejected as duplicates of conformers they
+ * are not symmetry-equivalent to. The search over the automorphism group is
+ * local, however, and may miss some equivalences.
+ *
+ * @note Accepting is thread-safe. RMSDs are calculated outside of the lock.
+ *   In parallel use, which of two mutually redundant conformers is accepted
+ *   depends on which is offered first.
+ */
+class EnsembleFilter {
+public:
+  using Descriptor = Eigen::Vector3d;
+
+//!@name Static functions
+//!@{
+  /*! @brief Generators of the automorphism group of a molecule
+   *
+   * Automorphisms preserve element types, bond orders and stereopermutator
+   * assignments.
+   *
+   * @complexity{Same as automorphismGenerators}
+   */
+  static std::vector<std::vector<AtomIndex>> automorphisms(const Molecule& molecule);
+
+  /*! @brief Rotation- and translation-invariant descriptor of positions
+   *
+   * Singular values of the centered positions, divided by the square root of
+   * the number of positions. The distance between two descriptors is a lower
+   * bound to the RMSD of the positions.
+   *
+   * @complexity{@math{\Theta(N)}}
+   */
+  static Descriptor descriptor(const Eigen::MatrixXd& positions);
+
+  /*! @brief RMSD of positions after a quaternion fit onto a reference
+   *
+   * @complexity{@math{\Theta(N)}}
+   */
+  static double rmsd(
+    const Eigen::MatrixXd& reference,
+    const Eigen::MatrixXd& positions
+  );
+
+  /*! @brief Symmetry-aware RMSD of positions after a quaternion fit
+   *
+   * Descends through the automorphism group from the identity: The positions
+   * are repeatedly relabeled by whichever generator or inverse generator
+   * lowers the fitted RMSD until none does. The result is the RMSD for some
+   * automorphism, but not necessarily the minimal one over the whole group.
+   *
+   * @complexity{@math{\Theta(NG)} per descent step, where @math{G} is the
+   * number of generators}
+   *
+   * @param generators Automorphism group generators. Each maps an atom index
+   *   to its image.
+   */
+  static double rmsd(
+    const Eigen::MatrixXd& reference,
+    const Eigen::MatrixXd& positions,
+    const std::vector<std::vector<AtomIndex>>& generators
+  );
+//!@}
+
+//!@name Constructors
+//!@{
+  /*! @brief Construct a filter
+   *
+   * @param threshold Conformers with an RMSD to an accepted conformer below
+   *   this threshold are rejected. Same length unit as offered positions.
+   * @param automorphisms If non-empty, comparisons are symmetry-aware.
+   *   Generators of the automorphism group, e.g. from automorphisms().
+   */
+  explicit EnsembleFilter(
+    double threshold,
+    std::vector<std::vector<AtomIndex>> automorphisms = {}
+  );
+//!@}
+
+//!@name Modification
+//!@{
+  /*! @brief Offers positions to the filter, accepting them if they are not
+   *   redundant with any accepted positions
+   *
+   * @param positions Nx3 matrix of positions
+   *
+   * @complexity{Linear in the number of accepted conformers whose descriptor
+   * is within the threshold}
+   *
+   * @note Thread-safe
+   *
+   * @returns Whether the positions were accepted
+   */
+  bool accept(const Eigen::MatrixXd& positions);
+//!@}
+
+//!@name Information
+//!@{
+  //! Number of accepted conformers
+  unsigned size() const;
+
+  //! RMSD threshold
+  double threshold() const {
+    return threshold_;
+  }
+//!@}
+
+private:
+  using Cell = std::array<int, 3>;
+
+  struct Entry {
+    Eigen::MatrixXd positions;
+    Descriptor descriptor;
+  };
+
+  Cell cell_(const Descriptor& descriptor) const;
+  double rmsd_(const Eigen::MatrixXd& reference, const Eigen::MatrixXd& positions) const;
+
+  /* Accepted entries that may be redundant with a candidate, skipping the
+   * first @p skip accepted entries. Call only while holding the lock.
+   */
+  std::vector<std::shared_ptr<const Entry>> comparands_(
+    const Entry& candidate,
+    const Cell& candidateCell,
+    unsigned skip
+  ) const;
+
+  double threshold_;
+  std::vector<std::vector<AtomIndex>> automorphisms_;
+  //! Accepted entries are immutable, so they can be read outside of the lock
+  std::vector<std::shared_ptr<const Entry>> accepted_;
+  //! Grid of accepted conformer indices by descriptor
+  std::map<Cell, std::vector<unsigned>> grid_;
+};
+
+} // namespace DistanceGeometry
+} // namespace Molassembler
+} // namespace Scine
+
+#endif
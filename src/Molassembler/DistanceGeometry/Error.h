@@ -116,7 +116,27 @@ enum class DgError {
   /**
    * @brief Unknown exception
    */
-  UnknownException = 8
+  UnknownException = 8,
+  /**
+   * @brief Refinement stopped making progress and was aborted early
+   *
+   * If enabled in the configuration, refinement is monitored for stagnating
+   * error, gradient norm and chiral constraint signs. Refinements that are
+   * unlikely to succeed are aborted instead of exhausting the refinement step
+   * limit.
+   *
+   * This is a stochastic problem and should not reflect on your inputs.
+   * Conformer generation retries aborted refinements a configurable number of
+   * times with new distances.
+   */
+  RefinementAborted = 9,
+  /**
+   * @brief Conformer is redundant with a previously generated conformer
+   *
+   * If enabled in the configuration, generated conformers within an RMSD
+   * threshold of an accepted conformer of the same ensemble are rejected.
+   */
+  DuplicateConformer = 10
 };
 
 // Boilerplate to allow interoperability of DgError with std::error_code
@@ -148,6 +168,10 @@ namespace Detail {
           return "Failed to generate decision list.";
         case DgError::UnknownException:
           return "Conformer generation encountered an unexpected exception.";
+        case DgError::RefinementAborted:
+          return "Refinement stagnated and was aborted.";
+        case DgError::DuplicateConformer:
+          return "Conformer duplicates a previously generated conformer.";
         default:
           return "Unknown error.";
       };
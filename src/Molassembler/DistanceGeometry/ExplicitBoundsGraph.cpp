@@ -11,19 +11,21 @@
 #include "Molassembler/DistanceGeometry/DistanceBoundsMatrix.h"
 #include "Molassembler/DistanceGeometry/DistanceGeometry.h"
 #include "Molassembler/DistanceGeometry/Error.h"
+#include "Molassembler/DistanceGeometry/PairwiseBounds.h"
 #include "Molassembler/Log.h"
 #include "Molassembler/Modeling/AtomInfo.h"
 #include "Molassembler/Molecule.h"
 #include "Molassembler/Options.h"
+#include "Molassembler/Profiling.h"
 #include "Molassembler/Graph/PrivateGraph.h"
 
 #include "Molassembler/Temple/Random.h"
 
-#ifdef MOLASSEMBLER_EXPLICIT_GRAPH_USE_SPECIALIZED_GOR1_ALGORITHM
 #include "Molassembler/DistanceGeometry/Gor1.h"
-#else
 #include "Molassembler/Graph/Gor1.h"
-#endif
+
+#include <algorithm>
+#include <deque>
 
 
 /* Using Dijkstra's shortest paths despite there being negative edge weights is
@@ -82,24 +84,31 @@ ExplicitBoundsGraph::ExplicitBoundsGraph(
     }
   }
 
-  // Determine the two heaviest element types in the molecule, O(N)
-  heaviestAtoms_ = {{Utils::ElementType::H, Utils::ElementType::H}};
-  for(AtomIndex i = 0; i < N; ++i) {
-    auto elementType = inner.elementType(i);
-    if(
-      Utils::ElementInfo::Z(elementType)
-      > Utils::ElementInfo::Z(heaviestAtoms_.back())
-    ) {
-      heaviestAtoms_.back() = elementType;
+  setElementData_();
+}
 
-      if(
-        Utils::ElementInfo::Z(heaviestAtoms_.back())
-        > Utils::ElementInfo::Z(heaviestAtoms_.front())
-      ) {
-        std::swap(heaviestAtoms_.front(), heaviestAtoms_.back());
-      }
+ExplicitBoundsGraph::ExplicitBoundsGraph(
+  const PrivateGraph& inner,
+  const PairwiseBounds& bounds
+) : graph_ {2 * inner.N()},
+    inner_ {inner},
+    implicitLowerBounds_ {true},
+    explicitPartners_(inner.N())
+{
+  const AtomIndex N = inner.N();
+  assert(bounds.N() == N);
+
+  /* Only explicit bounds are edges. Rows are traversed in ascending order and
+   * their pairs are ordered by their higher index, so explicit partners are
+   * always appended.
+   */
+  for(AtomIndex a = 0; a < N; ++a) {
+    for(auto iter = bounds.rowBegin(a); iter != bounds.rowEnd(a); ++iter) {
+      addBound(a, iter->j, iter->bounds);
     }
   }
+
+  setElementData_();
 }
 
 ExplicitBoundsGraph::ExplicitBoundsGraph(
@@ -141,10 +150,21 @@ ExplicitBoundsGraph::ExplicitBoundsGraph(
     }
   }
 
+  setElementData_();
+}
+
+void ExplicitBoundsGraph::setElementData_() {
+  const AtomIndex N = inner_.N();
+
+  vdwRadii_.resize(N);
+  for(AtomIndex i = 0; i < N; ++i) {
+    vdwRadii_[i] = AtomInfo::vdwRadius(inner_.elementType(i));
+  }
+
   // Determine the two heaviest element types in the molecule, O(N)
   heaviestAtoms_ = {{Utils::ElementType::H, Utils::ElementType::H}};
   for(AtomIndex i = 0; i < N; ++i) {
-    auto elementType = inner.elementType(i);
+    auto elementType = inner_.elementType(i);
     if(
       Utils::ElementInfo::Z(elementType)
       > Utils::ElementInfo::Z(heaviestAtoms_.back())
@@ -161,6 +181,22 @@ ExplicitBoundsGraph::ExplicitBoundsGraph(
   }
 }
 
+void ExplicitBoundsGraph::addExplicitPartners_(const AtomIndex a, const AtomIndex b) {
+  if(!implicitLowerBounds_) {
+    return;
+  }
+
+  auto insertSorted = [](std::vector<AtomIndex>& partners, const AtomIndex i) {
+    const auto findIter = std::lower_bound(std::begin(partners), std::end(partners), i);
+    if(findIter == std::end(partners) || *findIter != i) {
+      partners.insert(findIter, i);
+    }
+  };
+
+  insertSorted(explicitPartners_[a], b);
+  insertSorted(explicitPartners_[b], a);
+}
+
 void ExplicitBoundsGraph::addBound(
   const VertexDescriptor a,
   const VertexDescriptor b,
@@ -177,6 +213,8 @@ void ExplicitBoundsGraph::addBound(
   // Forward edge from left to right graph with negative lower bound weight
   boost::add_edge(left(a), right(b), -bound.lower, graph_);
   boost::add_edge(left(b), right(a), -bound.lower, graph_);
+
+  addExplicitPartners_(a, b);
 }
 
 void ExplicitBoundsGraph::explainContradictionPaths(
@@ -241,6 +279,63 @@ void ExplicitBoundsGraph::updateGraphWithFixedDistance_(
 
   updateOrAddEdge_(left(a), right(b), -fixedDistance);
   updateOrAddEdge_(left(b), right(a), -fixedDistance);
+
+  addExplicitPartners_(a, b);
+}
+
+void ExplicitBoundsGraph::propagateFixedDistance_(
+  const VertexDescriptor a,
+  const VertexDescriptor b,
+  const double fixedDistance,
+  std::vector<double>& distances,
+  std::vector<VertexDescriptor>& predecessors,
+  std::vector<bool>& queued
+) const {
+  MOLASSEMBLER_PROFILE_SCOPE("ExplicitBoundsGraph.propagateFixedDistance");
+
+  /* Label-correcting propagation from the endpoints of decreased edges. There
+   * are no negative cycles in the graph since no edges lead from the right
+   * subgraph into the left one, so this terminates.
+   */
+  std::deque<VertexDescriptor> queue;
+  auto relax = [&](const VertexDescriptor u, const VertexDescriptor v, const double weight) {
+    if(distances[u] == std::numeric_limits<double>::max()) {
+      return;
+    }
+
+    const double candidate = distances[u] + weight;
+    if(candidate < distances[v]) {
+      distances[v] = candidate;
+      predecessors[v] = u;
+      if(!queued[v]) {
+        queued[v] = true;
+        queue.push_back(v);
+      }
+    }
+  };
+
+  relax(left(a), left(b), fixedDistance);
+  relax(left(b), left(a), fixedDistance);
+  relax(right(a), right(b), fixedDistance);
+  relax(right(b), right(a), fixedDistance);
+  relax(left(a), right(b), -fixedDistance);
+  relax(left(b), right(a), -fixedDistance);
+
+  const auto weightMap = boost::get(boost::edge_weight, graph_);
+  while(!queue.empty()) {
+    const VertexDescriptor u = queue.front();
+    queue.pop_front();
+    queued[u] = false;
+
+    MOLASSEMBLER_PROFILE_COUNT("ExplicitBoundsGraph.propagatedVertices", 1);
+
+    for(auto edges = boost::out_edges(u, graph_); edges.first != edges.second; ++edges.first) {
+      relax(u, boost::target(*edges.first, graph_), weightMap[*edges.first]);
+    }
+    forEachImplicitEdge(u, [&](const VertexDescriptor v, const double weight) {
+      relax(u, v, weight);
+    });
+  }
 }
 
 double ExplicitBoundsGraph::lowerBound(
@@ -249,7 +344,10 @@ double ExplicitBoundsGraph::lowerBound(
 ) const {
   auto edgeSearchPair = boost::edge(left(a), right(b), graph_);
 
-  assert(edgeSearchPair.second);
+  if(!edgeSearchPair.second) {
+    assert(implicitLowerBounds_);
+    return vdwRadii_[a] + vdwRadii_[b];
+  }
 
   // The graph contains the lower bound negated
   return -boost::get(boost::edge_weight, graph_, edgeSearchPair.first);
@@ -286,7 +384,64 @@ const ExplicitBoundsGraph::GraphType& ExplicitBoundsGraph::graph() const {
   return graph_;
 }
 
+void ExplicitBoundsGraph::shortestPaths_(
+  const VertexDescriptor source,
+  std::vector<VertexDescriptor>& predecessors,
+  boost::two_bit_color_map<>& colorMap,
+  std::vector<double>& distances
+) const {
+  auto predecessorMap = boost::make_iterator_property_map(
+    predecessors.begin(),
+    boost::get(boost::vertex_index, graph_)
+  );
+
+  auto distanceMap = boost::make_iterator_property_map(
+    distances.begin(),
+    boost::get(boost::vertex_index, graph_)
+  );
+
+  // re-fill color map with white
+  using ColorMapType = boost::two_bit_color_map<>;
+  std::fill(
+    colorMap.data.get(),
+    colorMap.data.get() + (colorMap.n + ColorMapType::elements_per_char - 1)
+      / ColorMapType::elements_per_char,
+    0
+  );
+
+  if(implicitLowerBounds_) {
+    boost::gor1_eg_implicit_shortest_paths(
+      *this,
+      source,
+      predecessorMap,
+      colorMap,
+      distanceMap
+    );
+    return;
+  }
+
+#ifdef MOLASSEMBLER_EXPLICIT_GRAPH_USE_SPECIALIZED_GOR1_ALGORITHM
+  boost::gor1_eg_shortest_paths(
+    *this,
+    source,
+    predecessorMap,
+    colorMap,
+    distanceMap
+  );
+#else
+  boost::gor1_simplified_shortest_paths(
+    graph_,
+    source,
+    predecessorMap,
+    colorMap,
+    distanceMap
+  );
+#endif
+}
+
 outcome::result<Eigen::MatrixXd> ExplicitBoundsGraph::makeDistanceBounds() const noexcept {
+  MOLASSEMBLER_PROFILE_SCOPE("ExplicitBoundsGraph.makeDistanceBounds");
+
   unsigned N = inner_.N();
 
   Eigen::MatrixXd bounds;
@@ -300,41 +455,7 @@ outcome::result<Eigen::MatrixXd> ExplicitBoundsGraph::makeDistanceBounds() const
   ColorMapType color_map {M};
 
   for(AtomIndex a = 0; a < N - 1; ++a) {
-    auto predecessor_map = boost::make_iterator_property_map(
-      predecessors.begin(),
-      boost::get(boost::vertex_index, graph_)
-    );
-
-    auto distance_map = boost::make_iterator_property_map(
-      distances.begin(),
-      boost::get(boost::vertex_index, graph_)
-    );
-
-    // re-fill color map with white
-    std::fill(
-      color_map.data.get(),
-      color_map.data.get() + (color_map.n + ColorMapType::elements_per_char - 1)
-        / ColorMapType::elements_per_char,
-      0
-    );
-
-#ifdef MOLASSEMBLER_EXPLICIT_GRAPH_USE_SPECIALIZED_GOR1_ALGORITHM
-    boost::gor1_ig_shortest_paths(
-      *this,
-      VertexDescriptor {left(a)},
-      predecessor_map,
-      color_map,
-      distance_map
-    );
-#else
-    boost::gor1_simplified_shortest_paths(
-      graph_,
-      VertexDescriptor {left(a)},
-      predecessor_map,
-      color_map,
-      distance_map
-    );
-#endif
+    shortestPaths_(left(a), predecessors, color_map, distances);
 
     for(AtomIndex b = a + 1; b < N; ++b) {
       // Get upper bound from distances
@@ -363,6 +484,8 @@ outcome::result<Eigen::MatrixXd> ExplicitBoundsGraph::makeDistanceMatrix(Random:
 }
 
 outcome::result<Eigen::MatrixXd> ExplicitBoundsGraph::makeDistanceMatrix(Random::Engine& engine, Partiality partiality) noexcept {
+  MOLASSEMBLER_PROFILE_SCOPE("ExplicitBoundsGraph.makeDistanceMatrix");
+
   const unsigned N = inner_.N();
 
   Eigen::MatrixXd distancesMatrix;
@@ -382,6 +505,7 @@ outcome::result<Eigen::MatrixXd> ExplicitBoundsGraph::makeDistanceMatrix(Random:
   using ColorMapType = boost::two_bit_color_map<>;
   ColorMapType color_map {M};
   std::vector<VertexDescriptor> predecessors (M);
+  std::vector<bool> queued (M, false);
 
   std::vector<AtomIndex>::const_iterator separator;
 
@@ -420,45 +544,14 @@ outcome::result<Eigen::MatrixXd> ExplicitBoundsGraph::makeDistanceMatrix(Random:
 
     Temple::Random::shuffle(otherIndices, engine);
 
+    /* Shortest paths from left(a) are calculated once. Fixing a distance
+     * only ever decreases edge weights, so subsequent changes are propagated
+     * incrementally.
+     */
+    shortestPaths_(left(a), predecessors, color_map, distances);
+
     // Again through N - 1 indices: N²
     for(const auto& b : otherIndices) {
-
-      auto predecessor_map = boost::make_iterator_property_map(
-        predecessors.begin(),
-        boost::get(boost::vertex_index, graph_)
-      );
-
-      auto distance_map = boost::make_iterator_property_map(
-        distances.begin(),
-        boost::get(boost::vertex_index, graph_)
-      );
-
-      // re-fill color map with white
-      std::fill(
-        color_map.data.get(),
-        color_map.data.get() + (color_map.n + ColorMapType::elements_per_char - 1)
-          / ColorMapType::elements_per_char,
-        0
-      );
-
-#ifdef MOLASSEMBLER_EXPLICIT_GRAPH_USE_SPECIALIZED_GOR1_ALGORITHM
-      boost::gor1_eg_shortest_paths(
-        *this,
-        left(a),
-        predecessor_map,
-        color_map,
-        distance_map
-      );
-#else
-      boost::gor1_simplified_shortest_paths(
-        graph_,
-        left(a),
-        predecessor_map,
-        color_map,
-        distance_map
-      );
-#endif
-
       double lower = -distances.at(right(b));
       double upper = distances.at(left(b));
 
@@ -483,47 +576,14 @@ outcome::result<Eigen::MatrixXd> ExplicitBoundsGraph::makeDistanceMatrix(Random:
 
       // Modify the graph accordingly
       updateGraphWithFixedDistance_(a, b, tightenedBound);
+      propagateFixedDistance_(a, b, tightenedBound, distances, predecessors, queued);
     }
   }
 
   for(auto iter = separator; iter != indices.cend(); ++iter) {
     const AtomIndex a = *iter;
 
-    auto predecessor_map = boost::make_iterator_property_map(
-      predecessors.begin(),
-      boost::get(boost::vertex_index, graph_)
-    );
-
-    auto distance_map = boost::make_iterator_property_map(
-      distances.begin(),
-      boost::get(boost::vertex_index, graph_)
-    );
-
-    // re-fill color map with white
-    std::fill(
-      color_map.data.get(),
-      color_map.data.get() + (color_map.n + ColorMapType::elements_per_char - 1)
-        / ColorMapType::elements_per_char,
-      0
-    );
-
-#ifdef MOLASSEMBLER_EXPLICIT_GRAPH_USE_SPECIALIZED_GOR1_ALGORITHM
-    boost::gor1_eg_shortest_paths(
-      *this,
-      left(a),
-      predecessor_map,
-      color_map,
-      distance_map
-    );
-#else
-    boost::gor1_simplified_shortest_paths(
-      graph_,
-      left(a),
-      predecessor_map,
-      color_map,
-      distance_map
-    );
-#endif
+    shortestPaths_(left(a), predecessors, color_map, distances);
 
     for(AtomIndex b = 0; b < N; ++b) {
       if(a == b || upperTriangle(std::min(a, b), std::max(a, b)) > 0) {
@@ -15,6 +15,7 @@
 // #define MOLASSEMBLER_EXPLICIT_GRAPH_USE_SPECIALIZED_GOR1_ALGORITHM
 
 #include "boost/graph/adjacency_list.hpp"
+#include "boost/graph/two_bit_color_map.hpp"
 #include "Eigen/Core"
 #include "Utils/Geometry/ElementInfo.h"
 
@@ -37,6 +38,7 @@ namespace DistanceGeometry {
 
 // Forward-declarations
 class DistanceBoundsMatrix;
+class PairwiseBounds;
 
 
 /*! @brief BGL wrapper to help with distance bounds smoothing
@@ -53,8 +55,11 @@ class DistanceBoundsMatrix;
  * generateDistanceMatrix called upon it. This procedure modifies the
  * underlying graph and hence cannot be called repeatedly.
  *
- * The underlying data structure is a fully explicit BGL graph containing all
- * edges and edge weights.
+ * The underlying data structure is a BGL graph containing the edges and edge
+ * weights of all explicit bounds. If constructed from dense bounds, the van der
+ * Waals lower bounds of all other pairs are edges of the graph too. If
+ * constructed from sparse pairwise bounds, they are generated during shortest
+ * paths calculations instead.
  */
 class ExplicitBoundsGraph {
 public:
@@ -93,6 +98,22 @@ public:
     const PrivateGraph& inner,
     const BoundsMatrix& bounds
   );
+
+  /*! @brief Construct from sparse pairwise bounds
+   *
+   * Pairs without explicit bounds are given a lower bound of the sum of their
+   * van der Waals radii. Unlike the dense variants, these lower bounds are
+   * not edges of the underlying graph, but are generated while scanning
+   * vertices in shortest paths calculations. The graph has six edges per
+   * explicit bound only, until makeDistanceMatrix fixes distances.
+   *
+   * @complexity{@math{\Theta(N + B)} where @math{B} is the number of
+   * explicit bounds}
+   */
+  ExplicitBoundsGraph(
+    const PrivateGraph& inner,
+    const PairwiseBounds& bounds
+  );
 //!@}
 
 //!@name Static member functions
@@ -141,7 +162,8 @@ public:
 //!@{
   /*! @brief Adds a bound between outer vertex indices to the graph
    *
-   * This is represented by six edges:
+   * In graphs from sparse pairwise bounds, this replaces the implicit lower
+   * bound between the outer vertices. This is represented by six edges:
    * - Bidirectional within the left subgraph between a and b weighted with the
    *   upper bound
    * - Bidirectional within the right subgraph between a and b weighted with
@@ -149,7 +171,8 @@ public:
    * - Edges from the left vertices of a and b to the right opposite one with
    *   the negative lower bound
    *
-   * @complexity{@math{\Theta(1)}}
+   * @complexity{@math{\Theta(1)}, @math{O(D)} in graphs from sparse pairwise
+   * bounds where @math{D} is the number of explicit bounds of a or b}
    */
   void addBound(
     VertexDescriptor a,
@@ -159,13 +182,13 @@ public:
 
   /*! @brief Fetches the lower bound between outer vertex indices from the graph
    *
-   * @complexity{@math{\Theta(1)}}
+   * @complexity{@math{O(D)} where @math{D} is the out-degree of the vertex}
    */
   double lowerBound(VertexDescriptor a, VertexDescriptor b) const;
 
   /*! @brief Fetches the upper bound between outer vertex indices from the graph
    *
-   * @complexity{@math{\Theta(1)}}
+   * @complexity{@math{O(D)} where @math{D} is the out-degree of the vertex}
    */
   double upperBound(VertexDescriptor a, VertexDescriptor b) const;
 
@@ -174,7 +197,12 @@ public:
    * Generates a distances matrix conforming to the triangle inequality bounds
    * while modifying state information. Can only be called once!
    *
-   * @complexity{@math{O(V^2 \cdot E)}}
+   * Shortest paths are calculated once per atom. Within the partiality, the
+   * changes from each subsequently fixed distance are propagated
+   * incrementally.
+   *
+   * @complexity{@math{O(V^2 \cdot E)} in the worst case, typically
+   * @math{O(V \cdot E)}}
    */
   outcome::result<Eigen::MatrixXd> makeDistanceMatrix(Random::Engine& engine) noexcept;
 
@@ -191,11 +219,48 @@ public:
   double maximalImplicitLowerBound(VertexDescriptor i) const;
 
   /*! @brief Nonmodifiable access to underlying graph
+   *
+   * @note If constructed from sparse pairwise bounds, the graph lacks the
+   * implicit lower bound edges. See forEachImplicitEdge.
    *
    * @complexity{@math{\Theta(1)}}
    */
   const GraphType& graph() const;
 
+  /*! @brief Calls a function with each implicit lower bound edge of a vertex
+   *
+   * In graphs constructed from sparse pairwise bounds, the van der Waals lower
+   * bounds of pairs without an explicit bound are not edges of the underlying
+   * graph. Shortest paths calculations have to relax these in addition to the
+   * out-edges of a vertex. Calls @p function with the target vertex and the
+   * edge weight of each. Does nothing for right vertices and graphs from
+   * dense bounds.
+   *
+   * @complexity{@math{\Theta(N)} for left vertices of graphs from sparse
+   * pairwise bounds, @math{\Theta(1)} otherwise}
+   */
+  template<typename BinaryFunction>
+  void forEachImplicitEdge(const VertexDescriptor i, BinaryFunction&& function) const {
+    if(!implicitLowerBounds_ || !isLeft(i)) {
+      return;
+    }
+
+    const VertexDescriptor a = i / 2;
+    const VertexDescriptor N = vdwRadii_.size();
+    auto partnerIter = std::begin(explicitPartners_[a]);
+    const auto partnerEnd = std::end(explicitPartners_[a]);
+    for(VertexDescriptor b = 0; b < N; ++b) {
+      if(partnerIter != partnerEnd && *partnerIter == b) {
+        ++partnerIter;
+        continue;
+      }
+
+      if(b != a) {
+        function(right(b), -(vdwRadii_[a] + vdwRadii_[b]));
+      }
+    }
+  }
+
   /*! @brief Make smooth distance bounds
    *
    * @complexity{@math{\Theta(V \cdot E)}}
@@ -208,6 +273,33 @@ private:
   const PrivateGraph& inner_;
   //! Stores the two heaviest element types
   std::array<Utils::ElementType, 2> heaviestAtoms_;
+  //! Whether van der Waals lower bounds are implicit instead of edges
+  bool implicitLowerBounds_ = false;
+  //! Van der Waals radii of the atoms
+  std::vector<double> vdwRadii_;
+  /*! Per atom, the ascending atoms with an explicit lower bound edge. Only
+   * populated if lower bounds are implicit.
+   */
+  std::vector<std::vector<AtomIndex>> explicitPartners_;
+
+  //! Sets van der Waals radii and the two heaviest element types
+  void setElementData_();
+
+  //! Records an explicit lower bound edge, replacing an implicit one
+  void addExplicitPartners_(AtomIndex a, AtomIndex b);
+
+  /*! @brief Single-source shortest paths with GOR1
+   *
+   * Includes implicit lower bound edges if lower bounds are implicit.
+   *
+   * @complexity{@math{O(V E)}}
+   */
+  void shortestPaths_(
+    VertexDescriptor source,
+    std::vector<VertexDescriptor>& predecessors,
+    boost::two_bit_color_map<>& colorMap,
+    std::vector<double>& distances
+  ) const;
 
   void updateOrAddEdge_(
     VertexDescriptor i,
@@ -220,6 +312,33 @@ private:
     VertexDescriptor b,
     double fixedDistance
   );
+
+  /*! @brief Updates single-source shortest paths after fixing a distance
+   *
+   * Fixing a distance between a and b can only decrease the weights of the
+   * edges between their vertices. Only the distances affected by these
+   * decreases are propagated.
+   *
+   * @param a First atom of the fixed pair
+   * @param b Second atom of the fixed pair
+   * @param fixedDistance The distance fixed between @p a and @p b
+   * @param distances Shortest distances from the source vertex prior to
+   *   fixing the distance. Updated in place.
+   * @param predecessors Shortest path predecessors matching @p distances.
+   *   Updated in place.
+   * @param queued Scratch space of size V, all false. Returned as such.
+   *
+   * @complexity{Proportional to the edges of the vertices whose shortest
+   * distances change}
+   */
+  void propagateFixedDistance_(
+    VertexDescriptor a,
+    VertexDescriptor b,
+    double fixedDistance,
+    std::vector<double>& distances,
+    std::vector<VertexDescriptor>& predecessors,
+    std::vector<bool>& queued
+  ) const;
 };
 
 } // namespace DistanceGeometry
@@ -448,6 +448,152 @@ std::enable_if_t<
   return true;
 }
 
+template<
+  typename VertexDescriptor,
+  class GraphClass,
+  class DistanceMap,
+  class PredecessorMap,
+  class ColorMap
+>
+void gor1_eg_implicit_scan(
+  const VertexDescriptor& vertex,
+  const GraphClass& graphWrapper,
+  PredecessorMap& predecessor_map,
+  ColorMap& color_map,
+  DistanceMap& distance_map,
+  std::stack<VertexDescriptor>& B
+) {
+  const auto& graph = graphWrapper.graph();
+
+  auto vertexDistance = get(distance_map, vertex);
+
+  // Explicit edges are stored in the graph
+  auto out_iter_pair = out_edges(vertex, graph);
+  while(out_iter_pair.first != out_iter_pair.second) {
+    auto edgeDescriptor = *out_iter_pair.first;
+
+    gor1_scan_helper(
+      vertex,
+      static_cast<VertexDescriptor>(target(edgeDescriptor, graph)),
+      vertexDistance,
+      get(edge_weight, graph, edgeDescriptor),
+      predecessor_map,
+      color_map,
+      distance_map,
+      B
+    );
+
+    ++out_iter_pair.first;
+  }
+
+  // Implicit lower bound edges are generated
+  graphWrapper.forEachImplicitEdge(
+    vertex,
+    [&](const VertexDescriptor targetVertex, const double edgeWeight) {
+      gor1_scan_helper(
+        vertex,
+        targetVertex,
+        vertexDistance,
+        edgeWeight,
+        predecessor_map,
+        color_map,
+        distance_map,
+        B
+      );
+    }
+  );
+}
+
+/*! @brief GOR1 shortest paths for ExplicitBoundsGraph with implicit lower bounds
+ *
+ * Scans both the edges of the underlying graph and the implicit van der Waals
+ * lower bound edges of the wrapper. Unlike gor1_eg_shortest_paths, no edges
+ * are skipped, so the shortest paths are exact.
+ */
+template<
+  class GraphClass,
+  class DistanceMap,
+  class PredecessorMap,
+  class ColorMap,
+  typename VertexDescriptor
+>
+std::enable_if_t<
+  std::is_same<GraphClass, Scine::Molassembler::DistanceGeometry::ExplicitBoundsGraph>::value,
+  bool
+> gor1_eg_implicit_shortest_paths(
+  const GraphClass& graphWrapper,
+  const VertexDescriptor& root_vertex,
+  PredecessorMap& predecessor_map,
+  ColorMap& color_map,
+  DistanceMap& distance_map
+) {
+  using ColorValue = typename property_traits<ColorMap>::value_type;
+  using Color = color_traits<ColorValue>;
+
+  const auto& graph = graphWrapper.graph();
+  auto verticesIterPair = vertices(graph);
+  while(verticesIterPair.first != verticesIterPair.second) {
+    put(distance_map, *verticesIterPair.first, std::numeric_limits<double>::max());
+    ++verticesIterPair.first;
+  }
+
+  put(distance_map, root_vertex, 0.0);
+  put(color_map, root_vertex, Color::gray());
+  put(predecessor_map, root_vertex, root_vertex);
+
+  std::stack<VertexDescriptor> A;
+  std::stack<VertexDescriptor> B;
+  B.push(root_vertex);
+
+  while(!B.empty()) {
+    // Compute A from B, emptying B in the process
+    while(!B.empty()) {
+      VertexDescriptor v = B.top();
+      B.pop();
+
+      ColorValue v_color = get(color_map, v);
+
+      if(v_color == Color::black()) {
+        A.push(v);
+      } else if(v_color == Color::gray()) {
+        // Re-push and mark black to keep the topological order in B and A
+        B.push(v);
+        put(color_map, v, Color::black());
+
+        gor1_eg_implicit_scan(
+          v,
+          graphWrapper,
+          predecessor_map,
+          color_map,
+          distance_map,
+          B
+        );
+      }
+    }
+
+    // Scan all elements in A, populating B with nodes added to the tree
+    while(!A.empty()) {
+      VertexDescriptor v = A.top();
+      A.pop();
+
+      // Scan
+      gor1_eg_implicit_scan(
+        v,
+        graphWrapper,
+        predecessor_map,
+        color_map,
+        distance_map,
+        B
+      );
+
+      // Mark white
+      put(color_map, v, Color::white());
+    }
+  }
+
+  return true;
+}
+
 } // namespace boost
 
 #endif
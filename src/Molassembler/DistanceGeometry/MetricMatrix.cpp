@@ -5,6 +5,7 @@
  */
 
 #include "Molassembler/DistanceGeometry/MetricMatrix.h"
+#include "Molassembler/Profiling.h"
 #include "Molassembler/Types.h"
 
 #include <Eigen/Eigenvalues>
@@ -105,6 +106,7 @@ const Eigen::MatrixXd& MetricMatrix::access() const {
 }
 
 Eigen::MatrixXd MetricMatrix::embed() const {
+  MOLASSEMBLER_PROFILE_SCOPE("MetricMatrix.embed");
   return embedWithFullDiagonalization();
 }
 
@@ -0,0 +1,90 @@
+/*!@file
+ * @copyright This code is licensed under the 3-clause BSD license.
+ *   Copyright ETH Zurich, Laboratory of Physical Chemistry, Reiher Group.
+ *   See LICENSE.txt for details.
+ */
+
+#include "Molassembler/DistanceGeometry/PairwiseBounds.h"
+
+#include "boost/optional.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+
+namespace Scine {
+namespace Molassembler {
+namespace DistanceGeometry {
+
+PairwiseBounds::PairwiseBounds() : PairwiseBounds(0) {}
+
+PairwiseBounds::PairwiseBounds(const AtomIndex N)
+  : N_(N),
+    rowOffsets_(N + 1, 0) {}
+
+PairwiseBounds::PairwiseBounds(
+  const AtomIndex N,
+  std::vector<Entry> entries
+) : N_(N),
+    entries_(std::move(entries)),
+    rowOffsets_(N + 1, 0)
+{
+  for(const Entry& entry : entries_) {
+    if(entry.i >= entry.j || entry.j >= N) {
+      throw std::out_of_range("Pairwise bounds entry indices are invalid");
+    }
+  }
+
+  std::sort(
+    std::begin(entries_),
+    std::end(entries_),
+    [](const Entry& a, const Entry& b) -> bool {
+      return std::tie(a.i, a.j) < std::tie(b.i, b.j);
+    }
+  );
+
+  // Count entries per row, then accumulate into offsets
+  for(const Entry& entry : entries_) {
+    ++rowOffsets_.at(entry.i + 1);
+  }
+  std::partial_sum(
+    std::begin(rowOffsets_),
+    std::end(rowOffsets_),
+    std::begin(rowOffsets_)
+  );
+}
+
+boost::optional<ValueBounds> PairwiseBounds::get(AtomIndex i, AtomIndex j) const {
+  if(j < i) {
+    std::swap(i, j);
+  }
+
+  const auto rowEndIter = rowEnd(i);
+  const auto findIter = std::lower_bound(
+    rowBegin(i),
+    rowEndIter,
+    j,
+    [](const Entry& entry, const AtomIndex k) -> bool {
+      return entry.j < k;
+    }
+  );
+
+  if(findIter == rowEndIter || findIter->j != j) {
+    return boost::none;
+  }
+
+  return findIter->bounds;
+}
+
+Eigen::MatrixXd PairwiseBounds::toMatrix() const {
+  Eigen::MatrixXd matrix = Eigen::MatrixXd::Zero(N_, N_);
+  for(const Entry& entry : entries_) {
+    matrix(entry.j, entry.i) = entry.bounds.lower;
+    matrix(entry.i, entry.j) = entry.bounds.upper;
+  }
+  return matrix;
+}
+
+} // namespace DistanceGeometry
+} // namespace Molassembler
+} // namespace Scine
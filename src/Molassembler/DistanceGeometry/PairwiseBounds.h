@@ -0,0 +1,137 @@
+/*!@file
+ * @copyright This code is licensed under the 3-clause BSD license.
+ *   Copyright ETH Zurich, Laboratory of Physical Chemistry, Reiher Group.
+ *   See LICENSE.txt for details.
+ * @brief Sparse storage of explicit atom-pairwise distance bounds
+ */
+
+#ifndef INCLUDE_MOLASSEMBLER_DISTANCE_GEOMETRY_PAIRWISE_BOUNDS_H
+#define INCLUDE_MOLASSEMBLER_DISTANCE_GEOMETRY_PAIRWISE_BOUNDS_H
+
+#include "boost/optional/optional_fwd.hpp"
+#include <Eigen/Core>
+
+#include "Molassembler/DistanceGeometry/ValueBounds.h"
+#include "Molassembler/Types.h"
+
+#include <vector>
+
+namespace Scine {
+namespace Molassembler {
+namespace DistanceGeometry {
+
+/*! @brief Sparse atom-pairwise distance bounds
+ *
+ * A spatial model only sets distance bounds for atom pairs separated by up to
+ * three bonds and for fixed positions. All other pairs are implicitly bounded
+ * from below by the sum of their van der Waals radii. Only the explicit pairs
+ * are stored here, in compressed sparse row layout: entries are ordered by
+ * their lower atom index, then their higher atom index.
+ *
+ * Conformer generation passes these to ExplicitBoundsGraph, which keeps the
+ * van der Waals lower bounds implicit as well. Its smoothed distance bounds and
+ * the distance matrix are dense. ImplicitBoundsGraph and DistanceBoundsMatrix
+ * take the dense expansion from toMatrix().
+ */
+class PairwiseBounds {
+public:
+//!@name Member types
+//!@{
+  //! Explicitly bounded atom pair
+  struct Entry {
+    //! Lower atom index of the pair
+    AtomIndex i;
+    //! Higher atom index of the pair
+    AtomIndex j;
+    //! Distance bounds between the atoms
+    ValueBounds bounds;
+  };
+
+  using const_iterator = std::vector<Entry>::const_iterator;
+//!@}
+
+//!@name Special member functions
+//!@{
+  //! Initializes an empty set of bounds for no atoms
+  PairwiseBounds();
+
+  /*! @brief Initializes a set of bounds without explicit pairs
+   *
+   * @complexity{@math{\Theta(N)}}
+   */
+  explicit PairwiseBounds(AtomIndex N);
+
+  /*! @brief Constructs from unordered explicit pairs
+   *
+   * @complexity{@math{\Theta(N + E \log E)} where @math{E} is the number of
+   * explicit pairs}
+   *
+   * @throws std::out_of_range If any entry's indices are not ordered or exceed
+   *   @p N
+   */
+  PairwiseBounds(AtomIndex N, std::vector<Entry> entries);
+//!@}
+
+//!@name Information
+//!@{
+  //! Number of atoms
+  inline AtomIndex N() const {
+    return N_;
+  }
+
+  //! Number of explicitly bounded pairs
+  inline unsigned size() const {
+    return entries_.size();
+  }
+
+  /*! @brief Fetches the explicit bounds between two atoms, if present
+   *
+   * @complexity{@math{O(\log d)} where @math{d} is the number of explicit
+   * pairs of the lower atom index}
+   */
+  boost::optional<ValueBounds> get(AtomIndex i, AtomIndex j) const;
+
+  /*! @brief Generates a dense matrix of the explicit bounds
+   *
+   * Lower bounds are in the strict lower triangle, upper bounds in the strict
+   * upper triangle. Pairs without explicit bounds are zero.
+   *
+   * @complexity{@math{\Theta(N^2)}}
+   */
+  Eigen::MatrixXd toMatrix() const;
+//!@}
+
+//!@name Iterators
+//!@{
+  //! Begin iterator over all explicit pairs
+  inline const_iterator begin() const {
+    return std::begin(entries_);
+  }
+
+  //! End iterator over all explicit pairs
+  inline const_iterator end() const {
+    return std::end(entries_);
+  }
+
+  //! Begin iterator of the explicit pairs whose lower atom index is @p i
+  inline const_iterator rowBegin(const AtomIndex i) const {
+    return std::begin(entries_) + rowOffsets_.at(i);
+  }
+
+  //! End iterator of the explicit pairs whose lower atom index is @p i
+  inline const_iterator rowEnd(const AtomIndex i) const {
+    return std::begin(entries_) + rowOffsets_.at(i + 1);
+  }
+//!@}
+
+private:
+  AtomIndex N_;
+  std::vector<Entry> entries_;
+  std::vector<unsigned> rowOffsets_;
+};
+
+} // namespace DistanceGeometry
+} // namespace Molassembler
+} // namespace Scine
+
+#endif
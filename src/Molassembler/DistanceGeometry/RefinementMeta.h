@@ -13,10 +13,72 @@
 
 #include "Molassembler/Temple/Stringify.h"
 
+#include <algorithm>
+#include <limits>
+
 namespace Scine {
 namespace Molassembler {
 namespace DistanceGeometry {
 
+/*! @brief Watches a refinement trajectory for stagnation
+ *
+ * Tracks the best error, gradient norm and proportion of correctly signed
+ * chiral constraints seen so far. At the end of each window of iterations,
+ * the window counts as stagnant if none of these improved meaningfully over
+ * the previous window. After several consecutive stagnant windows, the
+ * refinement is considered doomed.
+ */
+struct StagnationMonitor {
+  //! Records the state of a refinement after an iteration
+  void observe(
+    const unsigned iteration,
+    const double error,
+    const double gradientNorm,
+    const double chiralProportion = 0
+  ) {
+    bestError_ = std::min(bestError_, error);
+    bestGradientNorm_ = std::min(bestGradientNorm_, gradientNorm);
+    bestChiralProportion_ = std::max(bestChiralProportion_, chiralProportion);
+
+    if(iteration == 0 || iteration % window != 0) {
+      return;
+    }
+
+    const bool improved = (
+      bestError_ < (1 - relativeImprovement) * windowError_
+      || bestGradientNorm_ < (1 - relativeImprovement) * windowGradientNorm_
+      || bestChiralProportion_ > windowChiralProportion_
+    );
+
+    stagnantWindows_ = improved ? 0 : stagnantWindows_ + 1;
+    doomed = (stagnantWindows_ >= patience);
+
+    windowError_ = bestError_;
+    windowGradientNorm_ = bestGradientNorm_;
+    windowChiralProportion_ = bestChiralProportion_;
+  }
+
+  //! Whether to monitor at all
+  bool enabled = false;
+  //! Number of iterations per window
+  unsigned window = 250;
+  //! Number of consecutive stagnant windows until the refinement is doomed
+  unsigned patience = 4;
+  //! Minimal relative decrease of error or gradient norm per window
+  double relativeImprovement = 0.01;
+  //! Signals that the refinement is unlikely to succeed
+  bool doomed = false;
+
+private:
+  double bestError_ = std::numeric_limits<double>::max();
+  double bestGradientNorm_ = std::numeric_limits<double>::max();
+  double bestChiralProportion_ = 0;
+  double windowError_ = std::numeric_limits<double>::max();
+  double windowGradientNorm_ = std::numeric_limits<double>::max();
+  double windowChiralProportion_ = -1;
+  unsigned stagnantWindows_ = 0;
+};
+
 /**
  * @brief Decides whether the final structure from a refinement is acceptable
  *
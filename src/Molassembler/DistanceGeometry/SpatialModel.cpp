@@ -35,6 +35,7 @@
 #include "Molassembler/Modeling/CommonTrig.h"
 #include "Molassembler/Modeling/ShapeInference.h"
 #include "Molassembler/Molecule/MolGraphWriter.h"
+#include "Molassembler/Profiling.h"
 #include "Molassembler/RankingInformation.h"
 #include "Molassembler/Stereopermutators/FeasiblePermutations.h"
 
@@ -112,6 +113,8 @@ SpatialModel::SpatialModel(
   const Molecule& molecule,
   const Configuration& configuration
 ) : molecule_(molecule) {
+  MOLASSEMBLER_PROFILE_SCOPE("SpatialModel");
+
   /* This is overall a pretty complicated constructor since it encompasses the
    * entire conversion from a molecular graph into some model of the internal
    * coordinates of all connected atoms, determining which conformations are
@@ -778,14 +781,16 @@ bool bondInformationIsPresent(
   );
 }
 
-SpatialModel::BoundsMatrix SpatialModel::makePairwiseBounds(
+PairwiseBounds SpatialModel::makePairwiseBounds(
   unsigned N,
   const BoundsMapType<2>& fixedPositionBounds,
   const BoundsMapType<2>& bondBounds,
   const BoundsMapType<3>& angleBounds,
   const BoundsMapType<4>& dihedralBounds
 ) {
-  BoundsMatrixHelper bounds(N);
+  MOLASSEMBLER_PROFILE_SCOPE("SpatialModel.makePairwiseBounds");
+
+  PairwiseBoundsHelper bounds(N);
 
   // Copy the constraints as ground truth
   bounds.addMap(fixedPositionBounds);
@@ -883,7 +888,7 @@ SpatialModel::BoundsMatrix SpatialModel::makePairwiseBounds(
     );
   }
 
-  return bounds.matrix;
+  return bounds.compress();
 }
 
 double SpatialModel::siteCentralAngle(
@@ -1211,7 +1216,7 @@ ChiralConstraint SpatialModel::makeChiralConstraint(
   };
 }
 
-SpatialModel::BoundsMatrix SpatialModel::makePairwiseBounds() const {
+PairwiseBounds SpatialModel::makePairwiseBounds() const {
   return makePairwiseBounds(
     molecule_.graph().N(),
     constraints_,
@@ -1951,7 +1956,7 @@ void SpatialModel::modelSpirocenters_(
     }
 
     unsigned* URFIDs;
-    unsigned nIDs = RDL_getURFsContainingNode(cycleData.dataPtr(), i, &URFIDs);
+    unsigned nIDs = RDL_getURFsContainingNode(cycleData.dataPtr(), cycleData.rdlVertex(i), &URFIDs);
     assert(nIDs == 2);
 
     bool allURFsSingularRC = true;
@@ -1977,12 +1982,12 @@ void SpatialModel::modelSpirocenters_(
 
       // We model them only if both are small.
       if(cycleOne -> weight <= 5 && cycleTwo -> weight <= 5) {
-        auto makeVerticesSet = [](RDL_cycle* cyclePtr) -> std::set<AtomIndex> {
+        auto makeVerticesSet = [&cycleData](RDL_cycle* cyclePtr) -> std::set<AtomIndex> {
           std::set<AtomIndex> vertices;
 
           for(unsigned cycleIndex = 0; cycleIndex < cyclePtr -> weight; ++cycleIndex) {
-            vertices.insert(cyclePtr->edges[cycleIndex][0]);
-            vertices.insert(cyclePtr->edges[cycleIndex][1]);
+            vertices.insert(cycleData.vertex(cyclePtr->edges[cycleIndex][0]));
+            vertices.insert(cycleData.vertex(cyclePtr->edges[cycleIndex][1]));
           }
 
           return vertices;
@@ -2090,10 +2095,10 @@ void SpatialModel::modelSpirocenters_(
   }
 }
 
-void SpatialModel::BoundsMatrixHelper::add(
+void SpatialModel::PairwiseBoundsHelper::add(
   AtomIndex i,
   AtomIndex j,
-  const ValueBounds& bounds
+  const ValueBounds& valueBounds
 ) {
   /* There may be overlapping and possibly conflicting information present in
    * the gathered data. If data affects the same atom-pair, we must ensure that
@@ -2106,34 +2111,43 @@ void SpatialModel::BoundsMatrixHelper::add(
     std::swap(i, j);
   }
 
-  double& lowerBound = matrix(j, i);
-  double& upperBound = matrix(i, j);
+  assert(valueBounds.lower <= valueBounds.upper);
+
+  auto findIter = bounds.find({{i, j}});
+  if(findIter == std::end(bounds)) {
+    bounds.emplace(
+      std::array<AtomIndex, 2> {{i, j}},
+      valueBounds
+    );
+    return;
+  }
 
-  assert(bounds.lower <= bounds.upper);
+  double& lowerBound = findIter->second.lower;
+  double& upperBound = findIter->second.upper;
   assert(lowerBound <= upperBound);
 
   if(lowerBound != 0.0 && upperBound != 0.0) {
     if(
-      bounds.lower > lowerBound
-      && bounds.lower < upperBound
+      valueBounds.lower > lowerBound
+      && valueBounds.lower < upperBound
     ) {
-      lowerBound = bounds.lower;
+      lowerBound = valueBounds.lower;
     }
 
     // Try to lower the upper bound
     if(
-      bounds.upper < upperBound
-      && bounds.upper > lowerBound
+      valueBounds.upper < upperBound
+      && valueBounds.upper > lowerBound
     ) {
-      upperBound = bounds.upper;
+      upperBound = valueBounds.upper;
     }
   } else {
-    lowerBound = bounds.lower;
-    upperBound = bounds.upper;
+    lowerBound = valueBounds.lower;
+    upperBound = valueBounds.upper;
   }
 }
 
-ValueBounds SpatialModel::BoundsMatrixHelper::get(
+ValueBounds SpatialModel::PairwiseBoundsHelper::get(
   AtomIndex i,
   AtomIndex j
 ) const {
@@ -2141,24 +2155,35 @@ ValueBounds SpatialModel::BoundsMatrixHelper::get(
     std::swap(i, j);
   }
 
-  return ValueBounds {
-    matrix(j, i),
-    matrix(i, j)
-  };
+  auto findIter = bounds.find({{i, j}});
+  if(findIter == std::end(bounds)) {
+    return ValueBounds {0.0, 0.0};
+  }
+
+  return findIter->second;
 }
 
-void SpatialModel::BoundsMatrixHelper::addMap(const BoundsMapType<2>& boundsMap) {
+void SpatialModel::PairwiseBoundsHelper::addMap(const BoundsMapType<2>& boundsMap) {
   for(const auto& indexArrayBoundsPair : boundsMap) {
-    const std::array<AtomIndex, 2>& indexArray = indexArrayBoundsPair.first;
-    const ValueBounds& valueBounds = indexArrayBoundsPair.second;
-
-    const AtomIndex i = indexArray.front();
-    const AtomIndex j = indexArray.back();
+    assert(indexArrayBoundsPair.first.front() < indexArrayBoundsPair.first.back());
+    bounds[indexArrayBoundsPair.first] = indexArrayBoundsPair.second;
+  }
+}
 
-    assert(i < j);
-    matrix(j, i) = valueBounds.lower;
-    matrix(i, j) = valueBounds.upper;
+PairwiseBounds SpatialModel::PairwiseBoundsHelper::compress() const {
+  std::vector<PairwiseBounds::Entry> entries;
+  entries.reserve(bounds.size());
+  for(const auto& indexArrayBoundsPair : bounds) {
+    entries.push_back(
+      PairwiseBounds::Entry {
+        indexArrayBoundsPair.first.front(),
+        indexArrayBoundsPair.first.back(),
+        indexArrayBoundsPair.second
+      }
+    );
   }
+
+  return PairwiseBounds {N, std::move(entries)};
 }
 
 } // namespace DistanceGeometry
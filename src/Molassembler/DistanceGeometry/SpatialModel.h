@@ -19,6 +19,7 @@
 #define INCLUDE_MOLASSEMBLER_DISTANCE_GEOMETRY_SPATIAL_MODEL_H
 
 #include "Molassembler/DistanceGeometry/DistanceBoundsMatrix.h"
+#include "Molassembler/DistanceGeometry/PairwiseBounds.h"
 #include "Molassembler/Molecule.h"
 #include "Molassembler/Graph.h"
 #include "Molassembler/StereopermutatorList.h"
@@ -56,24 +57,25 @@ public:
   //! Type used to store fixed positions in angstrom
   using FixedPositionsMapType = std::unordered_map<AtomIndex, Utils::Position>;
 
-  /*!
-   * @brief Type used to represent atom-pairwise distance bounds constructed
-   *   from bounds on internal coordinates
+  /*! @brief Accumulates atom-pairwise distance bounds from internal
+   *   coordinate bounds
    *
-   * Diagonal entries are undefined. Strict lower triangle contains lower
-   * bounds, strict upper triangle contains upper bounds.
+   * Merges overlapping information on the same atom pair without inverting
+   * bounds. Atom pairs without information are not stored.
    */
-  using BoundsMatrix = Eigen::MatrixXd;
-
-  struct BoundsMatrixHelper {
-    inline explicit BoundsMatrixHelper(AtomIndex size) : matrix(size, size) { matrix.setZero(); }
+  struct PairwiseBoundsHelper {
+    inline explicit PairwiseBoundsHelper(AtomIndex size) : N(size) {}
 
     void add(AtomIndex i, AtomIndex j, const ValueBounds& bounds);
     void addMap(const BoundsMapType<2>& boundsMap);
 
     ValueBounds get(AtomIndex i, AtomIndex j) const;
 
-    Eigen::MatrixXd matrix;
+    //! Compresses the accumulated bounds
+    PairwiseBounds compress() const;
+
+    AtomIndex N;
+    BoundsMapType<2> bounds;
   };
 //!@}
 
@@ -198,7 +200,7 @@ public:
   );
 
   /*
-   * @brief Generates a matrix of atom-pairwise distance bounds
+   * @brief Generates sparse atom-pairwise distance bounds
    *
    * @complexity{@math{O(P_2 + P_3 + P_4)} where @math{P_i} is the number of
    * distinct paths of length @math{i} in the graph. That should scale at least
@@ -210,11 +212,10 @@ public:
    * @param angleBounds Angle bounds to enforce on atom index triples
    * @param dihedralBounds Dihedral bounds to enforce on atom index quadruplet
    *
-   * @return A matrix of atom-pairwise distance bounds. Lower bounds are in the
-   * strict lower triangle of the matrix, upper bounds in the strict upper
-   * triangle.
+   * @return Explicit atom-pairwise distance bounds. Atom pairs without bounds
+   * are only implicitly bounded by the sum of their van der Waals radii.
    */
-  static BoundsMatrix makePairwiseBounds(
+  static PairwiseBounds makePairwiseBounds(
     unsigned N,
     const BoundsMapType<2>& fixedPositionBounds,
     const BoundsMapType<2>& bondBounds,
@@ -464,11 +465,9 @@ public:
    * distinct paths of length @math{i} in the graph. That should scale at least
    * linearly in the number of vertices.}
    *
-   * @return A matrix of atom-pairwise distance bounds. Lower bounds are in the
-   * strict lower triangle of the matrix, upper bounds in the strict upper
-   * triangle.
+   * @return Explicit atom-pairwise distance bounds
    */
-  BoundsMatrix makePairwiseBounds() const;
+  PairwiseBounds makePairwiseBounds() const;
 
   /** @brief Generates a string graphviz representation of the modeled molecule
    *
@@ -329,6 +329,7 @@ Molecule Editing::insert(
   );
 
   // Copy in stereopermutators from wedge
+  log.pImpl_->materializeStereopermutators_();
   StereopermutatorList& logStereopermutators = log.pImpl_->stereopermutators_;
 
   transferStereopermutators(
@@ -445,6 +446,7 @@ Molecule Editing::superpose(
    */
 
   // Copy in stereopermutators from bottom, including ones placed on bottomAtom
+  top.pImpl_->materializeStereopermutators_();
   StereopermutatorList& topStereopermutators = top.pImpl_->stereopermutators_;
   vertexMapping[bottomAtom] = topAtom;
   transferStereopermutators(
@@ -636,6 +638,7 @@ Molecule Editing::connect(
   const BondType bondType
 ) {
   PrivateGraph& aInnerGraph = a.pImpl_->adjacencies_.inner();
+  a.pImpl_->materializeStereopermutators_();
   StereopermutatorList& aStereopermutators = a.pImpl_->stereopermutators_;
 
   // Copy b's graph into a
@@ -666,6 +669,7 @@ Molecule Editing::addLigand(
   const std::vector<AtomIndex>& ligandBindingAtoms
 ) {
   PrivateGraph& aInnerGraph = a.pImpl_->adjacencies_.inner();
+  a.pImpl_->materializeStereopermutators_();
   StereopermutatorList& aStereopermutators = a.pImpl_->stereopermutators_;
 
   auto vertexMapping = transferGraph(
@@ -682,9 +686,12 @@ Molecule Editing::addLigand(
     ligand.graph().N()
   );
 
+  // Rerank everywhere only once all binding atoms are connected
+  Molecule::EditGuard guard {a};
   for(const AtomIndex bindingAtom : ligandBindingAtoms) {
     a.addBond(complexatingAtom, vertexMapping.at(bindingAtom), BondType::Single);
   }
+  guard.commit();
 
   return a;
 }
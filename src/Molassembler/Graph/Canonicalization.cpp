@@ -15,11 +15,15 @@
 #include "Molassembler/Graph/PrivateGraph.h"
 #include "Molassembler/Molecule/AtomEnvironmentHash.h"
 #include "Molassembler/Graph.h"
+#include "Molassembler/Profiling.h"
 
-#include "Molassembler/Temple/Adaptors/SequentialPairs.h"
-#include "Molassembler/Temple/Adaptors/Iota.h"
 #include "Molassembler/Temple/Functional.h"
 
+#include <algorithm>
+#include <cassert>
+#include <map>
+#include <numeric>
+
 extern "C" {
 #include "nauty/nausparse.h"
 
@@ -46,7 +50,10 @@ void molassembler_nauty_canonicalize(int nv, size_t nde, size_t* v, int* d, int*
 
   statsblk stats;
 
-  SG_DECL(canong);
+  /* The canonical graph and orbits are workspaces that are kept across calls
+   * and only grow. With a thread-safe build of nauty, they are thread-local.
+   */
+  static TLS_ATTR SG_DECL(canong);
 
   DYNALLSTAT(int, orbits, orbits_sz);
   DYNALLOC1(int, orbits, orbits_sz, nv, "malloc");
@@ -62,8 +69,48 @@ void molassembler_nauty_canonicalize(int nv, size_t nde, size_t* v, int* d, int*
    *   [i] 0 1 2 3 = new_idx
    *   lab 4 3 1 2 = old_idx
    */
-  SG_FREE(canong);
-  DYNFREE(orbits, orbits_sz);
+}
+
+/*!
+ * @brief Collects automorphism group generators found by nauty
+ *
+ * nauty's callback carries no user data, so the generators of the current
+ * thread's call are collected through a thread-local pointer.
+ */
+static thread_local std::vector<std::vector<int>>* molassembler_nauty_generators = nullptr;
+
+static void molassembler_nauty_store_generator(int /* count */, int* perm, int* /* orbits */, int /* numorbits */, int /* stabvertex */, int n) {
+  molassembler_nauty_generators->emplace_back(perm, perm + n);
+}
+
+/*!
+ * @brief Find generators of the automorphism group of a colored sparse graph
+ *
+ * @complexity{Same as molassembler_nauty_canonicalize}
+ *
+ * @post generators contains permutations generating the automorphism group
+ *   preserving the provided coloring
+ */
+void molassembler_nauty_automorphisms(int nv, size_t nde, size_t* v, int* d, int* e, size_t vlen, size_t dlen, size_t elen, int* lab, int* ptn, std::vector<std::vector<int>>* generators) {
+  DEFAULTOPTIONS_SPARSEGRAPH(options);
+  options.defaultptn = false;
+  options.invarproc = distances_sg;
+  // Only the automorphism group is of interest, not the canonical graph
+  options.getcanon = false;
+  options.userautomproc = molassembler_nauty_store_generator;
+
+  statsblk stats;
+
+  DYNALLSTAT(int, orbits, orbits_sz);
+  DYNALLOC1(int, orbits, orbits_sz, nv, "malloc");
+  sparsegraph source {nde, v, nv, d, e, nullptr, vlen, dlen, elen, 0};
+
+  int m = SETWORDSNEEDED(nv);
+  nauty_check(WORDSIZE, m, nv, NAUTYVERSIONID);
+
+  molassembler_nauty_generators = generators;
+  sparsenauty(&source, lab, ptn, orbits, &options, &stats, nullptr);
+  molassembler_nauty_generators = nullptr;
 }
 
 } // end extern "C"
@@ -93,7 +140,18 @@ struct NautySparseGraph {
    */
   std::vector<int> lab, ptn;
 
-  NautySparseGraph(
+  /*! @brief Per-thread instance whose buffers are reused across calls
+   *
+   * Batch canonicalization calls nauty for many molecules in quick
+   * succession. Reusing the buffers avoids reallocating them each time.
+   */
+  static NautySparseGraph& local() {
+    static thread_local NautySparseGraph workspace;
+    return workspace;
+  }
+
+  //! Fill with a graph and coloring, reusing allocated buffers
+  void assign(
     const PrivateGraph& inner,
     const std::vector<Hashes::WideHashType>& hashes
   ) {
@@ -135,22 +193,18 @@ struct NautySparseGraph {
       throw std::invalid_argument("Supplied hashes do not match number of vertices");
     }
 
-    nv = inner.N();
-    nde = 2 * inner.B();
-    v.reserve(nv);
-    d.reserve(nv);
-    e.reserve(nde);
-
-    // Construct the adjacency list representation within a 'sparsegraph'
-    for(AtomIndex i : inner.vertices()) {
-      d.push_back(inner.degree(i));
-
-      // Create an adjacency list for i in v
-      v.push_back(e.size());
-      for(AtomIndex j : inner.adjacents(i)) {
-        e.push_back(j);
-      }
+    /* The compressed sparse row snapshot of the graph is already laid out
+     * like a 'sparsegraph', only the integer types differ
+     */
+    const CsrGraph& csr = inner.csr();
+    nv = N;
+    nde = csr.adjacents().size();
+    v.assign(std::begin(csr.offsets()), std::end(csr.offsets()) - 1);
+    d.resize(nv);
+    for(AtomIndex i = 0; i < N; ++i) {
+      d[i] = csr.degree(i);
     }
+    e.assign(std::begin(csr.adjacents()), std::end(csr.adjacents()));
 
     /* A coloring is specified by a pair of integer arrays, called lab and ptn:
      * - lab contains a list of vertices in some order
@@ -167,57 +221,261 @@ struct NautySparseGraph {
      */
 
     // We use the hashes to order our vertices
-    lab = Temple::sorted(
-      Temple::iota<int>(nv),
+    lab.resize(nv);
+    std::iota(std::begin(lab), std::end(lab), 0);
+    std::sort(
+      std::begin(lab),
+      std::end(lab),
       [&hashes](const int a, const int b) -> bool {
         return hashes.at(a) < hashes.at(b);
       }
     );
 
-    // And then generate the partition from checking adjacent hash equality
-    ptn = Temple::map(
-      Temple::Adaptors::sequentialPairs(lab),
-      [&hashes](const int a, const int b) -> int {
-        return static_cast<int>(hashes.at(a) == hashes.at(b));
-      }
-    );
-
-    /* Add final element (since taking sequential pairs yields an element fewer),
-     * which is always the end of a cell (group of vertices with identical
-     * coloring)
+    /* And then generate the partition from checking adjacent hash equality.
+     * The final element is always the end of a cell (group of vertices with
+     * identical coloring).
      */
-    ptn.push_back(0);
+    ptn.resize(nv);
+    for(int i = 0; i + 1 < nv; ++i) {
+      ptn[i] = static_cast<int>(hashes.at(lab[i]) == hashes.at(lab[i + 1]));
+    }
+    if(nv > 0) {
+      ptn.back() = 0;
+    }
   }
 };
 
+/*! @brief Whether color refinement of a coloring yields a discrete partition
+ *
+ * Refines vertex colors by the sorted colors of adjacent vertices until the
+ * partition is stable. Automorphisms preserve the refined coloring, so if
+ * every vertex ends up with a distinct color, only the identity preserves the
+ * original coloring.
+ *
+ * @complexity{@math{O(RN \log N)} where @math{R} is the number of
+ * refinement rounds}
+ */
+bool refinesToDiscrete(
+  const CsrGraph& csr,
+  const std::vector<Hashes::WideHashType>& hashes
+) {
+  const AtomIndex N = csr.N();
+  std::vector<unsigned> colors(N);
+  unsigned numColors = 0;
+  {
+    std::map<Hashes::WideHashType, unsigned> hashColors;
+    for(AtomIndex i = 0; i < N; ++i) {
+      colors[i] = hashColors.emplace(hashes.at(i), hashColors.size()).first->second;
+    }
+    numColors = hashColors.size();
+  }
+
+  std::vector<unsigned> signature;
+  while(numColors < N) {
+    std::map<std::vector<unsigned>, unsigned> signatureColors;
+    std::vector<unsigned> refined(N);
+    for(AtomIndex i = 0; i < N; ++i) {
+      signature.clear();
+      for(const AtomIndex j : csr.adjacents(i)) {
+        signature.push_back(colors[j]);
+      }
+      std::sort(std::begin(signature), std::end(signature));
+      signature.push_back(colors[i]);
+      refined[i] = signatureColors.emplace(signature, signatureColors.size()).first->second;
+    }
+
+    colors = std::move(refined);
+    if(signatureColors.size() == numColors) {
+      return false;
+    }
+    numColors = signatureColors.size();
+  }
+
+  return true;
+}
+
 } // namespace
 
 std::vector<int> canonicalAutomorphism(
   const PrivateGraph& inner,
   const std::vector<Hashes::WideHashType>& hashes
 ) {
-  NautySparseGraph nautyGraph(inner, hashes);
+  MOLASSEMBLER_PROFILE_SCOPE("Canonicalization.nauty");
+
+  NautySparseGraph& nautyGraph = NautySparseGraph::local();
+  nautyGraph.assign(inner, hashes);
 
   /* Call the C function with addresses to the start of the underlying arrays
    * and their sizes. The sizes of lab and ptn are known since they have to be
-   * nv elements long.
+   * nv elements long. Without thread-local workspaces, nauty calls must be
+   * serialized.
    */
+#ifndef USE_TLS
+#pragma omp critical(nautyAccess)
+#endif
   molassembler_nauty_canonicalize(
     nautyGraph.nv,
     nautyGraph.nde,
-    &nautyGraph.v[0],
-    &nautyGraph.d[0],
-    &nautyGraph.e[0],
+    nautyGraph.v.data(),
+    nautyGraph.d.data(),
+    nautyGraph.e.data(),
     nautyGraph.v.size(),
     nautyGraph.d.size(),
     nautyGraph.e.size(),
-    &nautyGraph.lab[0],
-    &nautyGraph.ptn[0]
+    nautyGraph.lab.data(),
+    nautyGraph.ptn.data()
   );
 
   // lab is now the (inverse) permutation we need to apply for a canonical graph
   return nautyGraph.lab;
 }
 
+bool threadSafeCanonicalization() {
+#ifdef USE_TLS
+  return true;
+#else
+  return false;
+#endif
+}
+
+std::vector<std::vector<AtomIndex>> automorphismGenerators(
+  const PrivateGraph& inner,
+  const std::vector<Hashes::WideHashType>& hashes
+) {
+  MOLASSEMBLER_PROFILE_SCOPE("Canonicalization.automorphisms");
+
+  NautySparseGraph& nautyGraph = NautySparseGraph::local();
+  nautyGraph.assign(inner, hashes);
+
+  // Most molecules are asymmetric, which is often cheaper to see than nauty
+  const CsrGraph& csr = inner.csr();
+  if(refinesToDiscrete(csr, hashes)) {
+    MOLASSEMBLER_PROFILE_COUNT("Canonicalization.automorphisms.skipped", 1);
+    return {};
+  }
+
+  std::vector<std::vector<int>> nautyGenerators;
+#ifndef USE_TLS
+#pragma omp critical(nautyAccess)
+#endif
+  molassembler_nauty_automorphisms(
+    nautyGraph.nv,
+    nautyGraph.nde,
+    nautyGraph.v.data(),
+    nautyGraph.d.data(),
+    nautyGraph.e.data(),
+    nautyGraph.v.size(),
+    nautyGraph.d.size(),
+    nautyGraph.e.size(),
+    nautyGraph.lab.data(),
+    nautyGraph.ptn.data(),
+    &nautyGenerators
+  );
+
+  /* Vertex colors do not capture bond orders exactly. In a Kekule structure
+   * of benzene, all carbon atoms have identical environments, but rotation by
+   * one position exchanges single and double bonds. Keep only generators
+   * preserving all bond types. These generate a subgroup of the automorphisms
+   * preserving bond types, which is all that callers rely on.
+   */
+  std::vector<std::vector<AtomIndex>> generators;
+  for(const auto& nautyGenerator : nautyGenerators) {
+    std::vector<AtomIndex> generator(std::begin(nautyGenerator), std::end(nautyGenerator));
+    bool preservesBondTypes = true;
+    for(AtomIndex i = 0; i < csr.N() && preservesBondTypes; ++i) {
+      for(std::size_t k = csr.offsets()[i]; k < csr.offsets()[i + 1]; ++k) {
+        const AtomIndex j = csr.adjacents()[k];
+        if(csr.bondType(generator[i], generator[j]) != csr.bondTypes()[k]) {
+          preservesBondTypes = false;
+          break;
+        }
+      }
+    }
+
+    if(preservesBondTypes) {
+      generators.push_back(std::move(generator));
+    }
+  }
+
+  return generators;
+}
+
+constexpr unsigned AutomorphismOrbits::noParent;
+
+AutomorphismOrbits::AutomorphismOrbits(
+  const AtomIndex N,
+  std::vector<std::vector<AtomIndex>> generators
+) : generators_(std::move(generators)),
+    representatives_(N),
+    parents_(N, std::make_pair(noParent, AtomIndex {0}))
+{
+  /* Inverses are needed to keep the Schreier trees shallow for cyclic groups
+   * with few generators
+   */
+  const unsigned G = generators_.size();
+  for(unsigned g = 0; g < G; ++g) {
+    std::vector<AtomIndex> inverse(N);
+    for(AtomIndex i = 0; i < N; ++i) {
+      inverse[generators_[g][i]] = i;
+    }
+    generators_.push_back(std::move(inverse));
+  }
+
+  // Breadth-first search from the smallest vertex of each orbit
+  std::vector<bool> discovered(N, false);
+  std::vector<AtomIndex> queue;
+  for(AtomIndex root = 0; root < N; ++root) {
+    if(discovered[root]) {
+      continue;
+    }
+
+    discovered[root] = true;
+    representatives_[root] = root;
+    queue.assign(1, root);
+    for(std::size_t head = 0; head < queue.size(); ++head) {
+      const AtomIndex u = queue[head];
+      for(unsigned g = 0; g < generators_.size(); ++g) {
+        const AtomIndex v = generators_[g][u];
+        if(!discovered[v]) {
+          discovered[v] = true;
+          representatives_[v] = root;
+          parents_[v] = std::make_pair(g, u);
+          queue.push_back(v);
+        }
+      }
+    }
+  }
+}
+
+unsigned AutomorphismOrbits::size() const {
+  unsigned count = 0;
+  for(AtomIndex i = 0; i < representatives_.size(); ++i) {
+    if(representatives_[i] == i) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+std::vector<AtomIndex> AutomorphismOrbits::automorphism(const AtomIndex i) const {
+  // Collect the generators on the path from the representative to i
+  std::vector<unsigned> path;
+  for(AtomIndex v = i; parents_[v].first != noParent; v = parents_[v].second) {
+    path.push_back(parents_[v].first);
+  }
+
+  const AtomIndex N = representatives_.size();
+  std::vector<AtomIndex> permutation = Temple::iota<AtomIndex>(N);
+  for(auto iter = path.rbegin(); iter != path.rend(); ++iter) {
+    const std::vector<AtomIndex>& generator = generators_[*iter];
+    for(AtomIndex& image : permutation) {
+      image = generator[image];
+    }
+  }
+
+  assert(permutation[representatives_[i]] == i);
+  return permutation;
+}
+
 } // namespace Molassembler
 } // namespace Scine
@@ -22,8 +22,9 @@
 #ifndef INCLUDE_MOLASSEMBLER_GRAPH_CANONICALIZATION_H
 #define INCLUDE_MOLASSEMBLER_GRAPH_CANONICALIZATION_H
 
-#include "boost/multiprecision/cpp_int.hpp"
+#include "Molassembler/Molecule/WideHash.h"
 #include "Molassembler/Types.h"
+#include <limits>
 #include <vector>
 
 namespace Scine {
@@ -31,10 +32,6 @@ namespace Molassembler {
 
 class PrivateGraph;
 
-namespace Hashes {
-using WideHashType = boost::multiprecision::uint128_t;
-} // namespace Hashes
-
 /** @brief Calculate the canonical labeling of a molecule from a coloring
  *   specified by a set of hashes
  *
@@ -62,6 +59,91 @@ std::vector<int> canonicalAutomorphism(
   const std::vector<Hashes::WideHashType>& hashes
 );
 
+/** @brief Whether nauty is built thread-safe, i.e. canonicalAutomorphism and
+ *   automorphismGenerators may be called concurrently
+ *
+ * Requires nauty to be compiled with thread-local storage for its static
+ * workspaces (USE_TLS), as is the bundled nauty. Otherwise, e.g. with a nauty
+ * found as a package, calls into nauty are serialized and concurrent callers
+ * wait on each other.
+ */
+bool threadSafeCanonicalization();
+
+/** @brief Generators of the automorphism group of a molecule's graph,
+ *   restricted by a coloring specified by a set of hashes
+ *
+ * If color refinement of the hashes already distinguishes all vertices, the
+ * group is trivial and nauty is not called.
+ *
+ * @complexity{Same as canonicalAutomorphism}
+ *
+ * @param inner The inner graph representation of a Molecule
+ * @param hashes A flat map of hashes for each vertex
+ *
+ * @throws std::domain_error If the size of mol's graph exceeds the maximum
+ *   value of int.
+ * @throws std::invalid_argument If vector of hashes length does not match
+ *   the molecule's number of vertices.
+ *
+ * @return Vertex permutations generating a group of automorphisms that
+ *   preserve both the coloring and all bond types. Each permutation maps a
+ *   vertex to its image.
+ */
+std::vector<std::vector<AtomIndex>> automorphismGenerators(
+  const PrivateGraph& inner,
+  const std::vector<Hashes::WideHashType>& hashes
+);
+
+/**
+ * @brief Orbits of vertices under a group of automorphisms
+ *
+ * Vertices in the same orbit are symmetry-equivalent. Each orbit is
+ * represented by its smallest vertex, and for each vertex, an automorphism
+ * mapping the representative onto it can be generated.
+ */
+class AutomorphismOrbits {
+public:
+  /*! @brief Determine orbits from group generators
+   *
+   * @complexity{@math{\Theta(NG)} where @math{G} is the number of generators}
+   *
+   * @param N Number of vertices
+   * @param generators Permutations generating the automorphism group
+   */
+  AutomorphismOrbits(AtomIndex N, std::vector<std::vector<AtomIndex>> generators);
+
+  //! Smallest vertex of the orbit of a vertex
+  inline AtomIndex representative(const AtomIndex i) const {
+    return representatives_.at(i);
+  }
+
+  //! Whether a vertex is the smallest vertex of its orbit
+  inline bool isRepresentative(const AtomIndex i) const {
+    return representatives_.at(i) == i;
+  }
+
+  //! Number of orbits
+  unsigned size() const;
+
+  /*! @brief An automorphism mapping the representative of a vertex onto it
+   *
+   * @complexity{@math{\Theta(ND)} where @math{D} is the depth of the vertex
+   * in its orbit's Schreier tree}
+   *
+   * @return Vertex permutation mapping each vertex to its image
+   */
+  std::vector<AtomIndex> automorphism(AtomIndex i) const;
+
+private:
+  static constexpr unsigned noParent = std::numeric_limits<unsigned>::max();
+
+  //! Generators followed by their inverses
+  std::vector<std::vector<AtomIndex>> generators_;
+  std::vector<AtomIndex> representatives_;
+  //! Schreier tree: Generator index and vertex it is applied to
+  std::vector<std::pair<unsigned, AtomIndex>> parents_;
+};
+
 } // namespace Molassembler
 } // namespace Scine
 
@@ -0,0 +1,57 @@
+/*!@file
+ * @copyright This code is licensed under the 3-clause BSD license.
+ *   Copyright ETH Zurich, Laboratory of Physical Chemistry, Reiher Group.
+ *   See LICENSE.txt for details.
+ */
+
+#include "Molassembler/Graph/CsrGraph.h"
+
+#include "Molassembler/Graph/PrivateGraph.h"
+
+#include <stdexcept>
+
+namespace Scine {
+namespace Molassembler {
+
+CsrGraph::CsrGraph() : offsets_ {0} {}
+
+CsrGraph::CsrGraph(const PrivateGraph& graph) {
+  const Vertex N = graph.N();
+  offsets_.reserve(N + 1);
+  adjacents_.reserve(2 * graph.B());
+  bondTypes_.reserve(2 * graph.B());
+  elementTypes_.reserve(N);
+
+  offsets_.push_back(0);
+  for(const Vertex i : graph.vertices()) {
+    elementTypes_.push_back(graph.elementType(i));
+    for(const PrivateGraph::Edge& edge : graph.edges(i)) {
+      adjacents_.push_back(graph.target(edge));
+      bondTypes_.push_back(graph.bondType(edge));
+    }
+    offsets_.push_back(adjacents_.size());
+  }
+}
+
+BondType CsrGraph::bondType(const Vertex a, const Vertex b) const {
+  for(std::size_t i = offsets_[a]; i < offsets_[a + 1]; ++i) {
+    if(adjacents_[i] == b) {
+      return bondTypes_[i];
+    }
+  }
+
+  throw std::out_of_range("Specified edge does not exist in the graph");
+}
+
+bool CsrGraph::adjacent(const Vertex a, const Vertex b) const {
+  for(std::size_t i = offsets_[a]; i < offsets_[a + 1]; ++i) {
+    if(adjacents_[i] == b) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+} // namespace Molassembler
+} // namespace Scine
@@ -0,0 +1,138 @@
+/*!@file
+ * @copyright This code is licensed under the 3-clause BSD license.
+ *   Copyright ETH Zurich, Laboratory of Physical Chemistry, Reiher Group.
+ *   See LICENSE.txt for details.
+ * @brief Immutable compressed sparse row snapshot of a molecular graph
+ */
+
+#ifndef INCLUDE_MOLASSEMBLER_GRAPH_CSR_GRAPH_H
+#define INCLUDE_MOLASSEMBLER_GRAPH_CSR_GRAPH_H
+
+#include "Utils/Geometry/ElementTypes.h"
+
+#include "Molassembler/IteratorRange.h"
+#include "Molassembler/Types.h"
+
+#include <vector>
+
+namespace Scine {
+namespace Molassembler {
+
+// Forward-declarations
+class PrivateGraph;
+
+/**
+ * @brief Frozen compressed sparse row representation of a PrivateGraph
+ *
+ * Adjacencies of all vertices are stored contiguously, with the bond type of
+ * each adjacency stored alongside. Adjacencies of each vertex are in the same
+ * order as in the source graph, so algorithms yield identical results on
+ * either representation.
+ *
+ * Intended for read-only algorithms that traverse the graph heavily. Obtain
+ * it through PrivateGraph::csr(), which caches the snapshot until the graph is
+ * modified.
+ */
+class CsrGraph {
+public:
+//!@name Member types
+//!@{
+  using Vertex = AtomIndex;
+  using AdjacentVertexRange = IteratorRange<std::vector<Vertex>::const_iterator>;
+//!@}
+
+//!@name Constructors
+//!@{
+  //! Empty graph
+  CsrGraph();
+
+  /*! @brief Snapshot of a graph
+   *
+   * @complexity{@math{\Theta(V + E)}}
+   */
+  explicit CsrGraph(const PrivateGraph& graph);
+//!@}
+
+//!@name Information
+//!@{
+  //! Number of vertices
+  inline Vertex N() const {
+    return elementTypes_.size();
+  }
+
+  //! Number of edges
+  inline Vertex B() const {
+    return adjacents_.size() / 2;
+  }
+
+  /*! @brief Number of substituents of a vertex
+   *
+   * @complexity{@math{\Theta(1)}}
+   */
+  inline Vertex degree(const Vertex a) const {
+    return offsets_[a + 1] - offsets_[a];
+  }
+
+  /*! @brief Element type of a vertex
+   *
+   * @complexity{@math{\Theta(1)}}
+   */
+  inline Utils::ElementType elementType(const Vertex a) const {
+    return elementTypes_[a];
+  }
+
+  /*! @brief Bond type between two vertices
+   *
+   * @complexity{@math{O(S)} where @math{S} is the degree of @p a}
+   * @throws std::out_of_range if the vertices are not adjacent
+   */
+  BondType bondType(Vertex a, Vertex b) const;
+
+  /*! @brief Whether two vertices are adjacent
+   *
+   * @complexity{@math{O(S)} where @math{S} is the degree of @p a}
+   */
+  bool adjacent(Vertex a, Vertex b) const;
+
+  /*! @brief Start index of each vertex's adjacencies
+   *
+   * Has @math{V + 1} entries. The adjacencies of vertex @math{i} are at
+   * indices @math{[o_i, o_{i + 1})} of adjacents() and bondTypes().
+   */
+  inline const std::vector<std::size_t>& offsets() const {
+    return offsets_;
+  }
+
+  //! Concatenated adjacencies of all vertices
+  inline const std::vector<Vertex>& adjacents() const {
+    return adjacents_;
+  }
+
+  //! Bond type for each entry of adjacents()
+  inline const std::vector<BondType>& bondTypes() const {
+    return bondTypes_;
+  }
+//!@}
+
+//!@name Ranges
+//!@{
+  //! Adjacent vertices of a vertex
+  inline AdjacentVertexRange adjacents(const Vertex a) const {
+    return {
+      std::begin(adjacents_) + offsets_[a],
+      std::begin(adjacents_) + offsets_[a + 1]
+    };
+  }
+//!@}
+
+private:
+  std::vector<std::size_t> offsets_;
+  std::vector<Vertex> adjacents_;
+  std::vector<BondType> bondTypes_;
+  std::vector<Utils::ElementType> elementTypes_;
+};
+
+} // namespace Molassembler
+} // namespace Scine
+
+#endif
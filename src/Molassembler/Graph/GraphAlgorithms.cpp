@@ -6,9 +6,6 @@
 
 #include "Molassembler/Graph/GraphAlgorithms.h"
 
-#include "boost/graph/visitors.hpp"
-#include "boost/graph/named_function_params.hpp"
-#include "boost/graph/breadth_first_search.hpp"
 #include "boost/graph/connected_components.hpp"
 #include "boost/graph/biconnected_components.hpp"
 #include "boost/range/combine.hpp"
@@ -282,11 +279,12 @@ void findSites(
   const AtomIndex placement,
   const std::function<void(const std::vector<AtomIndex>&)>& callback
 ) {
-  const unsigned A = graph.degree(placement);
+  const CsrGraph& csr = graph.csr();
+  const unsigned A = csr.degree(placement);
   Temple::TinySet<PrivateGraph::Vertex> centralAdjacents;
   centralAdjacents.reserve(A);
 
-  for(const PrivateGraph::Vertex adjacent : graph.adjacents(placement)) {
+  for(const PrivateGraph::Vertex adjacent : csr.adjacents(placement)) {
     centralAdjacents.insert(adjacent);
   }
 
@@ -296,7 +294,7 @@ void findSites(
 
   std::function<void(const PrivateGraph::Vertex)> recursiveDiscover
   = [&](const PrivateGraph::Vertex seed) {
-    for(const PrivateGraph::Vertex adjacent : graph.adjacents(seed)) {
+    for(const PrivateGraph::Vertex adjacent : csr.adjacents(seed)) {
       if(centralAdjacents.count(adjacent) > 0 && site.count(adjacent) == 0) {
         // *iter is shared adjacent of center and seed and not yet discovered
         site.insert(adjacent);
@@ -333,17 +331,19 @@ std::vector<
   AtomIndex placement,
   const std::vector<AtomIndex>& excludeAdjacents
 ) {
-  if(AtomInfo::isMainGroupElement(graph.elementType(placement))) {
+  const CsrGraph& csr = graph.csr();
+  if(AtomInfo::isMainGroupElement(csr.elementType(placement))) {
     std::vector<
       std::vector<AtomIndex>
     > adjacents;
 
-    adjacents.reserve(graph.degree(placement));
+    adjacents.reserve(csr.degree(placement));
 
-    for(const AtomIndex centralAdjacent : graph.adjacents(placement)) {
-      auto edge = graph.edge(centralAdjacent, placement);
+    const auto& offsets = csr.offsets();
+    for(std::size_t i = offsets[placement]; i < offsets[placement + 1]; ++i) {
+      const AtomIndex centralAdjacent = csr.adjacents()[i];
 
-      if(graph.bondType(edge) == BondType::Eta) {
+      if(csr.bondTypes()[i] == BondType::Eta) {
         /* A non-metal central index can have eta bonds, but they are not
          * considered in that atom's modeling, i.e. they do not form part of
          * their coordinate sphere.
@@ -351,7 +351,7 @@ std::vector<
          * We determine whether the edge is mislabeled: Is the other vertex a
          * non-main-group element?
          */
-        if(AtomInfo::isMainGroupElement(graph.elementType(centralAdjacent))) {
+        if(AtomInfo::isMainGroupElement(csr.elementType(centralAdjacent))) {
           std::string error = "Two main group elements are connected by an eta bond! ";
           error += std::to_string(centralAdjacent);
           error += " and ";
@@ -395,8 +395,7 @@ std::vector<
       // Make sure all bonds are marked properly
       if(isHapticSite(ligand, graph)) {
         for(const auto& hapticIndex : ligand) {
-          auto edge = graph.edge(placement, hapticIndex);
-          if(graph.bondType(edge) != BondType::Eta) {
+          if(csr.bondType(placement, hapticIndex) != BondType::Eta) {
             throw std::logic_error(
               "Haptic ligand constituting atom bound to non-main-group element via non-eta bond"
             );
@@ -404,8 +403,7 @@ std::vector<
         }
       } else {
         for(const auto& nonHapticIndex : ligand) {
-          auto edge = graph.edge(placement, nonHapticIndex);
-          if(graph.bondType(edge) == BondType::Eta) {
+          if(csr.bondType(placement, nonHapticIndex) == BondType::Eta) {
             throw std::logic_error(
               "Non-haptic ligand bound to non-main-group element via eta bond"
             );
@@ -440,52 +438,79 @@ std::vector<
 }
 
 void updateEtaBonds(PrivateGraph& graph) {
-  const AtomIndex N = graph.N();
+  /* Collect bond type changes and apply them afterwards. Site determination
+   * does not depend on bond types and can then proceed on an unmodified
+   * graph snapshot.
+   */
+  const PrivateGraph& unmodified = graph;
+  std::map<PrivateGraph::Edge, BondType> bondTypeChanges;
+  auto currentBondType = [&](const PrivateGraph::Edge& edge) -> BondType {
+    const auto findIter = bondTypeChanges.find(edge);
+    if(findIter != std::end(bondTypeChanges)) {
+      return findIter->second;
+    }
+
+    return unmodified.bondType(edge);
+  };
+
+  const AtomIndex N = unmodified.N();
   for(AtomIndex placement = 0; placement < N; ++placement) {
     // Skip any main group element types, none of these should be eta bonded
-    if(AtomInfo::isMainGroupElement(graph.elementType(placement))) {
+    if(AtomInfo::isMainGroupElement(unmodified.elementType(placement))) {
       continue;
     }
 
     findSites(
-      graph,
+      unmodified,
       placement,
       [&](const std::vector<AtomIndex>& ligand) -> void {
-        if(isHapticSite(ligand, graph)) {
+        if(isHapticSite(ligand, unmodified)) {
           // Mark all bonds to the central atom as haptic bonds
           for(const auto& hapticIndex : ligand) {
-            auto edge = graph.edge(placement, hapticIndex);
-            graph.bondType(edge) = BondType::Eta;
+            bondTypeChanges[unmodified.edge(placement, hapticIndex)] = BondType::Eta;
           }
         } else {
           // Mark all eta bonds to the central atom as single bonds
           for(const auto& hapticIndex : ligand) {
-            auto edge = graph.edge(placement, hapticIndex);
-            BondType& bondType = graph.bondType(edge);
-            if(bondType == BondType::Eta) {
-              bondType = BondType::Single;
+            auto edge = unmodified.edge(placement, hapticIndex);
+            if(currentBondType(edge) == BondType::Eta) {
+              bondTypeChanges[edge] = BondType::Single;
             }
           }
         }
       }
     );
   }
+
+  for(const auto& change : bondTypeChanges) {
+    if(unmodified.bondType(change.first) != change.second) {
+      graph.bondType(change.first) = change.second;
+    }
+  }
 }
 
 std::vector<unsigned> distance(AtomIndex a, const PrivateGraph& graph) {
   assert(a < graph.N());
 
-  std::vector<unsigned> distances (graph.N(), 0);
-
-  boost::breadth_first_search(
-    graph.bgl(),
-    a,
-    boost::visitor(
-      boost::make_bfs_visitor(
-        boost::record_distances(&distances[0], boost::on_tree_edge {})
-      )
-    )
-  );
+  const CsrGraph& csr = graph.csr();
+  std::vector<unsigned> distances (csr.N(), 0);
+  std::vector<bool> discovered (csr.N(), false);
+
+  // Breadth-first search with a flat queue
+  std::vector<AtomIndex> queue;
+  queue.reserve(csr.N());
+  queue.push_back(a);
+  discovered[a] = true;
+  for(std::size_t head = 0; head < queue.size(); ++head) {
+    const AtomIndex i = queue[head];
+    for(const AtomIndex j : csr.adjacents(i)) {
+      if(!discovered[j]) {
+        discovered[j] = true;
+        distances[j] = distances[i] + 1;
+        queue.push_back(j);
+      }
+    }
+  }
 
   return distances;
 }
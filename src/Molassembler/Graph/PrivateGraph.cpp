@@ -16,6 +16,8 @@
 
 #include "Molassembler/Temple/Functional.h"
 
+#include <numeric>
+
 namespace Scine {
 namespace Molassembler {
 namespace {
@@ -69,30 +71,46 @@ struct BridgeSplittingBFSVisitor {
 constexpr PrivateGraph::Vertex PrivateGraph::removalPlaceholder;
 
 /* Constructors */
-PrivateGraph::PrivateGraph() = default;
-PrivateGraph::PrivateGraph(const PrivateGraph::Vertex N) : graph_ {N} {}
+PrivateGraph::PrivateGraph() : graph_(emptyGraph_()) {}
+PrivateGraph::PrivateGraph(const PrivateGraph::Vertex N)
+  : graph_(std::make_shared<BglType>(N)) {}
 
 /* Rule of five members */
 /* Implementation note
  *
- * Copying the graph invalidates any stored edge_descriptors in the properties
- * since the copied graph is now elsewhere in memory and edge_descriptor's
- * property member is no longer correct, leading to subtle bugs.
+ * Copies share the BGL graph and the cached properties. Edge descriptors
+ * carry a pointer into the BGL graph they refer to, so removal safety data
+ * stays valid as long as the BGL graph is shared. Once a copy is modified, it
+ * detaches its BGL graph and maps the removal safety data onto the new edge
+ * descriptors. It also duplicates the components, which are modified in
+ * place. Cycle data and the compressed sparse row snapshot refer only to
+ * vertex indices.
  *
- * Moving the graph does not invalidate descriptors since the graph does
- * not change location in memory.
+ * Moved-from instances are left with the shared empty graph.
  */
-PrivateGraph::PrivateGraph(const PrivateGraph& other) : graph_(other.graph_) {}
-PrivateGraph::PrivateGraph(PrivateGraph&& other) = default;
-
-PrivateGraph& PrivateGraph::operator = (const PrivateGraph& other) {
-  graph_ = other.graph_;
-  properties_.invalidate();
-  return *this;
-}
+PrivateGraph::PrivateGraph(const PrivateGraph& other) = default;
+PrivateGraph::PrivateGraph(PrivateGraph&& other)
+  : graph_(std::move(other.graph_)),
+    duplicatedStorage_(other.duplicatedStorage_),
+    properties_(std::move(other.properties_))
+{
+  other.graph_ = emptyGraph_();
+  other.duplicatedStorage_ = false;
+  other.properties_.invalidate();
+}
+
+PrivateGraph& PrivateGraph::operator = (const PrivateGraph& other) = default;
 PrivateGraph& PrivateGraph::operator = (PrivateGraph&& other) noexcept {
+  if(this == &other) {
+    return *this;
+  }
+
   graph_ = std::move(other.graph_);
+  duplicatedStorage_ = other.duplicatedStorage_;
   properties_ = std::move(other.properties_);
+  other.graph_ = emptyGraph_();
+  other.duplicatedStorage_ = false;
+  other.properties_.invalidate();
   return *this;
 }
 PrivateGraph::~PrivateGraph() = default;
@@ -102,98 +120,196 @@ PrivateGraph::Edge PrivateGraph::addEdge(const Vertex a, const Vertex b, const B
   /* We have to be careful here since the edge list for a vector is not a set
    * (see BglType).  Check if there is already such an edge before adding it.
    */
-  auto existingEdgePair = boost::edge(a, b, graph_);
+  auto existingEdgePair = boost::edge(a, b, *graph_);
   if(existingEdgePair.second) {
     throw std::logic_error("Edge already exists!");
   }
 
-  // Invalidate the cache only after all throwing conditions
-  properties_.invalidate();
+  detach_();
+
+  /* An edge joining two connected components is a bridge and closes no
+   * cycle. Cached data can be kept and updated locally. Decide this only after
+   * all throwing conditions.
+   */
+  bool isBridge = false;
+  if(!properties_.empty()) {
+    Components& components = components_();
+    isBridge = (components.find(a) != components.find(b));
+    if(isBridge) {
+      components.join(a, b);
+    }
+  }
+  if(!isBridge) {
+    properties_.invalidate();
+  }
+  properties_.csrPtr.reset();
 
-  auto newBondPair = boost::add_edge(a, b, graph_);
+  auto newBondPair = boost::add_edge(a, b, *graph_);
 
   // The bond may not yet exist
   assert(newBondPair.second);
-  graph_[newBondPair.first].bondType = bondType;
+  (*graph_)[newBondPair.first].bondType = bondType;
+
+  if(isBridge && properties_.removalSafetyDataPtr) {
+    RemovalSafetyData& safetyData = *properties_.removalSafetyDataPtr;
+    safetyData.bridges.insert(newBondPair.first);
+    for(const Vertex v : {a, b}) {
+      if(++safetyData.blockCounts.at(v) >= 2) {
+        safetyData.articulationVertices.insert(v);
+      }
+    }
+  }
 
   return newBondPair.first;
 }
 
 PrivateGraph::Vertex PrivateGraph::addVertex(const Utils::ElementType elementType) {
-  // Invalidate the cache values
-  properties_.invalidate();
+  /* A disconnected vertex is part of no cycle and no biconnected component.
+   * Cycle data yields nothing for vertices beyond its range.
+   */
+  detach_();
+  properties_.csrPtr.reset();
+  if(properties_.removalSafetyDataPtr) {
+    properties_.removalSafetyDataPtr->blockCounts.push_back(0);
+  }
 
-  PrivateGraph::Vertex newVertex = boost::add_vertex(graph_);
-  graph_[newVertex].elementType = elementType;
+  PrivateGraph::Vertex newVertex = boost::add_vertex(*graph_);
+  if(properties_.componentsPtr) {
+    properties_.componentsPtr->parents.push_back(newVertex);
+  }
+  (*graph_)[newVertex].elementType = elementType;
   return newVertex;
 }
 
 void PrivateGraph::applyPermutation(const std::vector<Vertex>& permutation) {
-  // Invalidate the cache
-  properties_.invalidate();
+  /* Cycle data shares the ring decomposition with unpermuted copies and
+   * translates vertex indices. Removal safety data is mapped after the
+   * permutation.
+   */
+  auto permuteCycles = [&](std::shared_ptr<const Cycles>& cyclesPtr) {
+    if(cyclesPtr) {
+      auto permuted = std::make_shared<Cycles>(*cyclesPtr);
+      permuted->applyPermutation(permutation);
+      cyclesPtr = std::move(permuted);
+    }
+  };
+  permuteCycles(properties_.cyclesPtr);
+  permuteCycles(properties_.etaPreservedCyclesPtr);
+  properties_.csrPtr.reset();
+  std::shared_ptr<RemovalSafetyData> safetyDataPtr = std::move(properties_.removalSafetyDataPtr);
+  properties_.removalSafetyDataPtr.reset();
+  if(properties_.componentsPtr) {
+    auto permuted = std::make_shared<Components>();
+    const auto& parents = properties_.componentsPtr->parents;
+    permuted->parents.resize(parents.size());
+    for(Vertex v = 0; v < parents.size(); ++v) {
+      permuted->parents.at(permutation.at(v)) = permutation.at(parents.at(v));
+    }
+    properties_.componentsPtr = std::move(permuted);
+  }
 
-  BglType transformedGraph(boost::num_vertices(graph_));
+  // The permuted graph is always new storage, so no detaching is necessary
+  auto transformedGraph = std::make_shared<BglType>(boost::num_vertices(*graph_));
 
   /* I failed to get copy_graph to perform the permutation for me, so we copy
    * manually:
    */
   for(Vertex i : vertices()) {
-    transformedGraph[permutation.at(i)].elementType = graph_[i].elementType;
+    (*transformedGraph)[permutation.at(i)].elementType = (*graph_)[i].elementType;
   }
 
   for(Edge e : edges()) {
     auto newBondPair = boost::add_edge(
-      permutation.at(boost::source(e, graph_)),
-      permutation.at(boost::target(e, graph_)),
-      transformedGraph
+      permutation.at(boost::source(e, *graph_)),
+      permutation.at(boost::target(e, *graph_)),
+      *transformedGraph
     );
 
-    transformedGraph[newBondPair.first].bondType = graph_[e].bondType;
+    (*transformedGraph)[newBondPair.first].bondType = (*graph_)[e].bondType;
   }
 
   std::swap(graph_, transformedGraph);
+
+  if(safetyDataPtr) {
+    properties_.removalSafetyDataPtr = std::make_shared<RemovalSafetyData>(
+      mapRemovalSafetyData_(
+        *safetyDataPtr,
+        permutation,
+        *transformedGraph
+      )
+    );
+  }
 }
 
 BondType& PrivateGraph::bondType(const PrivateGraph::Edge& edge) {
-  // Invalidate the cache values
-  properties_.invalidate();
+  /* Bond types do not affect removal safety. Cycles only depend on whether a
+   * bond is an eta bond, which is irrelevant for bridges.
+   */
+  detach_();
+  const Edge e = ownEdge_(edge);
+  if(!isCachedBridge_(e)) {
+    properties_.invalidateCycles();
+  }
+  properties_.csrPtr.reset();
 
-  return graph_[edge].bondType;
+  return (*graph_)[e].bondType;
 }
 
 void PrivateGraph::clearVertex(Vertex a) {
   // Invalidate the cache values
   properties_.invalidate();
 
-  boost::clear_vertex(a, graph_);
+  detach_();
+  boost::clear_vertex(a, *graph_);
 }
 
-void PrivateGraph::removeEdge(const Edge& e) {
-  // Invalidate the cache values
-  properties_.invalidate();
+void PrivateGraph::removeEdge(const Edge& edge) {
+  detach_();
+  const Edge e = ownEdge_(edge);
+
+  /* Removing a bridge opens no cycle. Removal safety data can be updated
+   * locally.
+   */
+  if(isCachedBridge_(e)) {
+    RemovalSafetyData& safetyData = *properties_.removalSafetyDataPtr;
+    safetyData.bridges.erase(e);
+    for(const Vertex v : {source(e), target(e)}) {
+      if(--safetyData.blockCounts.at(v) < 2) {
+        safetyData.articulationVertices.erase(v);
+      }
+    }
+    // Disjoint set forests cannot be split
+    properties_.componentsPtr.reset();
+  } else {
+    properties_.invalidate();
+  }
+  properties_.csrPtr.reset();
 
-  boost::remove_edge(e, graph_);
+  boost::remove_edge(e, *graph_);
 }
 
 void PrivateGraph::removeVertex(Vertex a) {
   // Invalidate the cache values
   properties_.invalidate();
 
-  boost::remove_vertex(a, graph_);
+  detach_();
+  boost::remove_vertex(a, *graph_);
 }
 
 Utils::ElementType& PrivateGraph::elementType(const Vertex a) {
-  // Invalidate the cache values
-  properties_.invalidate();
+  // Element types only affect the compressed sparse row snapshot
+  properties_.csrPtr.reset();
 
-  return graph_[a].elementType;
+  detach_();
+  return (*graph_)[a].elementType;
 }
 
 PrivateGraph::BglType& PrivateGraph::bgl() {
   // Invalidate the cache values
   properties_.invalidate();
 
-  return graph_;
+  detach_();
+  return *graph_;
 }
 
 /* Information */
@@ -216,22 +332,22 @@ bool PrivateGraph::canRemove(const Edge& edge) const {
   // Make sure the edge exists in the first place
   assert(
     boost::edge(
-      boost::source(edge, graph_),
-      boost::target(edge, graph_),
-      graph_
+      boost::source(edge, *graph_),
+      boost::target(edge, *graph_),
+      *graph_
     ).second
   );
 
   const auto& bridges = removalSafetyData().bridges;
 
   // Removable if the edge is not a bridge
-  return bridges.count(edge) == 0;
+  return bridges.count(ownEdge_(edge)) == 0;
 }
 
 /* Information */
 unsigned PrivateGraph::connectedComponents() const {
   std::vector<unsigned> componentMap(N());
-  return boost::connected_components(graph_, &componentMap[0]);
+  return boost::connected_components(*graph_, &componentMap[0]);
 }
 
 unsigned PrivateGraph::connectedComponents(std::vector<unsigned>& componentMap) const {
@@ -240,19 +356,19 @@ unsigned PrivateGraph::connectedComponents(std::vector<unsigned>& componentMap)
   if(componentMap.size() != size) {
     componentMap.resize(size);
   }
-  return boost::connected_components(graph_, &componentMap[0]);
+  return boost::connected_components(*graph_, &componentMap[0]);
 }
 
 BondType PrivateGraph::bondType(const PrivateGraph::Edge& edge) const {
-  return graph_[edge].bondType;
+  return (*graph_)[ownEdge_(edge)].bondType;
 }
 
 Utils::ElementType PrivateGraph::elementType(const Vertex a) const {
-  return graph_[a].elementType;
+  return (*graph_)[a].elementType;
 }
 
 PrivateGraph::Edge PrivateGraph::edge(const Vertex a, const Vertex b) const {
-  auto edge = boost::edge(a, b, graph_);
+  auto edge = boost::edge(a, b, *graph_);
 
   if(!edge.second) {
     throw std::out_of_range("Specified edge does not exist in the graph");
@@ -262,7 +378,7 @@ PrivateGraph::Edge PrivateGraph::edge(const Vertex a, const Vertex b) const {
 }
 
 boost::optional<PrivateGraph::Edge> PrivateGraph::edgeOption(const Vertex a, const Vertex b) const {
-  auto edge = boost::edge(a, b, graph_);
+  auto edge = boost::edge(a, b, *graph_);
 
   if(edge.second) {
     return edge.first;
@@ -272,23 +388,23 @@ boost::optional<PrivateGraph::Edge> PrivateGraph::edgeOption(const Vertex a, con
 }
 
 PrivateGraph::Vertex PrivateGraph::source(const PrivateGraph::Edge& edge) const {
-  return boost::source(edge, graph_);
+  return boost::source(edge, *graph_);
 }
 
 PrivateGraph::Vertex PrivateGraph::target(const PrivateGraph::Edge& edge) const {
-  return boost::target(edge, graph_);
+  return boost::target(edge, *graph_);
 }
 
 PrivateGraph::Vertex PrivateGraph::degree(const PrivateGraph::Vertex a) const {
-  return boost::out_degree(a, graph_);
+  return boost::out_degree(a, *graph_);
 }
 
 PrivateGraph::Vertex PrivateGraph::N() const {
-  return boost::num_vertices(graph_);
+  return boost::num_vertices(*graph_);
 }
 
 PrivateGraph::Vertex PrivateGraph::B() const {
-  return boost::num_edges(graph_);
+  return boost::num_edges(*graph_);
 }
 
 boost::optional<std::vector<AtomIndex>> PrivateGraph::modularIsomorphism(
@@ -344,9 +460,9 @@ bool PrivateGraph::identicalGraph(const PrivateGraph& other) const {
       Edge correspondingEdge;
       bool edgeExists;
       std::tie(correspondingEdge, edgeExists) = boost::edge(
-        boost::source(edge, graph_),
-        boost::target(edge, graph_),
-        other.graph_
+        boost::source(edge, *graph_),
+        boost::target(edge, *graph_),
+        *other.graph_
       );
 
       return edgeExists;
@@ -357,7 +473,8 @@ bool PrivateGraph::identicalGraph(const PrivateGraph& other) const {
 std::pair<
   std::vector<AtomIndex>,
   std::vector<AtomIndex>
-> PrivateGraph::splitAlongBridge(Edge bridge) const {
+> PrivateGraph::splitAlongBridge(Edge edge) const {
+  const Edge bridge = ownEdge_(edge);
   if(removalSafetyData().bridges.count(bridge) == 0) {
     throw std::invalid_argument("The supplied edge is not a bridge edge");
   }
@@ -365,10 +482,10 @@ std::pair<
   auto bitsetPtr = std::make_shared<
     std::vector<bool>
   >();
-  BridgeSplittingBFSVisitor visitor(bridge, graph_, bitsetPtr);
+  BridgeSplittingBFSVisitor visitor(bridge, *graph_, bitsetPtr);
 
   boost::breadth_first_search(
-    graph_,
+    *graph_,
     target(bridge),
     boost::visitor(visitor)
   );
@@ -397,7 +514,7 @@ std::pair<
 }
 
 PrivateGraph::VertexRange PrivateGraph::vertices() const {
-  auto iters = boost::vertices(graph_);
+  auto iters = boost::vertices(*graph_);
   return {
     std::move(iters.first),
     std::move(iters.second)
@@ -405,7 +522,7 @@ PrivateGraph::VertexRange PrivateGraph::vertices() const {
 }
 
 PrivateGraph::EdgeRange PrivateGraph::edges() const {
-  auto iters = boost::edges(graph_);
+  auto iters = boost::edges(*graph_);
   return {
     std::move(iters.first),
     std::move(iters.second)
@@ -413,7 +530,7 @@ PrivateGraph::EdgeRange PrivateGraph::edges() const {
 }
 
 PrivateGraph::AdjacentVertexRange PrivateGraph::adjacents(const Vertex a) const {
-  auto iters = boost::adjacent_vertices(a, graph_);
+  auto iters = boost::adjacent_vertices(a, *graph_);
   return {
     std::move(iters.first),
     std::move(iters.second)
@@ -421,13 +538,17 @@ PrivateGraph::AdjacentVertexRange PrivateGraph::adjacents(const Vertex a) const
 }
 
 PrivateGraph::IncidentEdgeRange PrivateGraph::edges(const Vertex a) const {
-  auto iters = boost::out_edges(a, graph_);
+  auto iters = boost::out_edges(a, *graph_);
   return {
     std::move(iters.first),
     std::move(iters.second)
   };
 }
 
+bool PrivateGraph::sharesStorage(const PrivateGraph& other) const {
+  return graph_ == other.graph_;
+}
+
 bool PrivateGraph::operator == (const PrivateGraph& other) const {
   // Better with newer boost: has_value()
   return static_cast<bool>(
@@ -436,40 +557,161 @@ bool PrivateGraph::operator == (const PrivateGraph& other) const {
 }
 
 const PrivateGraph::BglType& PrivateGraph::bgl() const {
-  return graph_;
+  return *graph_;
 }
 
 void PrivateGraph::populateProperties() const {
-  if(!properties_.removalSafetyDataOption) {
-    properties_.removalSafetyDataOption = generateRemovalSafetyData_();
-  }
-  if(!properties_.cyclesOption) {
-    properties_.cyclesOption = generateCycles_();
-  }
+  removalSafetyData();
+  cycles();
+  etaPreservedCycles();
+  csr();
 }
 
 const PrivateGraph::RemovalSafetyData& PrivateGraph::removalSafetyData() const {
-  if(!properties_.removalSafetyDataOption) {
-    properties_.removalSafetyDataOption = generateRemovalSafetyData_();
+  if(!properties_.removalSafetyDataPtr) {
+    properties_.removalSafetyDataPtr = std::make_shared<RemovalSafetyData>(
+      generateRemovalSafetyData_()
+    );
   }
 
-  return *properties_.removalSafetyDataOption;
+  return *properties_.removalSafetyDataPtr;
 }
 
 const Cycles& PrivateGraph::cycles() const {
-  if(!properties_.cyclesOption) {
-    properties_.cyclesOption = generateCycles_();
+  if(!properties_.cyclesPtr) {
+    properties_.cyclesPtr = std::make_shared<Cycles>(generateCycles_());
   }
 
-  return *properties_.cyclesOption;
+  return *properties_.cyclesPtr;
 }
 
 const Cycles& PrivateGraph::etaPreservedCycles() const {
-  if(!properties_.etaPreservedCyclesOption) {
-    properties_.etaPreservedCyclesOption = generateEtaPreservedCycles_();
+  if(!properties_.etaPreservedCyclesPtr) {
+    properties_.etaPreservedCyclesPtr = std::make_shared<Cycles>(
+      generateEtaPreservedCycles_()
+    );
+  }
+
+  return *properties_.etaPreservedCyclesPtr;
+}
+
+const CsrGraph& PrivateGraph::csr() const {
+  if(!properties_.csrPtr) {
+    properties_.csrPtr = std::make_shared<CsrGraph>(*this);
   }
 
-  return *properties_.etaPreservedCyclesOption;
+  return *properties_.csrPtr;
+}
+
+const std::shared_ptr<PrivateGraph::BglType>& PrivateGraph::emptyGraph_() {
+  static const std::shared_ptr<BglType> empty = std::make_shared<BglType>();
+  return empty;
+}
+
+void PrivateGraph::detach_() {
+  if(graph_.use_count() == 1) {
+    return;
+  }
+
+  const std::shared_ptr<BglType> shared = std::move(graph_);
+  graph_ = std::make_shared<BglType>(*shared);
+  duplicatedStorage_ = true;
+  if(properties_.componentsPtr) {
+    properties_.componentsPtr = std::make_shared<Components>(*properties_.componentsPtr);
+  }
+  if(properties_.removalSafetyDataPtr) {
+    properties_.removalSafetyDataPtr = std::make_shared<RemovalSafetyData>(
+      mapRemovalSafetyData_(*properties_.removalSafetyDataPtr, {}, *shared)
+    );
+  }
+}
+
+PrivateGraph::Edge PrivateGraph::ownEdge_(const Edge& e) const {
+  /* Without duplication, every descriptor fetched from this graph points into
+   * the current BGL graph
+   */
+  if(!duplicatedStorage_) {
+    return e;
+  }
+
+  // Endpoints are stored in the descriptor itself
+  return edge(boost::source(e, *graph_), boost::target(e, *graph_));
+}
+
+bool PrivateGraph::isCachedBridge_(const Edge& edge) const {
+  return (
+    properties_.removalSafetyDataPtr
+    && properties_.removalSafetyDataPtr->bridges.count(edge) > 0
+  );
+}
+
+PrivateGraph::Components& PrivateGraph::components_() const {
+  if(!properties_.componentsPtr) {
+    auto componentsPtr = std::make_shared<Components>();
+    componentsPtr->parents.resize(N());
+    std::iota(std::begin(componentsPtr->parents), std::end(componentsPtr->parents), Vertex {0});
+    for(const Edge& e : edges()) {
+      componentsPtr->join(source(e), target(e));
+    }
+    properties_.componentsPtr = std::move(componentsPtr);
+  }
+
+  return *properties_.componentsPtr;
+}
+
+PrivateGraph::Vertex PrivateGraph::Components::find(Vertex v) {
+  while(parents[v] != v) {
+    parents[v] = parents[parents[v]];
+    v = parents[v];
+  }
+
+  return v;
+}
+
+void PrivateGraph::Components::join(const Vertex a, const Vertex b) {
+  const Vertex aRoot = find(a);
+  const Vertex bRoot = find(b);
+  // Attach the larger root index to the smaller to keep roots stable
+  if(aRoot < bRoot) {
+    parents[bRoot] = aRoot;
+  } else if(bRoot < aRoot) {
+    parents[aRoot] = bRoot;
+  }
+}
+
+PrivateGraph::RemovalSafetyData PrivateGraph::mapRemovalSafetyData_(
+  const RemovalSafetyData& data,
+  const std::vector<Vertex>& permutation,
+  const BglType& other
+) const {
+  auto map = [&](const Vertex v) -> Vertex {
+    if(permutation.empty()) {
+      return v;
+    }
+
+    return permutation.at(v);
+  };
+
+  RemovalSafetyData mapped;
+  for(const Vertex v : data.articulationVertices) {
+    mapped.articulationVertices.insert(map(v));
+  }
+
+  for(const Edge& bridge : data.bridges) {
+    mapped.bridges.insert(
+      edge(
+        map(boost::source(bridge, other)),
+        map(boost::target(bridge, other))
+      )
+    );
+  }
+
+  mapped.blockCounts.resize(data.blockCounts.size());
+  for(Vertex v = 0; v < data.blockCounts.size(); ++v) {
+    mapped.blockCounts.at(map(v)) = data.blockCounts.at(v);
+  }
+
+  return mapped;
 }
 
 PrivateGraph::RemovalSafetyData PrivateGraph::generateRemovalSafetyData_() const {
@@ -485,7 +727,7 @@ PrivateGraph::RemovalSafetyData PrivateGraph::generateRemovalSafetyData_() const
 
   // Calculate the biconnected components and articulation vertices
   std::tie(numComponents, std::ignore) = boost::biconnected_components(
-    graph_,
+    *graph_,
     componentMap,
     std::back_inserter(articulationVertices)
   );
@@ -517,6 +759,18 @@ PrivateGraph::RemovalSafetyData PrivateGraph::generateRemovalSafetyData_() const
     }
   }
 
+  // Count the biconnected components each vertex is part of
+  std::vector<std::set<std::size_t>> vertexComponents(N());
+  for(const auto& mapIterPair : componentMapData) {
+    const auto& edge = mapIterPair.first;
+    vertexComponents.at(source(edge)).insert(mapIterPair.second);
+    vertexComponents.at(target(edge)).insert(mapIterPair.second);
+  }
+  safetyData.blockCounts.reserve(N());
+  for(const auto& components : vertexComponents) {
+    safetyData.blockCounts.push_back(components.size());
+  }
+
   return safetyData;
 }
 
@@ -12,14 +12,21 @@
 #include "Utils/Geometry/ElementTypes.h"
 
 #include "Molassembler/Cycles.h"
+#include "Molassembler/Graph/CsrGraph.h"
 
 #include <limits>
+#include <memory>
 
 namespace Scine {
 namespace Molassembler {
 
 /**
  * @brief Library internal graph class wrapping BGL types
+ *
+ * Copies share the underlying BGL graph and any cached properties. The BGL
+ * graph is duplicated only on the first modification of a copy, and cached
+ * properties are immutable once generated and are replaced instead of altered.
+ * Copying is therefore @math{\Theta(1)}.
  */
 class PrivateGraph {
 public:
@@ -85,6 +92,12 @@ public:
     std::unordered_set<PrivateGraph::Vertex> articulationVertices;
     //! Bridges are edges that cannot be removed without disconnecting the graph
     std::set<PrivateGraph::Edge> bridges;
+    /*! @brief Number of biconnected components each vertex is part of
+     *
+     * Vertices part of more than one biconnected component are articulation
+     * vertices. Allows local updates on bridge edge insertion and removal.
+     */
+    std::vector<unsigned> blockCounts;
   };
 //!@}
 
@@ -179,7 +192,11 @@ public:
   Utils::ElementType elementType(Vertex a) const;
   /** @brief Fetch the bond type of an edge
    *
-   * @complexity{@math{\Theta(1)}}
+   * The edge descriptor may have been fetched from this graph before it was
+   * detached from its copies.
+   *
+   * @complexity{@math{\Theta(1)}, linear in the degree of the edge's source
+   *   if this graph was ever detached from its copies}
    * @pre The edge exists
    */
   BondType bondType(const Edge& edge) const;
@@ -198,7 +215,8 @@ public:
    */
   bool canRemove(Vertex a) const;
   /*! @brief Determine whether an edge can be safely removed
-   * An edge can be safely removed if it is not a bridge edge
+   * An edge can be safely removed if it is not a bridge edge. As for
+   * bondType(), the edge descriptor may have been fetched before detaching.
    *
    * @complexity{@math{O(V)} worst case, if removal data is cached
    * @math{\Theta(1)}}
@@ -248,6 +266,12 @@ public:
   //! Number of edges in the graph
   Vertex B() const;
 
+  /*! @brief Whether this graph shares its BGL graph with a copy
+   *
+   * @complexity{@math{\Theta(1)}}
+   */
+  bool sharesStorage(const PrivateGraph& other) const;
+
   /*! @brief Modular isomorphism comparison
    *
    * Returns None if the molecules are not isomorphic. Returns an index mapping
@@ -265,6 +289,9 @@ public:
   bool identicalGraph(const PrivateGraph& other) const;
 
   /*! @brief Determine which vertices belong to which side of a bridge edge
+   *
+   * As for bondType(), the edge descriptor may have been fetched before
+   * detaching.
    *
    * @complexity{@math{\Theta(N)}}
    * @note This function is not thread-safe.
@@ -278,12 +305,21 @@ public:
 /*!
  * @name Cached properties access
  * Call complexity depends on whether the properties have been calculated
- * before. After generation, properties are valid as long as no non-const
- * method is called on this class that modifies state.
+ * before. After generation, properties are kept valid across modifications
+ * that are cheap to account for: Adding vertices, adding or removing bridge
+ * edges, changing element types, copies and permutations (removal safety data
+ * only). Any other modification discards them. The compressed sparse row
+ * snapshot is discarded by any modification. Properties generated before a
+ * copy is made are shared with the copy.
  *
  * None of these methods are thread-safe.
  * @{
  */
+  /*! @brief Generates all cached properties
+   *
+   * Afterwards, the const accessors below only read and can be called
+   * concurrently until the graph is next modified.
+   */
   void populateProperties() const;
   //! Access cycle information of the graph
   const Cycles& cycles() const;
@@ -291,6 +327,11 @@ public:
   const RemovalSafetyData& removalSafetyData() const;
   //! Access cycle information of the graph with eta bonds preserved
   const Cycles& etaPreservedCycles() const;
+  /*! @brief Access a frozen compressed sparse row snapshot of the graph
+   *
+   * Preferable for read-only algorithms traversing large parts of the graph.
+   */
+  const CsrGraph& csr() const;
 //!@}
 
 //!@name Ranges
@@ -313,18 +354,103 @@ public:
 private:
 //!@name Private types
 //!@{
+  /*! @brief Disjoint set forest of the connected components
+   *
+   * Maintained alongside other cached properties so that deciding whether an
+   * added edge joins two components takes amortized logarithmic time instead
+   * of a graph traversal.
+   */
+  struct Components {
+    //! Parent of each vertex in the forest, roots are their own parent
+    std::vector<Vertex> parents;
+
+    //! Root of the tree containing a vertex, halving paths on the way
+    Vertex find(Vertex v);
+    //! Merge the trees containing two vertices
+    void join(Vertex a, Vertex b);
+  };
+
+  /*! @brief Cached properties, shared between copies
+   *
+   * Removal safety data refers to edge descriptors of the BGL graph and is
+   * shared exactly as long as the BGL graph is. It is altered only after the
+   * BGL graph is detached from any copies, as are the components. All other
+   * properties are never altered after generation.
+   */
   struct Properties {
-    boost::optional<RemovalSafetyData> removalSafetyDataOption;
-    boost::optional<Cycles> cyclesOption;
-    boost::optional<Cycles> etaPreservedCyclesOption;
+    std::shared_ptr<RemovalSafetyData> removalSafetyDataPtr;
+    std::shared_ptr<const Cycles> cyclesPtr;
+    std::shared_ptr<const Cycles> etaPreservedCyclesPtr;
+    std::shared_ptr<const CsrGraph> csrPtr;
+    std::shared_ptr<Components> componentsPtr;
 
     inline void invalidate() {
-      removalSafetyDataOption = boost::none;
-      cyclesOption = boost::none;
-      etaPreservedCyclesOption = boost::none;
+      removalSafetyDataPtr.reset();
+      csrPtr.reset();
+      componentsPtr.reset();
+      invalidateCycles();
+    }
+
+    inline void invalidateCycles() {
+      cyclesPtr.reset();
+      etaPreservedCyclesPtr.reset();
+    }
+
+    //! Whether there is no cached data that can be maintained across edits
+    inline bool empty() const {
+      return !removalSafetyDataPtr && !cyclesPtr && !etaPreservedCyclesPtr;
     }
   };
 
+  //! Shared empty BGL graph for default-constructed and moved-from instances
+  static const std::shared_ptr<BglType>& emptyGraph_();
+
+  /*! @brief Ensures the BGL graph is not shared with any copies before a
+   *   modification
+   *
+   * @complexity{@math{\Theta(V + E)} if shared, @math{\Theta(1)} otherwise}
+   */
+  void detach_();
+
+  /*! @brief Yields the descriptor of an edge in this graph's BGL graph
+   *
+   * Edge descriptors carry a pointer into the BGL graph they were fetched
+   * from. Descriptors fetched before detach_() duplicated the BGL graph point
+   * into the storage of a copy, which may even have been freed since. Every
+   * access to edge properties goes through this. Edges are looked up anew
+   * only if the BGL graph was ever duplicated.
+   *
+   * @complexity{@math{\Theta(1)} if the BGL graph was never duplicated,
+   *   linear in the degree of the edge's source otherwise}
+   */
+  Edge ownEdge_(const Edge& edge) const;
+
+  /*! @brief Whether the edge is a bridge according to cached removal safety data
+   *
+   * False if removal safety data is not cached.
+   */
+  bool isCachedBridge_(const Edge& edge) const;
+
+  /*! @brief Connected components, generated if not cached
+   *
+   * @complexity{@math{\Theta(V + E)} if not cached, @math{\Theta(1)}
+   * otherwise}
+   */
+  Components& components_() const;
+
+  /*! @brief Copies removal safety data onto this graph's descriptors
+   *
+   * @param data Removal safety data of an isomorphic graph
+   * @param permutation Vertex permutation from the other graph to this one.
+   *   Empty for the identity.
+   * @param other The graph whose edge descriptors @p data refers to
+   */
+  RemovalSafetyData mapRemovalSafetyData_(
+    const RemovalSafetyData& data,
+    const std::vector<Vertex>& permutation,
+    const BglType& other
+  ) const;
+
   RemovalSafetyData generateRemovalSafetyData_() const;
   Cycles generateCycles_() const;
   Cycles generateEtaPreservedCycles_() const;
@@ -332,8 +458,10 @@ private:
 
 //!@name Private state
 //!@{
-  //! A directly owned Boost Library Graph.
-  BglType graph_;
+  //! A Boost Library Graph, possibly shared with copies
+  std::shared_ptr<BglType> graph_;
+  //! Whether detach_() ever duplicated the BGL graph
+  bool duplicatedStorage_ = false;
   //! Property caching
   mutable Properties properties_;
 //!@}
@@ -0,0 +1,535 @@
+/*!@file
+ * @copyright This code is licensed under the 3-clause BSD license.
+ *   Copyright ETH Zurich, Laboratory of Physical Chemistry, Reiher Group.
+ *   See LICENSE.txt for details.
+ */
+#include "Molassembler/IO/SmilesFastParser.h"
+
+#include "boost/filesystem.hpp"
+#include "boost/interprocess/file_mapping.hpp"
+#include "boost/interprocess/mapped_region.hpp"
+
+#include "Molassembler/IO/SmilesMoleculeBuilder.h"
+#include "Molassembler/IO/SmilesParser.h"
+#include "Molassembler/Molecule.h"
+
+#include <array>
+#include <cstring>
+#include <string>
+
+namespace Scine {
+namespace Molassembler {
+namespace IO {
+namespace {
+
+inline bool isDigit(const char c) {
+  return '0' <= c && c <= '9';
+}
+
+inline bool isUpper(const char c) {
+  return 'A' <= c && c <= 'Z';
+}
+
+inline bool isLower(const char c) {
+  return 'a' <= c && c <= 'z';
+}
+
+/* Element symbols of up to two letters mapped to their atomic number. Zero
+ * marks symbols without an element.
+ */
+class ElementSymbolTable {
+public:
+  ElementSymbolTable() {
+    Z_.fill(0);
+    // Same range of elements as the Boost.Spirit parser's symbol table
+    for(unsigned i = 1; i < 110; ++i) {
+      const std::string symbol = Utils::ElementInfo::symbol(Utils::ElementInfo::element(i));
+      if(symbol.size() == 1 && isUpper(symbol[0])) {
+        Z_.at(index(symbol[0], '\0')) = i;
+      } else if(symbol.size() == 2 && isUpper(symbol[0]) && isLower(symbol[1])) {
+        Z_.at(index(symbol[0], symbol[1])) = i;
+      }
+    }
+  }
+
+  //! Atomic number of a symbol, with second being '\0' for single letters
+  unsigned Z(const char first, const char second) const {
+    return Z_[index(first, second)];
+  }
+
+private:
+  static unsigned index(const char first, const char second) {
+    const unsigned secondIndex = (second == '\0') ? 0 : (second - 'a' + 1);
+    return (first - 'A') * 27 + secondIndex;
+  }
+
+  std::array<unsigned, 26 * 27> Z_;
+};
+
+const ElementSymbolTable& elementSymbols() {
+  static const ElementSymbolTable table;
+  return table;
+}
+
+class FastSmilesParser {
+public:
+  FastSmilesParser(
+    const char* begin,
+    const char* end,
+    MoleculeBuilder& builder
+  ) : begin_(begin), iter_(begin), end_(end), builder_(builder) {}
+
+  /* The grammar is
+   *
+   * chain ::= atom ringbond* (branch | bond? atom ringbond* | dot atom ringbond*)*
+   * branch ::= '(' (bond | dot)? chain ')'
+   *
+   * which is flattened here into a loop tracking the branch depth.
+   */
+  boost::optional<SmilesSyntaxError> parse() {
+    if(!atom()) {
+      return error_;
+    }
+
+    unsigned branchDepth = 0;
+    while(!atEnd()) {
+      if(*iter_ == '(') {
+        ++iter_;
+        builder_.branchOpen();
+        ++branchDepth;
+      } else if(*iter_ == ')') {
+        if(branchDepth == 0) {
+          fail("Unmatched branch closure");
+          return error_;
+        }
+        ++iter_;
+        builder_.branchClose();
+        --branchDepth;
+        continue;
+      }
+
+      bondOrDot();
+      if(!atom()) {
+        return error_;
+      }
+    }
+
+    if(branchDepth > 0) {
+      fail("Unclosed branch");
+    }
+
+    return error_;
+  }
+
+private:
+  bool atEnd() const {
+    return iter_ == end_;
+  }
+
+  //! Character at an offset from the current position, '\0' past the end
+  char peek(const unsigned offset = 0) const {
+    if(end_ - iter_ <= static_cast<std::ptrdiff_t>(offset)) {
+      return '\0';
+    }
+    return *(iter_ + offset);
+  }
+
+  bool fail(const char* message) {
+    if(!error_) {
+      error_ = SmilesSyntaxError {
+        static_cast<std::size_t>(iter_ - begin_),
+        message
+      };
+    }
+    return false;
+  }
+
+  /*! Reads between @p minCount and @p maxCount digits. Leaves the position
+   * unchanged if there are fewer than minCount digits.
+   */
+  bool digits(const unsigned minCount, const unsigned maxCount, unsigned& value) {
+    const char* start = iter_;
+    unsigned count = 0;
+    unsigned accumulated = 0;
+    while(count < maxCount && isDigit(peek())) {
+      accumulated = 10 * accumulated + (*iter_ - '0');
+      ++iter_;
+      ++count;
+    }
+
+    if(count < minCount) {
+      iter_ = start;
+      return false;
+    }
+
+    value = accumulated;
+    return true;
+  }
+
+  static bool bondSymbol(const char c, BondData& bond) {
+    switch(c) {
+      case '-': bond.type = BondType::Single; return true;
+      case '=': bond.type = BondType::Double; return true;
+      case '#': bond.type = BondType::Triple; return true;
+      case '$': bond.type = BondType::Quadruple; return true;
+      // Aromatic bonds carry no order of their own, like implicit bonds
+      case ':': return true;
+      case '/':
+        bond.type = BondType::Single;
+        bond.ezStereo = BondData::StereoMarker::Forward;
+        return true;
+      case '\\':
+        bond.type = BondType::Single;
+        bond.ezStereo = BondData::StereoMarker::Backward;
+        return true;
+      default: return false;
+    }
+  }
+
+  //! Consumes an optional bond or dot preceding an atom
+  void bondOrDot() {
+    if(atEnd()) {
+      return;
+    }
+
+    if(*iter_ == '.') {
+      ++iter_;
+      builder_.setNextAtomUnbonded();
+      return;
+    }
+
+    BondData bond;
+    if(bondSymbol(*iter_, bond)) {
+      ++iter_;
+      builder_.setNextAtomBondInformation(bond);
+    }
+  }
+
+  bool chiral(ChiralData& chiralData) {
+    // Position is past the first '@'
+    chiralData.shape = Shapes::Shape::Tetrahedron;
+    chiralData.chiralIndex = 1;
+
+    const char first = peek();
+    const char second = peek(1);
+    const char third = peek(2);
+
+    if(first == '@') {
+      ++iter_;
+      chiralData.chiralIndex = 2;
+    } else if(first == 'T' && second == 'H' && (third == '1' || third == '2')) {
+      iter_ += 3;
+      chiralData.chiralIndex = third - '0';
+    } else if(first == 'S' && second == 'P' && '1' <= third && third <= '3') {
+      iter_ += 3;
+      chiralData.shape = Shapes::Shape::Square;
+      chiralData.chiralIndex = third - '0';
+    } else if((first == 'T' && second == 'B') || (first == 'O' && second == 'H')) {
+      iter_ += 2;
+      chiralData.shape = (first == 'T')
+        ? Shapes::Shape::TrigonalBipyramid
+        : Shapes::Shape::Octahedron;
+      if(!digits(1, 2, chiralData.chiralIndex)) {
+        return fail("Expected chiral index after shape marker");
+      }
+    }
+
+    return true;
+  }
+
+  bool bracketAtom(AtomData& atomData) {
+    // Position is past '['
+    atomData.atomBracket = true;
+
+    unsigned isotope = 0;
+    if(digits(1, 3, isotope)) {
+      atomData.A = isotope;
+    }
+
+    // Symbol
+    const char first = peek();
+    const char second = peek(1);
+    if(first == '*') {
+      ++iter_;
+    } else if(isLower(first)) {
+      Utils::ElementType element = Utils::ElementType::none;
+      unsigned length = 1;
+      if(first == 's' && second == 'e') {
+        element = Utils::ElementType::Se;
+        length = 2;
+      } else if(first == 'a' && second == 's') {
+        element = Utils::ElementType::As;
+        length = 2;
+      } else if(first == 'b') {
+        element = Utils::ElementType::B;
+      } else if(first == 'c') {
+        element = Utils::ElementType::C;
+      } else if(first == 'n') {
+        element = Utils::ElementType::N;
+      } else if(first == 'o') {
+        element = Utils::ElementType::O;
+      } else if(first == 's') {
+        element = Utils::ElementType::S;
+      } else if(first == 'p') {
+        element = Utils::ElementType::P;
+      } else {
+        return fail("Expected element symbol in atom bracket");
+      }
+      atomData.partialElement = ElementData::aromaticElement(element);
+      iter_ += length;
+    } else if(isUpper(first)) {
+      const ElementSymbolTable& table = elementSymbols();
+      unsigned Z = 0;
+      if(isLower(second) && (Z = table.Z(first, second)) != 0) {
+        iter_ += 2;
+      } else if((Z = table.Z(first, '\0')) != 0) {
+        ++iter_;
+      } else {
+        return fail("Expected element symbol in atom bracket");
+      }
+      atomData.partialElement.Z = Z;
+    } else {
+      return fail("Expected element symbol in atom bracket");
+    }
+
+    if(peek() == '@') {
+      ++iter_;
+      ChiralData chiralData;
+      if(!chiral(chiralData)) {
+        return false;
+      }
+      atomData.chiralOptional = chiralData;
+    }
+
+    // hcount ::= 'H' digit? (up to two digits for inorganic cases)
+    if(peek() == 'H') {
+      ++iter_;
+      unsigned hCount = 1;
+      digits(1, 2, hCount);
+      atomData.hCount = hCount;
+    }
+
+    // charge ::= '-' num? | '+' num? | '--' | '++'
+    const char sign = peek();
+    if(sign == '+' || sign == '-') {
+      ++iter_;
+      const int factor = (sign == '+') ? 1 : -1;
+      unsigned magnitude = 1;
+      if(peek() == sign) {
+        ++iter_;
+        magnitude = 2;
+      } else {
+        digits(1, 2, magnitude);
+      }
+      atomData.chargeOptional = factor * static_cast<int>(magnitude);
+    }
+
+    // class ::= ':' num
+    if(peek() == ':') {
+      ++iter_;
+      unsigned atomClass;
+      if(!digits(1, 9, atomClass)) {
+        return fail("Expected atom class number after ':'");
+      }
+    }
+
+    if(peek() != ']') {
+      return fail("Expected ']' to close atom bracket");
+    }
+    ++iter_;
+    return true;
+  }
+
+  //! Parses an atom and any ring bonds immediately following it
+  bool atom() {
+    AtomData atomData;
+
+    const char first = peek();
+    const char second = peek(1);
+    switch(first) {
+      case '[':
+        ++iter_;
+        if(!bracketAtom(atomData)) {
+          return false;
+        }
+        break;
+      case '*': ++iter_; break;
+      // Organic aliphatic subset
+      case 'B':
+        if(second == 'r') {
+          atomData.partialElement = ElementData(Utils::ElementType::Br);
+          iter_ += 2;
+        } else {
+          atomData.partialElement = ElementData(Utils::ElementType::B);
+          ++iter_;
+        }
+        break;
+      case 'C':
+        if(second == 'l') {
+          atomData.partialElement = ElementData(Utils::ElementType::Cl);
+          iter_ += 2;
+        } else {
+          atomData.partialElement = ElementData(Utils::ElementType::C);
+          ++iter_;
+        }
+        break;
+      case 'N': atomData.partialElement = ElementData(Utils::ElementType::N); ++iter_; break;
+      case 'O': atomData.partialElement = ElementData(Utils::ElementType::O); ++iter_; break;
+      case 'S': atomData.partialElement = ElementData(Utils::ElementType::S); ++iter_; break;
+      case 'P': atomData.partialElement = ElementData(Utils::ElementType::P); ++iter_; break;
+      case 'F': atomData.partialElement = ElementData(Utils::ElementType::F); ++iter_; break;
+      case 'I': atomData.partialElement = ElementData(Utils::ElementType::I); ++iter_; break;
+      // Organic aromatic subset
+      case 'b': atomData.partialElement = ElementData::aromaticElement(Utils::ElementType::B); ++iter_; break;
+      case 'c': atomData.partialElement = ElementData::aromaticElement(Utils::ElementType::C); ++iter_; break;
+      case 'n': atomData.partialElement = ElementData::aromaticElement(Utils::ElementType::N); ++iter_; break;
+      case 'o': atomData.partialElement = ElementData::aromaticElement(Utils::ElementType::O); ++iter_; break;
+      case 's': atomData.partialElement = ElementData::aromaticElement(Utils::ElementType::S); ++iter_; break;
+      case 'p': atomData.partialElement = ElementData::aromaticElement(Utils::ElementType::P); ++iter_; break;
+      default: return fail("Expected atom");
+    }
+
+    builder_.addAtom(atomData);
+
+    // ringbond ::= bond? (digit | '%' digit digit)
+    while(!atEnd()) {
+      const char* start = iter_;
+      BondData bond;
+      if(bondSymbol(*iter_, bond)) {
+        ++iter_;
+      }
+
+      if(isDigit(peek())) {
+        bond.ringNumber = *iter_ - '0';
+        ++iter_;
+      } else if(peek() == '%') {
+        ++iter_;
+        unsigned ringNumber;
+        if(!digits(2, 2, ringNumber)) {
+          return fail("Expected two digit ring number after '%'");
+        }
+        bond.ringNumber = ringNumber;
+      } else {
+        // Not a ring bond, the bond belongs to the chain
+        iter_ = start;
+        break;
+      }
+
+      builder_.addRingClosure(bond);
+    }
+
+    return true;
+  }
+
+  const char* const begin_;
+  const char* iter_;
+  const char* const end_;
+  MoleculeBuilder& builder_;
+  boost::optional<SmilesSyntaxError> error_;
+};
+
+Experimental::SmilesLineResult parseLine(
+  const char* begin,
+  const char* end,
+  const bool deferStereopermutators
+) {
+  // Parse only the first field, dropping any trailing molecule name
+  const char* smilesEnd = begin;
+  while(smilesEnd != end && *smilesEnd != ' ' && *smilesEnd != '\t' && *smilesEnd != '\r') {
+    ++smilesEnd;
+  }
+
+  Experimental::SmilesLineResult result;
+  if(smilesEnd == begin) {
+    result.error = "Empty line";
+    return result;
+  }
+
+  try {
+    MoleculeBuilder builder;
+    if(auto syntaxError = parseSmilesInto(begin, smilesEnd, builder)) {
+      result.error = std::string(syntaxError->message)
+        + " at position " + std::to_string(syntaxError->position);
+      return result;
+    }
+    result.molecules = builder.interpret(deferStereopermutators);
+  } catch(const std::exception& e) {
+    result.error = e.what();
+  }
+
+  return result;
+}
+
+std::vector<Experimental::SmilesLineResult> parseLines(
+  const char* begin,
+  const char* end,
+  const bool deferStereopermutators
+) {
+  std::vector<std::pair<const char*, const char*>> lines;
+  const char* lineBegin = begin;
+  while(lineBegin < end) {
+    const void* newline = std::memchr(lineBegin, '\n', end - lineBegin);
+    const char* lineEnd = (newline == nullptr) ? end : static_cast<const char*>(newline);
+    lines.emplace_back(lineBegin, lineEnd);
+    lineBegin = (lineEnd == end) ? end : lineEnd + 1;
+  }
+
+  const unsigned L = lines.size();
+  std::vector<Experimental::SmilesLineResult> results(L);
+#pragma omp parallel for schedule(dynamic, 64)
+  for(unsigned i = 0; i < L; ++i) {
+    results[i] = parseLine(lines[i].first, lines[i].second, deferStereopermutators);
+  }
+
+  return results;
+}
+
+} // namespace
+
+boost::optional<SmilesSyntaxError> parseSmilesInto(
+  const char* begin,
+  const char* end,
+  MoleculeBuilder& builder
+) {
+  return FastSmilesParser {begin, end, builder}.parse();
+}
+
+namespace Experimental {
+
+std::vector<SmilesLineResult> parseSmilesLines(
+  const std::string& lines,
+  const bool deferStereopermutators
+) {
+  return parseLines(
+    lines.data(),
+    lines.data() + lines.size(),
+    deferStereopermutators
+  );
+}
+
+std::vector<SmilesLineResult> parseSmilesFile(
+  const std::string& filename,
+  const bool deferStereopermutators
+) {
+  if(!boost::filesystem::exists(filename)) {
+    throw std::logic_error("File selected to read does not exist.");
+  }
+
+  // Empty files cannot be mapped
+  if(boost::filesystem::file_size(filename) == 0) {
+    return {};
+  }
+
+  namespace ip = boost::interprocess;
+  const ip::file_mapping mapping {filename.c_str(), ip::read_only};
+  ip::mapped_region region {mapping, ip::read_only};
+  region.advise(ip::mapped_region::advice_sequential);
+
+  const char* begin = static_cast<const char*>(region.get_address());
+  return parseLines(begin, begin + region.get_size(), deferStereopermutators);
+}
+
+} // namespace Experimental
+} // namespace IO
+} // namespace Molassembler
+} // namespace Scine
@@ -0,0 +1,57 @@
+/*!@file
+ * @copyright This code is licensed under the 3-clause BSD license.
+ *   Copyright ETH Zurich, Laboratory of Physical Chemistry, Reiher Group.
+ *   See LICENSE.txt for details.
+ * @brief Hand-written smiles parser for bulk ingestion
+ *
+ * Recognizes the same grammar as the Boost.Spirit parser in SmilesParser.cpp
+ * and feeds the same MoleculeBuilder, but operates directly on character
+ * ranges, does not allocate and reports syntax errors by return value.
+ */
+#ifndef INCLUDE_MOLASSEMBLER_IO_SMILES_FAST_PARSER_H
+#define INCLUDE_MOLASSEMBLER_IO_SMILES_FAST_PARSER_H
+
+#include "boost/optional.hpp"
+#include <cstddef>
+
+namespace Scine {
+namespace Molassembler {
+namespace IO {
+
+class MoleculeBuilder;
+
+//! Description of a syntax error encountered in parsing a smiles string
+struct SmilesSyntaxError {
+  //! Offset of the offending character from the start of the string
+  std::size_t position;
+  //! Static description of the error
+  const char* message;
+};
+
+/*! @brief Parses a smiles string into a molecule builder
+ *
+ * Differences to the Boost.Spirit parser: Dangling bonds at the end of a
+ * string or a branch (e.g. "CC=") are rejected, and the "++" and "--" charge
+ * notations are accepted.
+ *
+ * @param begin Start of the character range to parse
+ * @param end End of the character range to parse
+ * @param builder Builder to feed parsed atoms and bonds into
+ *
+ * @throws std::runtime_error Only from the builder, on semantic errors such as
+ *   hydrogen counts on hydrogen atoms or invalid ring closures
+ *
+ * @return The first syntax error, if any. On syntax errors the builder is left
+ *   in an unspecified state.
+ */
+boost::optional<SmilesSyntaxError> parseSmilesInto(
+  const char* begin,
+  const char* end,
+  MoleculeBuilder& builder
+);
+
+} // namespace IO
+} // namespace Molassembler
+} // namespace Scine
+
+#endif
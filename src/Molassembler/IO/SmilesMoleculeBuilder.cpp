@@ -672,7 +672,7 @@ void MoleculeBuilder::setBondStereo(
   }
 }
 
-std::vector<Molecule> MoleculeBuilder::interpret() {
+std::vector<Molecule> MoleculeBuilder::interpret(const bool deferStereopermutators) {
   if(!ringClosures.empty()) {
     throw std::runtime_error("Unmatched ring closure markers remain!");
   }
@@ -753,9 +753,16 @@ std::vector<Molecule> MoleculeBuilder::interpret() {
   std::vector<Molecule> molecules;
   molecules.reserve(M);
   for(auto&& precursor : precursors) {
-    molecules.emplace_back(
-      Graph(std::move(precursor))
-    );
+    if(deferStereopermutators) {
+      molecules.emplace_back(
+        Graph(std::move(precursor)),
+        Molecule::DeferStereopermutatorsTag {}
+      );
+    } else {
+      molecules.emplace_back(
+        Graph(std::move(precursor))
+      );
+    }
   }
 
   /* Stereo routines */
@@ -66,8 +66,13 @@ public:
   }
 //!@}
 
-  //! @brief Interpret the collected graph as (possibly multiple molecules)
-  std::vector<Molecule> interpret();
+  /*! @brief Interpret the collected graph as (possibly multiple molecules)
+   *
+   * @param deferStereopermutators Construct molecules with deferred
+   *   stereopermutator detection. Detection then takes place only if stereo
+   *   markers or charges need to be applied, or on first access.
+   */
+  std::vector<Molecule> interpret(bool deferStereopermutators = false);
 
 private:
 //!@name Static private members
@@ -125,7 +125,8 @@ struct bond_ : qi::symbols<char, BondData> {
       ("=", {BondType::Double, boost::none, boost::none})
       ("#", {BondType::Triple, boost::none, boost::none})
       ("$", {BondType::Quadruple, boost::none, boost::none})
-      (":", {BondType::Single, boost::none, boost::none})  // TODO actually aromatic
+      // Aromatic bonds carry no order of their own, like implicit bonds
+      (":", {boost::none, boost::none, boost::none})
       ("/", {BondType::Single, BondData::StereoMarker::Forward, boost::none})
       ("\\", {BondType::Single, BondData::StereoMarker::Backward, boost::none});
   }
@@ -7,18 +7,23 @@
 #ifndef INCLUDE_MOLASSEMBLER_IO_SMILES_PARSER_H
 #define INCLUDE_MOLASSEMBLER_IO_SMILES_PARSER_H
 
-#include "Molassembler/Export.h"
+#include "Molassembler/Molecule.h"
 #include <string>
 #include <vector>
 
 namespace Scine {
 namespace Molassembler {
-
-class Molecule;
-
 namespace IO {
 namespace Experimental {
 
+//! Result of parsing a single line in bulk smiles parsing
+struct MASM_EXPORT SmilesLineResult {
+  //! Molecules parsed from the line, empty if parsing failed
+  std::vector<Molecule> molecules;
+  //! Description of the parsing failure, empty if parsing succeeded
+  std::string error;
+};
+
 /**
  * @brief Parse a smiles string
  *
@@ -74,6 +79,47 @@ MASM_EXPORT std::vector<Molecule> parseSmiles(const std::string& smiles);
  */
 MASM_EXPORT Molecule parseSmilesSingleMolecule(const std::string& smiles);
 
+/**
+ * @brief Parse newline-delimited smiles strings in parallel
+ *
+ * Uses a hand-written parser recognizing the same smiles features as
+ * parseSmiles. Lines are parsed in parallel if OpenMP is available. Only the
+ * first whitespace-delimited field of each line is parsed, so that the common
+ * smiles file format with trailing molecule names is supported. Carriage
+ * returns preceding newlines are ignored.
+ *
+ * @param lines Newline-delimited smiles strings
+ * @param deferStereopermutators Whether to defer stereopermutator detection
+ *   in the parsed molecules if no stereo markers or charges require it. See
+ *   Molecule::DeferStereopermutatorsTag. Saves most of the parsing time for
+ *   graph-only workloads.
+ *
+ * @return Results for each line in input order. Errors on individual lines
+ *   are reported in the results and do not interrupt parsing.
+ */
+MASM_EXPORT std::vector<SmilesLineResult> parseSmilesLines(
+  const std::string& lines,
+  bool deferStereopermutators = false
+);
+
+/**
+ * @brief Parse a file of newline-delimited smiles strings in parallel
+ *
+ * Memory-maps the file, then proceeds as parseSmilesLines.
+ *
+ * @param filename The file to read
+ * @param deferStereopermutators Whether to defer stereopermutator detection
+ *   in the parsed molecules if no stereo markers or charges require it
+ *
+ * @throws std::logic_error If the file does not exist
+ *
+ * @return Results for each line of the file in order
+ */
+MASM_EXPORT std::vector<SmilesLineResult> parseSmilesFile(
+  const std::string& filename,
+  bool deferStereopermutators = false
+);
+
 } // namespace Experimental
 } // namespace IO
 } // namespace Molassembler
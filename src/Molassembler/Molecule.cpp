@@ -5,8 +5,12 @@
  */
 
 #include "Molassembler/Molecule/MoleculeImpl.h"
+#include "Molassembler/Graph/Canonicalization.h"
 #include "Molassembler/RankingInformation.h"
 
+#include <exception>
+#include <stdexcept>
+
 namespace Scine {
 namespace Molassembler {
 
@@ -20,6 +24,35 @@ Utils::AtomCollection Molecule::applyCanonicalizationMap(
   );
 }
 
+std::vector<
+  std::vector<AtomIndex>
+> Molecule::canonicalize(
+  std::vector<Molecule>& molecules,
+  const AtomEnvironmentComponents componentBitmask
+) {
+  const unsigned M = molecules.size();
+  std::vector<std::vector<AtomIndex>> permutations(M);
+  std::vector<std::exception_ptr> exceptions(M);
+
+  // Each thread reuses its own labeling workspace across molecules
+#pragma omp parallel for schedule(dynamic) if(threadSafeCanonicalization())
+  for(unsigned i = 0; i < M; ++i) {
+    try {
+      permutations[i] = molecules[i].canonicalize(componentBitmask);
+    } catch(...) {
+      exceptions[i] = std::current_exception();
+    }
+  }
+
+  for(const auto& exceptionPtr : exceptions) {
+    if(exceptionPtr) {
+      std::rethrow_exception(exceptionPtr);
+    }
+  }
+
+  return permutations;
+}
+
 /* Molecule interface to Impl call forwards */
 Molecule::Molecule() noexcept : pImpl_(
   std::make_unique<Impl>()
@@ -54,6 +87,10 @@ Molecule::Molecule(Graph graph) : pImpl_(
   std::make_unique<Impl>(std::move(graph))
 ) {}
 
+Molecule::Molecule(Graph graph, DeferStereopermutatorsTag tag) : pImpl_(
+  std::make_unique<Impl>(std::move(graph), tag)
+) {}
+
 Molecule::Molecule(
   Graph graph,
   const AngstromPositions& positions,
@@ -174,6 +211,35 @@ void Molecule::setShapeAtAtom(
   pImpl_->setShapeAtAtom(a, shape);
 }
 
+void Molecule::beginEdit() {
+  pImpl_->beginEdit();
+}
+
+void Molecule::commitEdit() {
+  pImpl_->commitEdit();
+}
+
+Molecule::EditGuard::EditGuard(Molecule& molecule) : molecule_(molecule) {
+  molecule_.beginEdit();
+}
+
+Molecule::EditGuard::~EditGuard() {
+  if(!committed_) {
+    // Destructors must not throw, e.g. while unwinding from a failed edit
+    try {
+      commit();
+    } catch(...) {}
+  }
+}
+
+void Molecule::EditGuard::commit() {
+  if(committed_) {
+    throw std::logic_error("Molecule::EditGuard: Already committed");
+  }
+
+  committed_ = true;
+  molecule_.commitEdit();
+}
 
 /* Information */
 boost::optional<AtomEnvironmentComponents> Molecule::canonicalComponents() const {
@@ -72,6 +72,52 @@ struct RankingInformation;
  */
 class MASM_EXPORT Molecule {
 public:
+//!@name Member types
+//!@{
+  //! Tag type selecting deferred stereopermutator detection on construction
+  struct DeferStereopermutatorsTag {};
+
+  /*! @brief Scoped edit transaction
+   *
+   * Opens an edit transaction on construction and closes it on destruction,
+   * so that an exception between opening and committing does not leave the
+   * molecule in an open transaction.
+   *
+   * @code{.cpp}
+   * {
+   *   Molecule::EditGuard guard {molecule};
+   *   for(AtomIndex i : bindingAtoms) {
+   *     molecule.addBond(metal, i);
+   *   }
+   *   guard.commit();
+   * }
+   * @endcode
+   */
+  class MASM_EXPORT EditGuard {
+  public:
+    //! Opens an edit transaction on @p molecule
+    explicit EditGuard(Molecule& molecule);
+    EditGuard(const EditGuard& other) = delete;
+    EditGuard& operator = (const EditGuard& other) = delete;
+
+    /*! @brief Commits the transaction unless already committed
+     *
+     * Exceptions from the deferred propagation are discarded. Call commit()
+     * to receive them.
+     */
+    ~EditGuard();
+
+    /*! @brief Commits the transaction
+     *
+     * @throws std::logic_error If already committed
+     */
+    void commit();
+
+  private:
+    Molecule& molecule_;
+    bool committed_ = false;
+  };
+//!@}
 
 //!@name Static functions
 //!@{
@@ -88,6 +134,28 @@ public:
     const std::vector<AtomIndex>& canonicalizationIndexMap,
     const Utils::AtomCollection& atomCollection
   );
+
+  /** @brief Transform many molecules to canonical form, in parallel if
+   *   possible
+   *
+   * Equivalent to calling canonicalize on each molecule. Molecules are
+   * canonicalized concurrently if OpenMP is available and the underlying
+   * labeling library is built thread-safe.
+   *
+   * @complexity{Linear in the number of molecules, see canonicalize}
+   *
+   * @param molecules The molecules to canonicalize
+   * @param componentBitmask The components of the molecular graph to include
+   *   in the canonicalization procedure.
+   *
+   * @return Permutation mapping from old indices to new for each molecule
+   */
+  static std::vector<
+    std::vector<AtomIndex>
+  > canonicalize(
+    std::vector<Molecule>& molecules,
+    AtomEnvironmentComponents componentBitmask = AtomEnvironmentComponents::All
+  );
 //!@}
 
 //!@name Special member functions
@@ -137,6 +205,26 @@ public:
    */
   explicit Molecule(Graph graph);
 
+  /*! @brief Constructs from connectivity alone, deferring stereopermutator
+   *   detection until it is needed
+   *
+   * Ranking, shape inference and stereopermutation enumeration are the bulk of
+   * the cost of graph-only construction, but are unnecessary for graph-level
+   * work such as substructure searches or canonicalization without shapes.
+   * Stereopermutators are detected on first access to stereopermutators() or
+   * on any operation requiring them, with results identical to Molecule(Graph).
+   * Graph modifications made in the meantime do not trigger detection.
+   *
+   * @complexity{@math{\Theta(V + E)}}
+   * @throws std::logic_error If the supplied graph has multiple connected
+   *   components or no atoms
+   *
+   * @warning Deferred detection mutates otherwise const instances and is not
+   *   thread-safe. Call stereopermutators() before sharing a deferred instance
+   *   between threads.
+   */
+  Molecule(Graph graph, DeferStereopermutatorsTag tag);
+
   /*! @brief Construct from connectivity and positions
    *
    * Construct an instance from a constituting graph and positional information.
@@ -545,6 +633,52 @@ public:
     AtomIndex a,
     Shapes::Shape shape
   );
+
+  /*! @brief Opens an edit transaction
+   *
+   * Until the transaction is committed, graph edits do not cause a full
+   * re-rank of every non-terminal atom. Only stereopermutators whose number of
+   * sites is changed by an edit are propagated immediately. Propagation of
+   * all other ranking changes happens once in commitEdit() with the
+   * accumulated changes, and new stereopermutators are detected then.
+   *
+   * Transactions can be nested. Only committing the outermost transaction
+   * performs the deferred propagation.
+   *
+   * @code{.cpp}
+   * molecule.beginEdit();
+   * for(AtomIndex i : bindingAtoms) {
+   *   molecule.addBond(metal, i);
+   * }
+   * molecule.commitEdit();
+   * @endcode
+   *
+   * Prefer an EditGuard, which closes the transaction even if an edit throws.
+   *
+   * @complexity{@math{\Theta(1)}}
+   *
+   * @note The result of a committed transaction is that of applying the same
+   *   edits one by one, except where intermediate stereopermutators would
+   *   have been added and subsequently modified by later edits.
+   *
+   * @warning Until the transaction is committed, stereopermutators() can be
+   *   incomplete and rankings in it outdated, so information and comparison
+   *   functions should not be relied upon. Setting stereopermutator
+   *   assignments or shapes performs any deferred propagation first.
+   */
+  void beginEdit();
+
+  /*! @brief Commits an edit transaction
+   *
+   * If this closes the outermost transaction, propagates stereopermutators
+   * through all edits made since beginEdit().
+   *
+   * @complexity{@math{\Theta(N)} re-rankings and propagations if closing
+   * the outermost transaction, @math{\Theta(1)} otherwise}
+   *
+   * @throws std::logic_error If no edit transaction is open
+   */
+  void commitEdit();
 //!@}
 
 //!@name Information
@@ -633,7 +767,8 @@ public:
 
   /*! @brief Provides read-only access to the list of stereopermutators
    *
-   * @complexity{@math{\Theta(1)}}
+   * @complexity{@math{\Theta(1)}}, unless stereopermutator detection was
+   * deferred on construction and has not yet taken place
    */
   const StereopermutatorList& stereopermutators() const;
 
@@ -11,11 +11,15 @@
 #include "Molassembler/AtomStereopermutator.h"
 #include "Molassembler/BondStereopermutator.h"
 #include "Molassembler/StereopermutatorList.h"
+#include "Molassembler/Graph/CsrGraph.h"
 #include "Molassembler/Graph/PrivateGraph.h"
+#include "Molassembler/Profiling.h"
 #include "Molassembler/Temple/Functional.h"
 #include "Molassembler/Temple/Adaptors/Iota.h"
 #include "Utils/Geometry/ElementInfo.h"
 
+#include <array>
+
 namespace Scine {
 namespace Molassembler {
 namespace Hashes {
@@ -41,45 +45,175 @@ static_assert(
   "BondInformation::hashWidth is no longer the sum of bond type bits and assignment bits"
 );
 
-WideHashType BondInformation::hash() const {
-  // Initialize with the bond type
-  WideHashType hash (
-    /* BondType is unsigned, and we want it on the left of the assignment
-     * optional, so we shift it by three
+namespace {
+
+/* Bit representation of a bond. The bond type underlying value has to be
+ * incremented because otherwise Single is the same as None. It is on the left
+ * of the stereopermutator information, so we shift it by three.
+ *
+ * In the other three bits, we have to store the following cases:
+ *
+ * - 0: No BondStereopermutator
+ * - 1: Unassigned BondStereopermutator
+ * - 2-7: BondStereopermutator assignment
+ *
+ * We can store 6 BondStereopermutator assignments, which ought to be okay.
+ * The most you can probably get right now is 5 by fusing something
+ * pentagonal at an axial position.
+ *
+ * Ordering these numbers is equivalent to ordering BondInformation.
+ */
+inline unsigned bondHash(const BondType bondType, const unsigned stereopermutatorBits) {
+  return (
+    (static_cast<unsigned>(bondType) + 1) << BondInformation::bondTypeBits
+  ) + stereopermutatorBits;
+}
+
+/* The bit representation of element types is 16 bits wide storing both atomic
+ * number and atomic mass number in order to account for isotopes
+ */
+constexpr unsigned elementTypeBits = 16;
+constexpr unsigned shapeNameBits = Temple::Math::ceil(
+  Temple::Math::log(Shapes::nShapes + 1.0, 2.0)
+);
+
+/* Bond types have 7 possible values currently, plus None is 8
+ * -> fits into 3 bits (2^3 = 8).
+ *
+ * I think bond stereopermutator assignments can be up to 5 (if fused axially
+ * onto some pentagonal structure) maximally, but we can fit up to 7 into 3
+ * bits.
+ *
+ * So, a single bond's information needs 6 bits.
+ *
+ * Bonds are placed to the left of the 16 bits of the element type, each
+ * bond number shifted by the width of a BondInformation hash to place a
+ * maximum of 12 bond types (maximum shape size currently)
+ *
+ * This occupies 6 * 12 = 72 bits.
+ */
+constexpr unsigned bondsHashSectionWidth = BondInformation::hashWidth * Shapes::ConstexprProperties::maxShapeSize;
+
+static_assert(
+  // Sum of information in bits we want to pack in the 128 bit hash
+  (
+    // Element type (fixed as this cannot possibly increase)
+    elementTypeBits
+    // Bond information: exactly as many as the largest possible shape
+    + bondsHashSectionWidth
+    // The bits needed to store the shape name (plus none)
+    + shapeNameBits
+    // Roughly 5040 possible assignment values (maximally asymmetric square antiprismatic)
+    + 13
+  ) <= WideHashType::bits,
+  "Element type, bond and shape information no longer fit into a 128-bit unsigned integer"
+);
+
+/* Packs the element type, sorted bond hashes and shape information into the
+ * wide hash.
+ *
+ * Bond hashes are accumulated into a single native word per 64 bits of
+ * section so that the packing loop does not carry across words. Fields are
+ * added rather than or-ed so that hashes of atoms with more bonds than the
+ * largest shape, whose bond bits overlap the shape bits, match the previous
+ * multiprecision sums.
+ */
+WideHashType pack(
+  const AtomEnvironmentComponents bitmask,
+  const Utils::ElementType elementType,
+  const unsigned* const sortedBondsBegin,
+  const unsigned* const sortedBondsEnd,
+  const boost::optional<Shapes::Shape>& shapeOptional,
+  const boost::optional<unsigned>& assignedOptional
+) {
+  WideHashType value;
+
+  // First 16 bits of the number are from the element type
+  if(bitmask & AtomEnvironmentComponents::ElementTypes) {
+    using ElementTypeUnderlying = std::underlying_type<Utils::ElementType>::type;
+    value.low = static_cast<ElementTypeUnderlying>(elementType);
+  }
+
+  if(bitmask & AtomEnvironmentComponents::BondOrders) {
+    constexpr unsigned bondsPerWord = 64 / BondInformation::hashWidth;
+    const unsigned B = sortedBondsEnd - sortedBondsBegin;
+    for(unsigned wordStart = 0; wordStart < B; wordStart += bondsPerWord) {
+      const unsigned wordEnd = std::min(B, wordStart + bondsPerWord);
+      std::uint64_t word = 0;
+      for(unsigned j = wordStart; j < wordEnd; ++j) {
+        word |= static_cast<std::uint64_t>(sortedBondsBegin[j]) << (BondInformation::hashWidth * (j - wordStart));
+      }
+      value.addBits(word, elementTypeBits + BondInformation::hashWidth * wordStart);
+    }
+  }
+
+  if((bitmask & AtomEnvironmentComponents::Shapes) && shapeOptional) {
+    /* We add shape information on non-terminal atoms. There are currently
+     * 30 shapes, plus None is 31, which fits into 5 bits (2^5 = 32)
      */
-    (
-      /* The bond type underlying value has to be incremented because otherwise
-       * Single is the same as None
+    value.addBits(
+      static_cast<std::uint64_t>(shapeOptional.value()) + 1,
+      elementTypeBits + bondsHashSectionWidth
+    );
+
+    if(bitmask & AtomEnvironmentComponents::Stereopermutations) {
+      /* The remaining space (128 - (16 + 72 + 5) = 35 bits) is used for the
+       * current permutation. Log_2(12!) ~= 29, so we're good.
        */
-      static_cast<
-        std::underlying_type_t<BondType>
-      >(bondType) + 1
-    ) << bondTypeBits
-  );
+      const std::uint64_t permutationValue = assignedOptional
+        ? static_cast<std::uint64_t>(assignedOptional.value()) + 2
+        : 1;
+      value.addBits(
+        permutationValue,
+        elementTypeBits + bondsHashSectionWidth + shapeNameBits
+      );
+    }
+  }
 
-  /* In the other three bits of given width, we have to store the following
-   * cases:
-   *
-   * - 0: No BondStereopermutator
-   * - 1: Unassigned BondStereopermutator
-   * - 2-7: BondStereopermutator assignment
-   *
-   * We can store 6 BondStereopermutator assignments, which ought to be okay.
-   * The most you can probably get right now is 5 by fusing something
-   * pentagonal at an axial position.
-   */
+  return value;
+}
+
+/* Bond hash buffer for a single atom. Atoms with more substituents than the
+ * largest shape exist only for haptic ligands and fall back to the heap.
+ */
+class BondHashBuffer {
+public:
+  explicit BondHashBuffer(const unsigned size) : size_(size) {
+    if(size_ > inplace_.size()) {
+      heap_.resize(size_);
+    }
+  }
+
+  unsigned* begin() {
+    return heap_.empty() ? inplace_.data() : heap_.data();
+  }
+
+  unsigned* end() {
+    return begin() + size_;
+  }
+
+private:
+  std::array<unsigned, Shapes::ConstexprProperties::maxShapeSize> inplace_;
+  std::vector<unsigned> heap_;
+  unsigned size_;
+};
+
+} // namespace
+
+unsigned BondInformation::hash() const {
+  // The remaining case, no stereopermutator on bond, is just zero
+  unsigned stereopermutatorBits = 0;
   if(stereopermutatorOnBond) {
     if(assignmentOptional == boost::none) {
       // Information that there is an unassigned BondStereopermutator
-      hash += 1;
+      stereopermutatorBits = 1;
     } else {
       // Explicit assignment information
-      hash += 2 + *assignmentOptional;
+      stereopermutatorBits = 2 + *assignmentOptional;
     }
   }
 
-  // The remaining case, no stereopermutator on bond, is just hash = 0
-  return hash;
+  return bondHash(bondType, stereopermutatorBits);
 }
 
 bool BondInformation::operator < (const BondInformation& other) const {
@@ -103,90 +237,22 @@ WideHashType hash(
   const boost::optional<Shapes::Shape>& shapeOptional,
   const boost::optional<unsigned>& assignedOptional
 ) {
-  /* The bit representation of element types is 16 bits wide storing both atomic
-   * number and atomic mass number in order to account for isotopes
-   */
-  constexpr unsigned elementTypeBits = 16;
-  constexpr unsigned shapeNameBits = Temple::Math::ceil(
-    Temple::Math::log(Shapes::nShapes + 1.0, 2.0)
+  BondHashBuffer bondHashes(sortedBonds.size());
+  std::transform(
+    std::begin(sortedBonds),
+    std::end(sortedBonds),
+    bondHashes.begin(),
+    [](const BondInformation& bond) -> unsigned { return bond.hash(); }
   );
 
-  static_assert(
-    // Sum of information in bits we want to pack in the 128 bit hash
-    (
-      // Element type (fixed as this cannot possibly increase)
-      elementTypeBits
-      // Bond information: exactly as many as the largest possible shape
-      + Shapes::ConstexprProperties::maxShapeSize * (
-        BondInformation::hashWidth
-      )
-      // The bits needed to store the shape name (plus none)
-      + shapeNameBits
-      // Roughly 5040 possible assignment values (maximally asymmetric square antiprismatic)
-      + 13
-    ) <= 128,
-    "Element type, bond and shape information no longer fit into a 64-bit unsigned integer"
+  return pack(
+    bitmask,
+    elementType,
+    bondHashes.begin(),
+    bondHashes.end(),
+    shapeOptional,
+    assignedOptional
   );
-
-  // First 16 bits of the number are from the element type
-  WideHashType value;
-  if(bitmask & AtomEnvironmentComponents::ElementTypes) {
-    using ElementTypeUnderlying = std::underlying_type<Utils::ElementType>::type;
-    value = static_cast<WideHashType>(static_cast<ElementTypeUnderlying>(elementType));
-  } else {
-    value = 0;
-  }
-
-  /* Bond types have 7 possible values currently, plus None is 8
-   * -> fits into 3 bits (2^3 = 8).
-   *
-   * I think bond stereopermutator assignments can be up to 5 (if fused axially
-   * onto some pentagonal structure) maximally, but we can fit up to 7 into 3
-   * bits.
-   *
-   * So, a single bond's information needs 6 bits.
-   *
-   * So, left shift by 16 bits (so there are 16 zeros on the right in the bit
-   * representation, where the element type is stored) plus the current bond
-   * number multiplied by the width of a BondInformation hash to place a
-   * maximum of 12 bond types (maximum shape size currently)
-   *
-   * This occupies 6 * 12 = 72 bits.
-   */
-  constexpr unsigned bondsHashSectionWidth = BondInformation::hashWidth * Shapes::ConstexprProperties::maxShapeSize;
-
-  if(bitmask & AtomEnvironmentComponents::BondOrders) {
-    unsigned bondNumber = 0;
-    for(const auto& bond : sortedBonds) {
-      value += (
-        bond.hash()
-      ) << (elementTypeBits + BondInformation::hashWidth * bondNumber);
-
-      ++bondNumber;
-    }
-  }
-
-  if((bitmask & AtomEnvironmentComponents::Shapes) && shapeOptional) {
-    /* We add shape information on non-terminal atoms. There are currently
-     * 30 shapes, plus None is 31, which fits into 5 bits (2^5 = 32)
-     */
-    value += (WideHashType(shapeOptional.value()) + 1) << (elementTypeBits + bondsHashSectionWidth);
-
-    if(bitmask & AtomEnvironmentComponents::Stereopermutations) {
-      /* The remaining space (128 - (16 + 72 + 5) = 35 bits) is used for the
-       * current permutation. Log_2(12!) ~= 29, so we're good.
-       */
-      WideHashType permutationValue;
-      if(assignedOptional) {
-        permutationValue = assignedOptional.value() + 2;
-      } else {
-        permutationValue = 1;
-      }
-      value += permutationValue << (elementTypeBits + bondsHashSectionWidth + shapeNameBits);
-    }
-  }
-
-  return value;
 }
 
 std::vector<BondInformation> gatherBonds(
@@ -254,14 +320,56 @@ WideHashType atomEnvironment(
   AtomEnvironmentComponents bitmask,
   AtomIndex i
 ) {
-  std::vector<BondInformation> bonds;
-  boost::optional<Shapes::Shape> shapeOption;
-  boost::optional<unsigned> assignmentOption;
+  return atomEnvironment(inner.csr(), stereopermutators, bitmask, i);
+}
 
-  if(bitmask & AtomEnvironmentComponents::BondOrders) {
-    bonds = gatherBonds(inner, stereopermutators, bitmask, i);
+WideHashType atomEnvironment(
+  const CsrGraph& csr,
+  boost::optional<const StereopermutatorList&> stereopermutators,
+  const AtomEnvironmentComponents bitmask,
+  const AtomIndex i
+) {
+  const bool withStereopermutators = (bitmask & AtomEnvironmentComponents::Stereopermutations);
+
+  /* Bonds are only considered if stereopermutators are available or not
+   * requested, matching gatherBonds
+   */
+  const bool withBonds = (
+    (bitmask & AtomEnvironmentComponents::BondOrders)
+    && (!withStereopermutators || stereopermutators)
+  );
+
+  const std::size_t adjacencyBegin = csr.offsets()[i];
+  BondHashBuffer bondHashes(withBonds ? csr.degree(i) : 0);
+  if(withBonds) {
+    // Contiguous bond types map onto bond hashes without stereopermutator information
+    const BondType* const bondTypes = csr.bondTypes().data() + adjacencyBegin;
+    unsigned* const hashes = bondHashes.begin();
+    const unsigned S = bondHashes.end() - bondHashes.begin();
+    for(unsigned j = 0; j < S; ++j) {
+      hashes[j] = bondHash(bondTypes[j], 0);
+    }
+
+    if(withStereopermutators && stereopermutators->B() > 0) {
+      const AtomIndex* const adjacents = csr.adjacents().data() + adjacencyBegin;
+      for(unsigned j = 0; j < S; ++j) {
+        auto stereopermutatorOption = stereopermutators->option(BondIndex {i, adjacents[j]});
+        /* Even if a stereopermutator is present, if it has only a single
+         * viable assignment, it is best that it cannot contribute to
+         * differentiating between molecules. See gatherBonds.
+         */
+        if(stereopermutatorOption && stereopermutatorOption->numAssignments() > 1) {
+          const auto assignmentOption = stereopermutatorOption->assigned();
+          hashes[j] += assignmentOption ? 2 + *assignmentOption : 1;
+        }
+      }
+    }
+
+    std::sort(bondHashes.begin(), bondHashes.end());
   }
 
+  boost::optional<Shapes::Shape> shapeOption;
+  boost::optional<unsigned> assignmentOption;
   if(stereopermutators) {
     if(auto refOption = stereopermutators->option(i)) {
       shapeOption = refOption->getShape();
@@ -269,10 +377,11 @@ WideHashType atomEnvironment(
     }
   }
 
-  return hash(
+  return pack(
     bitmask,
-    inner.elementType(i),
-    bonds,
+    csr.elementType(i),
+    bondHashes.begin(),
+    bondHashes.end(),
     shapeOption,
     assignmentOption
   );
@@ -283,13 +392,17 @@ std::vector<WideHashType> generate(
   boost::optional<const StereopermutatorList&> stereopermutators,
   const AtomEnvironmentComponents bitmask
 ) {
-  const unsigned N = inner.N();
+  MOLASSEMBLER_PROFILE_SCOPE("Hashes.generate");
+
+  // Build the snapshot outside of the parallel region
+  const CsrGraph& csr = inner.csr();
+  const unsigned N = csr.N();
   std::vector<WideHashType> hashes(N);
 
 #pragma omp parallel for
   for(unsigned i = 0; i < N; ++i) {
-    hashes.at(i) = atomEnvironment(
-      inner,
+    hashes[i] = atomEnvironment(
+      csr,
       stereopermutators,
       bitmask,
       i
@@ -307,17 +420,19 @@ bool identityCompare(
   AtomEnvironmentComponents componentBitmask
 ) {
   assert(aGraph.N() == bGraph.N());
+  const CsrGraph& aCsr = aGraph.csr();
+  const CsrGraph& bCsr = bGraph.csr();
 
   return Temple::all_of(
     Temple::Adaptors::range(aGraph.N()),
-    [&](const AtomIndex i) -> WideHashType {
+    [&](const AtomIndex i) -> bool {
       return atomEnvironment(
-        aGraph,
+        aCsr,
         aStereopermutators,
         componentBitmask,
         i
       ) == atomEnvironment(
-        bGraph,
+        bCsr,
         bStereopermutators,
         componentBitmask,
         i
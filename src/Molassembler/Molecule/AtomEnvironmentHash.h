@@ -8,9 +8,9 @@
 #ifndef INCLUDE_MOLASSEMBLER_ATOM_ENVIRONMENT_HASH_H
 #define INCLUDE_MOLASSEMBLER_ATOM_ENVIRONMENT_HASH_H
 
-#include "boost/multiprecision/cpp_int.hpp"
 #include "boost/optional.hpp"
 #include "Utils/Geometry/ElementTypes.h"
+#include "Molassembler/Molecule/WideHash.h"
 #include "Molassembler/Shapes/Shapes.h"
 #include "Molassembler/Types.h"
 #include <vector>
@@ -21,13 +21,13 @@ namespace Molassembler {
 // Forward-declarations
 class StereopermutatorList;
 class PrivateGraph;
+class CsrGraph;
 
 /**
  * @brief Classes and methods to compute hashes of atom environments
  */
 namespace Hashes {
 
-using WideHashType = boost::multiprecision::uint128_t;
 using HashType = std::uint64_t;
 
 /**
@@ -51,7 +51,8 @@ struct BondInformation {
     boost::optional<unsigned> passAssignmentOptional
   );
 
-  WideHashType hash() const;
+  //! Bit representation of the bond information, hashWidth bits wide
+  unsigned hash() const;
 
   bool operator < (const BondInformation& other) const;
   bool operator == (const BondInformation& other) const;
@@ -82,7 +83,7 @@ WideHashType hash(
  */
 std::vector<BondInformation> gatherBonds(
   const PrivateGraph& inner,
-  const StereopermutatorList& stereopermutators,
+  const boost::optional<const StereopermutatorList&>& stereopermutators,
   AtomEnvironmentComponents componentsBitmask,
   AtomIndex i
 );
@@ -98,6 +99,20 @@ WideHashType atomEnvironment(
   AtomIndex i
 );
 
+/*! @brief Calculate the hash for a particular atom index from a graph snapshot
+ *
+ * Bond hashes are computed directly from the snapshot's contiguous bond type
+ * array of the atom.
+ *
+ * @complexity{@math{\Theta(1)}}
+ */
+WideHashType atomEnvironment(
+  const CsrGraph& csr,
+  boost::optional<const StereopermutatorList&> stereopermutators,
+  AtomEnvironmentComponents bitmask,
+  AtomIndex i
+);
+
 /*! @brief Generates the hashes for every atom in a molecule's components
  *
  * @complexity{@math{\Theta(N)}}
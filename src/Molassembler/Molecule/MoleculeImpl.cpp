@@ -24,11 +24,28 @@
 #include "Molassembler/Molecule/MolGraphWriter.h"
 #include "Molassembler/Molecule/RankingTree.h"
 #include "Molassembler/Options.h"
+#include "Molassembler/Profiling.h"
 #include "Molassembler/Stereopermutators/AbstractPermutations.h"
 #include "Molassembler/Stereopermutators/FeasiblePermutations.h"
 
+#include <algorithm>
+#include <exception>
+#include <tuple>
+
 namespace Scine {
 namespace Molassembler {
+namespace {
+
+//! Rethrows the first stored exception, if any, after a parallel section
+void rethrowFirst(const std::vector<std::exception_ptr>& exceptions) {
+  for(const auto& exceptionPtr : exceptions) {
+    if(exceptionPtr) {
+      std::rethrow_exception(exceptionPtr);
+    }
+  }
+}
+
+} // namespace
 
 Utils::AtomCollection Molecule::Impl::applyCanonicalizationMap(
   const std::vector<AtomIndex>& canonicalizationIndexMap,
@@ -45,20 +62,19 @@ Utils::AtomCollection Molecule::Impl::applyCanonicalizationMap(
   return permuted;
 }
 
-void Molecule::Impl::tryAddAtomStereopermutator_(
-  AtomIndex candidateIndex,
-  StereopermutatorList& stereopermutators
+boost::optional<AtomStereopermutator> Molecule::Impl::makeAtomStereopermutator_(
+  const AtomIndex candidateIndex
 ) const {
-  // If there is already an atom stereopermutator on this index, stop
-  if(stereopermutators.option(candidateIndex)) {
-    return;
-  }
-
-  RankingInformation localRanking = rankPriority(candidateIndex);
+  return makeAtomStereopermutator_(candidateIndex, rankPriority(candidateIndex));
+}
 
+boost::optional<AtomStereopermutator> Molecule::Impl::makeAtomStereopermutator_(
+  const AtomIndex candidateIndex,
+  RankingInformation localRanking
+) const {
   // Only non-terminal atoms may have permutators
   if(localRanking.sites.size() <= 1) {
-    return;
+    return boost::none;
   }
 
   Shapes::Shape shape = inferShape(candidateIndex, localRanking).value_or_eval(
@@ -79,18 +95,78 @@ void Molecule::Impl::tryAddAtomStereopermutator_(
     newStereopermutator.assign(0);
   }
 
-  stereopermutators.add(std::move(newStereopermutator));
+  return newStereopermutator;
 }
 
-void Molecule::Impl::tryAddBondStereopermutator_(
-  const BondIndex& bond,
-  StereopermutatorList& stereopermutators
+boost::optional<AtomStereopermutator> Molecule::Impl::transferAtomStereopermutator_(
+  const AtomIndex candidateIndex,
+  const boost::optional<AtomStereopermutator>& representativeOption,
+  const std::vector<AtomIndex>& automorphism
 ) const {
-  // If there is already a bond stereopermutator on this edge, stop
-  if(stereopermutators.option(bond)) {
-    return;
+  assert(stereopermutators_.empty());
+
+  // Terminality is preserved by automorphisms
+  if(!representativeOption) {
+    return boost::none;
+  }
+
+  MOLASSEMBLER_PROFILE_SCOPE("Molecule.transferAtomStereopermutator");
+
+  RankingInformation mapped = representativeOption->getRanking();
+  mapped.applyPermutation(automorphism);
+
+  /* Assemble the ranking as rankPriority does, but with the substituent
+   * ranking mapped instead of calculated. Equally ranked substituents are
+   * ordered as the ranking tree orders them: By their order of adjacency.
+   */
+  const CsrGraph& csr = adjacencies_.inner().csr();
+  const auto adjacents = csr.adjacents(candidateIndex);
+  auto adjacencyPosition = [&](const AtomIndex i) {
+    return std::find(std::begin(adjacents), std::end(adjacents), i) - std::begin(adjacents);
+  };
+
+  RankingInformation ranking;
+  ranking.sites = GraphAlgorithms::sites(adjacencies_.inner(), candidateIndex);
+  ranking.substituentRanking = mapped.substituentRanking;
+  for(auto& equalSubstituents : ranking.substituentRanking) {
+    std::sort(
+      std::begin(equalSubstituents),
+      std::end(equalSubstituents),
+      [&](const AtomIndex a, const AtomIndex b) {
+        return adjacencyPosition(a) < adjacencyPosition(b);
+      }
+    );
+  }
+  ranking.siteRanking = RankingInformation::rankSites(
+    ranking.sites,
+    ranking.substituentRanking
+  );
+  ranking.links = GraphAlgorithms::siteLinks(
+    adjacencies_.inner(),
+    candidateIndex,
+    ranking.sites,
+    {}
+  );
+
+  /* Mapping the representative's stereopermutator is only equivalent to
+   * constructing a new one if site indices are identical
+   */
+  if(
+    std::tie(ranking.sites, ranking.substituentRanking, ranking.siteRanking, ranking.links)
+    == std::tie(mapped.sites, mapped.substituentRanking, mapped.siteRanking, mapped.links)
+  ) {
+    AtomStereopermutator transferred = *representativeOption;
+    transferred.applyPermutation(automorphism);
+    return transferred;
   }
 
+  return makeAtomStereopermutator_(candidateIndex, std::move(ranking));
+}
+
+boost::optional<BondStereopermutator> Molecule::Impl::makeBondStereopermutator_(
+  const BondIndex& bond,
+  const StereopermutatorList& stereopermutators
+) const {
   AtomIndex source = bond.first;
   AtomIndex target = bond.second;
 
@@ -104,7 +180,7 @@ void Molecule::Impl::tryAddBondStereopermutator_(
     || sourceAtomStereopermutatorOption->assigned() == boost::none
     || targetAtomStereopermutatorOption->assigned() == boost::none
   ) {
-    return;
+    return boost::none;
   }
 
   // Construct a Stereopermutator here
@@ -120,7 +196,37 @@ void Molecule::Impl::tryAddBondStereopermutator_(
   }
 
   if(newStereopermutator.numStereopermutations() > 1) {
-    stereopermutators.add(std::move(newStereopermutator));
+    return newStereopermutator;
+  }
+
+  return boost::none;
+}
+
+void Molecule::Impl::tryAddAtomStereopermutator_(
+  AtomIndex candidateIndex,
+  StereopermutatorList& stereopermutators
+) const {
+  // If there is already an atom stereopermutator on this index, stop
+  if(stereopermutators.option(candidateIndex)) {
+    return;
+  }
+
+  if(auto stereopermutatorOption = makeAtomStereopermutator_(candidateIndex)) {
+    stereopermutators.add(std::move(*stereopermutatorOption));
+  }
+}
+
+void Molecule::Impl::tryAddBondStereopermutator_(
+  const BondIndex& bond,
+  StereopermutatorList& stereopermutators
+) const {
+  // If there is already a bond stereopermutator on this edge, stop
+  if(stereopermutators.option(bond)) {
+    return;
+  }
+
+  if(auto stereopermutatorOption = makeBondStereopermutator_(bond, stereopermutators)) {
+    stereopermutators.add(std::move(*stereopermutatorOption));
   }
 }
 
@@ -129,30 +235,143 @@ StereopermutatorList Molecule::Impl::detectStereopermutators_() const {
 
 #ifdef _OPENMP
   /* Ensure inner's properties are populated to avoid data races in its mutable
-   * members
+   * members, including the eta-preserving cycles that site links are found
+   * through during ranking
    */
   adjacencies_.inner().populateProperties();
 #endif
 
-  // Find AtomStereopermutators
-  for(
-    AtomIndex candidateIndex = 0;
-    candidateIndex < graph().N();
-    ++candidateIndex
-  ) {
-    tryAddAtomStereopermutator_(candidateIndex, stereopermutatorList);
+  /* Find AtomStereopermutators. Each candidate is ranked with its own
+   * RankingTree that only reads the graph, so candidates are independent.
+   * Construct concurrently, then insert in index order.
+   *
+   * Without any stereopermutators, rankings depend on the graph alone, and
+   * symmetry-equivalent atoms have equivalent rankings. Then only one atom
+   * per automorphism orbit is ranked. For small molecules, ranking every atom
+   * is cheaper than finding the orbits.
+   */
+  constexpr AtomIndex minimumOrbitRankingSize = 10;
+  const AtomIndex N = graph().N();
+  boost::optional<AutomorphismOrbits> orbitsOption;
+  if(stereopermutators_.empty() && N >= minimumOrbitRankingSize) {
+    orbitsOption = AutomorphismOrbits {
+      N,
+      automorphismGenerators(
+        adjacencies_.inner(),
+        Hashes::generate(
+          adjacencies_.inner(),
+          boost::none,
+          AtomEnvironmentComponents::ElementTypes | AtomEnvironmentComponents::BondOrders
+        )
+      )
+    };
+  }
+
+  auto isRepresentative = [&](const AtomIndex i) -> bool {
+    return !orbitsOption || orbitsOption->isRepresentative(i);
+  };
+
+  std::vector<boost::optional<AtomStereopermutator>> atomStereopermutators(N);
+  std::vector<std::exception_ptr> exceptions(N);
+#pragma omp parallel for schedule(dynamic)
+  for(AtomIndex candidateIndex = 0; candidateIndex < N; ++candidateIndex) {
+    if(!isRepresentative(candidateIndex)) {
+      continue;
+    }
+
+    try {
+      atomStereopermutators[candidateIndex] = makeAtomStereopermutator_(candidateIndex);
+    } catch(...) {
+      exceptions[candidateIndex] = std::current_exception();
+    }
   }
+  rethrowFirst(exceptions);
+
+  if(orbitsOption) {
+#pragma omp parallel for schedule(dynamic)
+    for(AtomIndex candidateIndex = 0; candidateIndex < N; ++candidateIndex) {
+      if(isRepresentative(candidateIndex)) {
+        continue;
+      }
 
-  // Find BondStereopermutators
+      try {
+        atomStereopermutators[candidateIndex] = transferAtomStereopermutator_(
+          candidateIndex,
+          atomStereopermutators[orbitsOption->representative(candidateIndex)],
+          orbitsOption->automorphism(candidateIndex)
+        );
+      } catch(...) {
+        exceptions[candidateIndex] = std::current_exception();
+      }
+    }
+    rethrowFirst(exceptions);
+  }
+
+  for(auto& stereopermutatorOption : atomStereopermutators) {
+    if(stereopermutatorOption) {
+      stereopermutatorList.add(std::move(*stereopermutatorOption));
+    }
+  }
+
+  // Find BondStereopermutators in the same fashion
+  std::vector<BondIndex> candidateBonds;
   for(BondIndex bond : graph().bonds()) {
     if(isGraphBasedBondStereopermutatorCandidate_(graph().bondType(bond))) {
-      tryAddBondStereopermutator_(bond, stereopermutatorList);
+      candidateBonds.push_back(bond);
+    }
+  }
+
+  const unsigned B = candidateBonds.size();
+  std::vector<boost::optional<BondStereopermutator>> bondStereopermutators(B);
+  exceptions.assign(B, nullptr);
+#pragma omp parallel for schedule(dynamic)
+  for(unsigned i = 0; i < B; ++i) {
+    try {
+      bondStereopermutators[i] = makeBondStereopermutator_(candidateBonds[i], stereopermutatorList);
+    } catch(...) {
+      exceptions[i] = std::current_exception();
+    }
+  }
+  rethrowFirst(exceptions);
+
+  for(auto& stereopermutatorOption : bondStereopermutators) {
+    if(stereopermutatorOption) {
+      stereopermutatorList.add(std::move(*stereopermutatorOption));
     }
   }
 
   return stereopermutatorList;
 }
 
+void Molecule::Impl::materializeStereopermutators_() const {
+  if(!stereopermutatorsDeferred_) {
+    return;
+  }
+
+  /* Detection itself reads the (empty) member list through
+   * stereopermutators(), so clear the flag beforehand and restore it if
+   * detection fails.
+   */
+  stereopermutatorsDeferred_ = false;
+  try {
+    stereopermutators_ = detectStereopermutators_();
+  } catch(...) {
+    stereopermutatorsDeferred_ = true;
+    throw;
+  }
+}
+
+const StereopermutatorList& Molecule::Impl::stereopermutatorsFor_(
+  const AtomEnvironmentComponents componentBitmask
+) const {
+  // Stereopermutations are only considered alongside shapes
+  if(componentBitmask & AtomEnvironmentComponents::Shapes) {
+    materializeStereopermutators_();
+  }
+
+  return stereopermutators_;
+}
+
 void Molecule::Impl::ensureModelInvariants_() const {
   if(graph().inner().connectedComponents() > 1) {
     throw std::logic_error("Molecules must be a single connected component. The supplied graph has multiple");
@@ -180,6 +399,15 @@ bool Molecule::Impl::isGraphBasedBondStereopermutatorCandidate_(
 }
 
 void Molecule::Impl::propagateGraphChange_() {
+  /* Deferred detection will see the modified graph anyway, there is no state
+   * to propagate
+   */
+  if(stereopermutatorsDeferred_) {
+    return;
+  }
+
+  MOLASSEMBLER_PROFILE_SCOPE("Molecule.propagateGraphChange");
+
   /* Two cases: If the StereopermutatorList is empty, we can just use detect to
    * find any new stereopermutators in the Molecule.
    */
@@ -215,69 +443,7 @@ void Molecule::Impl::propagateGraphChange_() {
         continue;
       }
 
-      // Are there adjacent bond stereopermutators?
-      std::vector<BondIndex> adjacentBondStereopermutators;
-      for(BondIndex bond : adjacencies_.bonds(vertex)) {
-        if(stereopermutators_.option(bond)) {
-          adjacentBondStereopermutators.push_back(std::move(bond));
-        }
-      }
-
-      // Suggest a shape if desired
-      boost::optional<Shapes::Shape> newShapeOption;
-      if(Options::shapeTransition == ShapeTransition::PrioritizeInferenceFromGraph) {
-        newShapeOption = inferShape(vertex, localRanking);
-      }
-
-      // Propagate the state
-      auto oldAtomStereopermutatorStateOption = stereopermutatorOption->propagate(
-        adjacencies_,
-        std::move(localRanking),
-        newShapeOption
-      );
-
-      /* If the modified stereopermutator has only one assignment and is
-       * unassigned due to the graph change, default-assign it
-       */
-      if(
-        stereopermutatorOption->numAssignments() == 1
-        && stereopermutatorOption->assigned() == boost::none
-      ) {
-        stereopermutatorOption->assign(0);
-      }
-
-      /* If the chiral state for this atom stereopermutator was not successfully
-       * propagated or it is now unassigned, then bond stereopermutators sharing
-       * this atom stereopermutator must be removed. Bond stereopermutators can
-       * only be undetermined if its constituting atom stereopermutators are
-       * assigned.
-       */
-      if(!stereopermutatorOption->assigned()) {
-        for(const BondIndex& bond : adjacentBondStereopermutators) {
-          stereopermutators_.remove(bond);
-        }
-
-        continue;
-      }
-
-      /* If the chiral state for this atom stereopermutator was successfully
-       * propagated and/or the permutator could be default-assigned, we can also
-       * propagate adjacent BondStereopermutators.
-       *
-       * TODO we may have to keep track if assignments change within the
-       * propagated bondstereopermutators, or if any bond stereopermutators
-       * are removed, since this may cause another re-rank!
-       */
-      if(oldAtomStereopermutatorStateOption) {
-        for(const BondIndex& bond : adjacentBondStereopermutators) {
-          stereopermutators_.option(bond)->propagateGraphChange(
-            *oldAtomStereopermutatorStateOption,
-            *stereopermutatorOption,
-            inner,
-            stereopermutators_
-          );
-        }
-      }
+      propagateAtomStereopermutator_(vertex, std::move(localRanking));
     } else {
       // There is no atom stereopermutator on this vertex, so try to add one
       tryAddAtomStereopermutator_(vertex, stereopermutators_);
@@ -292,6 +458,136 @@ void Molecule::Impl::propagateGraphChange_() {
   }
 }
 
+void Molecule::Impl::propagateAtomStereopermutator_(
+  const AtomIndex vertex,
+  RankingInformation ranking
+) {
+  auto stereopermutatorOption = stereopermutators_.option(vertex);
+  assert(stereopermutatorOption);
+
+  // Are there adjacent bond stereopermutators?
+  std::vector<BondIndex> adjacentBondStereopermutators;
+  for(BondIndex bond : adjacencies_.bonds(vertex)) {
+    if(stereopermutators_.option(bond)) {
+      adjacentBondStereopermutators.push_back(std::move(bond));
+    }
+  }
+
+  // Suggest a shape if desired
+  boost::optional<Shapes::Shape> newShapeOption;
+  if(Options::shapeTransition == ShapeTransition::PrioritizeInferenceFromGraph) {
+    newShapeOption = inferShape(vertex, ranking);
+  }
+
+  // Propagate the state
+  auto oldAtomStereopermutatorStateOption = stereopermutatorOption->propagate(
+    adjacencies_,
+    std::move(ranking),
+    newShapeOption
+  );
+
+  /* If the modified stereopermutator has only one assignment and is
+   * unassigned due to the graph change, default-assign it
+   */
+  if(
+    stereopermutatorOption->numAssignments() == 1
+    && stereopermutatorOption->assigned() == boost::none
+  ) {
+    stereopermutatorOption->assign(0);
+  }
+
+  /* If the chiral state for this atom stereopermutator was not successfully
+   * propagated or it is now unassigned, then bond stereopermutators sharing
+   * this atom stereopermutator must be removed. Bond stereopermutators can
+   * only be undetermined if its constituting atom stereopermutators are
+   * assigned.
+   */
+  if(!stereopermutatorOption->assigned()) {
+    for(const BondIndex& bond : adjacentBondStereopermutators) {
+      stereopermutators_.remove(bond);
+    }
+
+    return;
+  }
+
+  /* If the chiral state for this atom stereopermutator was successfully
+   * propagated and/or the permutator could be default-assigned, we can also
+   * propagate adjacent BondStereopermutators.
+   *
+   * TODO we may have to keep track if assignments change within the
+   * propagated bondstereopermutators, or if any bond stereopermutators
+   * are removed, since this may cause another re-rank!
+   */
+  if(oldAtomStereopermutatorStateOption) {
+    for(const BondIndex& bond : adjacentBondStereopermutators) {
+      stereopermutators_.option(bond)->propagateGraphChange(
+        *oldAtomStereopermutatorStateOption,
+        *stereopermutatorOption,
+        adjacencies_.inner(),
+        stereopermutators_
+      );
+    }
+  }
+}
+
+void Molecule::Impl::propagateEdit_(const std::vector<AtomIndex>& editedAtoms) {
+  if(editDepth_ == 0) {
+    propagateGraphChange_();
+    return;
+  }
+
+  propagationPending_ = true;
+  if(stereopermutatorsDeferred_) {
+    return;
+  }
+
+  MOLASSEMBLER_PROFILE_SCOPE("Molecule.propagateEdit");
+
+  GraphAlgorithms::updateEtaBonds(adjacencies_.inner());
+
+  /* Sites are formed by bonds between adjacent atoms, so an edit can only
+   * change the number of sites of the edited atoms and atoms adjacent to them
+   */
+  std::vector<AtomIndex> candidates = editedAtoms;
+  for(const AtomIndex edited : editedAtoms) {
+    for(const AtomIndex adjacent : adjacencies_.adjacents(edited)) {
+      candidates.push_back(adjacent);
+    }
+  }
+  std::sort(std::begin(candidates), std::end(candidates));
+  candidates.erase(
+    std::unique(std::begin(candidates), std::end(candidates)),
+    std::end(candidates)
+  );
+
+  for(const AtomIndex vertex : candidates) {
+    auto stereopermutatorOption = stereopermutators_.option(vertex);
+    if(!stereopermutatorOption) {
+      continue;
+    }
+
+    RankingInformation localRanking = rankPriority(vertex);
+    if(localRanking.sites.size() <= 1) {
+      stereopermutators_.remove(vertex);
+      continue;
+    }
+
+    // Changes in ranking alone can wait for the commit
+    if(localRanking.sites.size() == stereopermutatorOption->getRanking().sites.size()) {
+      continue;
+    }
+
+    propagateAtomStereopermutator_(vertex, std::move(localRanking));
+  }
+}
+
+void Molecule::Impl::propagatePendingEdits_() {
+  if(propagationPending_) {
+    propagationPending_ = false;
+    propagateGraphChange_();
+  }
+}
+
 /* Public members */
 /* Constructors */
 Molecule::Impl::Impl() noexcept
@@ -323,6 +619,14 @@ Molecule::Impl::Impl(Graph graph)
   ensureModelInvariants_();
 }
 
+Molecule::Impl::Impl(Graph graph, DeferStereopermutatorsTag /* tag */)
+  : adjacencies_(std::move(graph)),
+    stereopermutatorsDeferred_(true)
+{
+  GraphAlgorithms::updateEtaBonds(adjacencies_.inner());
+  ensureModelInvariants_();
+}
+
 Molecule::Impl::Impl(
   Graph graph,
   const AngstromPositions& positions,
@@ -364,7 +668,8 @@ AtomIndex Molecule::Impl::addAtom(
   const AtomIndex index = adjacencies_.inner().addVertex(elementType);
   addBond(index, adjacentTo, bondType);
   /* addBond handles the stereopermutator update on adjacentTo and also
-   * performs a full-molecule rerank propagation.
+   * performs a full-molecule rerank propagation, unless deferred by an edit
+   * transaction.
    */
 
   return index;
@@ -399,7 +704,7 @@ BondIndex Molecule::Impl::addBond(
   notifySubstituentAddition(a);
   notifySubstituentAddition(b);
 
-  propagateGraphChange_();
+  propagateEdit_({a, b});
   canonicalComponentsOption_ = boost::none;
 
   return BondIndex {a, b};
@@ -419,6 +724,8 @@ void Molecule::Impl::assignStereopermutator(
     throw std::out_of_range("Molecule::assignStereopermutator: Supplied index is invalid!");
   }
 
+  materializeStereopermutators_();
+  propagatePendingEdits_();
   auto stereopermutatorOption = stereopermutators_.option(a);
 
   if(!stereopermutatorOption) {
@@ -437,7 +744,7 @@ void Molecule::Impl::assignStereopermutator(
     stereopermutatorOption->assign(assignmentOption);
 
     // A reassignment can change ranking! See the RankingTree tests
-    propagateGraphChange_();
+    propagateEdit_({});
     canonicalComponentsOption_ = boost::none;
   }
 }
@@ -450,6 +757,8 @@ void Molecule::Impl::assignStereopermutator(
     throw std::out_of_range("Molecule::assignStereopermutator: Supplied bond atom indices is invalid!");
   }
 
+  materializeStereopermutators_();
+  propagatePendingEdits_();
   auto stereopermutatorOption = stereopermutators_.option(edge);
 
   if(!stereopermutatorOption) {
@@ -468,7 +777,7 @@ void Molecule::Impl::assignStereopermutator(
     stereopermutatorOption->assign(assignmentOption);
 
     // A reassignment can change ranking! See the RankingTree tests
-    propagateGraphChange_();
+    propagateEdit_({});
     canonicalComponentsOption_ = boost::none;
   }
 }
@@ -478,6 +787,8 @@ void Molecule::Impl::assignStereopermutatorRandomly(const AtomIndex a, Random::E
     throw std::out_of_range("Molecule::assignStereopermutatorRandomly: Supplied index is invalid!");
   }
 
+  materializeStereopermutators_();
+  propagatePendingEdits_();
   auto stereopermutatorOption = stereopermutators_.option(a);
 
   if(!stereopermutatorOption) {
@@ -487,11 +798,13 @@ void Molecule::Impl::assignStereopermutatorRandomly(const AtomIndex a, Random::E
   stereopermutatorOption->assignRandom(engine);
 
   // A reassignment can change ranking! See the RankingTree tests
-  propagateGraphChange_();
+  propagateEdit_({});
   canonicalComponentsOption_ = boost::none;
 }
 
 void Molecule::Impl::assignStereopermutatorRandomly(const BondIndex& e, Random::Engine& engine) {
+  materializeStereopermutators_();
+  propagatePendingEdits_();
   auto stereopermutatorOption = stereopermutators_.option(e);
 
   if(!stereopermutatorOption) {
@@ -501,17 +814,19 @@ void Molecule::Impl::assignStereopermutatorRandomly(const BondIndex& e, Random::
   stereopermutatorOption->assignRandom(engine);
 
   // A reassignment can change ranking! See the RankingTree tests
-  propagateGraphChange_();
+  propagateEdit_({});
   canonicalComponentsOption_ = boost::none;
 }
 
 std::vector<AtomIndex> Molecule::Impl::canonicalize(
   const AtomEnvironmentComponents componentBitmask
 ) {
+  MOLASSEMBLER_PROFILE_SCOPE("Molecule.canonicalize");
+
   // Generate hashes according to the passed bitmask
   auto vertexHashes = Hashes::generate(
     graph().inner(),
-    stereopermutators(),
+    stereopermutatorsFor_(componentBitmask),
     componentBitmask
   );
 
@@ -626,7 +941,8 @@ void Molecule::Impl::removeAtom(const AtomIndex a) {
     }*/
   }
 
-  propagateGraphChange_();
+  // Adjacent atoms that could change their number of sites are handled above
+  propagateEdit_({});
   canonicalComponentsOption_ = boost::none;
 }
 
@@ -705,7 +1021,7 @@ void Molecule::Impl::removeBond(
    * on a or b, should be handled correctly by propagateGraphChange_.
    */
 
-  propagateGraphChange_();
+  propagateEdit_({a, b});
   canonicalComponentsOption_ = boost::none;
 }
 
@@ -733,7 +1049,8 @@ bool Molecule::Impl::setBondType(
   }
 
   inner.bondType(edgeOption.value()) = bondType;
-  propagateGraphChange_();
+  // Bond type changes can form or dissolve haptic sites at either atom
+  propagateEdit_({a, b});
   canonicalComponentsOption_ = boost::none;
   return true;
 }
@@ -747,7 +1064,8 @@ void Molecule::Impl::setElementType(
   }
 
   adjacencies_.inner().elementType(a) = elementType;
-  propagateGraphChange_();
+  // Element type changes can form or dissolve haptic sites at the atom
+  propagateEdit_({a});
   canonicalComponentsOption_ = boost::none;
 }
 
@@ -759,6 +1077,8 @@ void Molecule::Impl::setShapeAtAtom(
     throw std::out_of_range("Molecule::setShapeAtAtom: Supplied atom index is invalid");
   }
 
+  materializeStereopermutators_();
+  propagatePendingEdits_();
   auto stereopermutatorOption = stereopermutators_.option(a);
 
   // If there is no stereopermutator at this position yet, we have to create it
@@ -787,7 +1107,7 @@ void Molecule::Impl::setShapeAtAtom(
 
     stereopermutators_.add(std::move(newStereopermutator));
 
-    propagateGraphChange_();
+    propagateEdit_({});
     canonicalComponentsOption_ = boost::none;
     return;
   }
@@ -817,16 +1137,32 @@ void Molecule::Impl::setShapeAtAtom(
     stereopermutators_.try_remove(bond);
   }
 
-  propagateGraphChange_();
+  propagateEdit_({});
   canonicalComponentsOption_ = boost::none;
 }
 
+void Molecule::Impl::beginEdit() {
+  ++editDepth_;
+}
+
+void Molecule::Impl::commitEdit() {
+  if(editDepth_ == 0) {
+    throw std::logic_error("Molecule::commitEdit: No edit transaction is open");
+  }
+
+  --editDepth_;
+  if(editDepth_ == 0) {
+    propagatePendingEdits_();
+  }
+}
+
 /* Information */
 boost::optional<AtomEnvironmentComponents> Molecule::Impl::canonicalComponents() const {
   return canonicalComponentsOption_;
 }
 
 std::string Molecule::Impl::str() const {
+  materializeStereopermutators_();
   std::stringstream info;
 
   if(!stereopermutators_.empty()) {
@@ -871,6 +1207,7 @@ boost::optional<Shapes::Shape> Molecule::Impl::inferShape(
 }
 
 std::string Molecule::Impl::dumpGraphviz() const {
+  materializeStereopermutators_();
   MolGraphWriter propertyWriter(&adjacencies_.inner(), &stereopermutators_);
 
   std::stringstream graphvizStream;
@@ -897,32 +1234,21 @@ std::size_t Molecule::Impl::hash() const {
 
   auto hashes = Hashes::generate(
     graph().inner(),
-    stereopermutators_,
+    stereopermutatorsFor_(canonicalComponentsOption_.value()),
     canonicalComponentsOption_.value()
   );
 
   // Convolute all of the wide hashes into a size_t hash
-  static_assert(
-    std::is_same<Hashes::WideHashType, boost::multiprecision::uint128_t>::value,
-    "WideHash is no longer the boost multiprecision 128 uint"
-  );
-  constexpr unsigned wideHashBytes = 128 / 8;
-  std::vector<std::size_t> wideHashParts (wideHashBytes / sizeof(std::size_t));
   std::size_t hash = 0;
   for(const auto& wideHash : hashes) {
-    boost::multiprecision::export_bits(
-      wideHash,
-      std::begin(wideHashParts),
-      8 * sizeof(std::size_t)
-    );
-    for(const std::size_t& v : wideHashParts) {
-      boost::hash_combine(hash, v);
-    }
+    boost::hash_combine(hash, wideHash.high);
+    boost::hash_combine(hash, wideHash.low);
   }
   return hash;
 }
 
 const StereopermutatorList& Molecule::Impl::stereopermutators() const {
+  materializeStereopermutators_();
   return stereopermutators_;
 }
 
@@ -1065,9 +1391,9 @@ bool Molecule::Impl::canonicalCompare(
   return (
     Hashes::identityCompare(
       graph().inner(),
-      stereopermutators(),
+      stereopermutatorsFor_(componentBitmask),
       other.graph().inner(),
-      other.stereopermutators(),
+      other.stereopermutatorsFor_(componentBitmask),
       componentBitmask
     ) && graph().inner().identicalGraph(other.graph().inner())
   );
@@ -1108,8 +1434,8 @@ boost::optional<std::vector<AtomIndex>> Molecule::Impl::modularIsomorphism(
   Hashes::HashType maxHash;
 
   std::tie(thisHashes, otherHashes, maxHash) = Hashes::narrow(
-    Hashes::generate(graph().inner(), stereopermutators(), componentBitmask),
-    Hashes::generate(other.graph().inner(), other.stereopermutators(), componentBitmask)
+    Hashes::generate(graph().inner(), stereopermutatorsFor_(componentBitmask), componentBitmask),
+    Hashes::generate(other.graph().inner(), other.stereopermutatorsFor_(componentBitmask), componentBitmask)
   );
 
   // Where the corresponding index from the other graph is stored
@@ -1149,6 +1475,8 @@ RankingInformation Molecule::Impl::rankPriority(
     throw std::out_of_range("Supplied atom index is invalid!");
   }
 
+  MOLASSEMBLER_PROFILE_SCOPE("Molecule.rankPriority");
+
   RankingInformation rankingResult;
 
   // Expects that bond types are set properly, complains otherwise
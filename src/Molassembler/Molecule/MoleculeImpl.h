@@ -10,6 +10,8 @@
 
 #include "Molassembler/Molecule.h"
 
+#include "Molassembler/AtomStereopermutator.h"
+#include "Molassembler/BondStereopermutator.h"
 #include "Molassembler/Graph.h"
 #include "Molassembler/Graph/PrivateGraph.h"
 #include "Molassembler/StereopermutatorList.h"
@@ -28,10 +30,64 @@ struct Molecule::Impl {
   static bool isGraphBasedBondStereopermutatorCandidate_(BondType bondType);
 
   Graph adjacencies_;
-  StereopermutatorList stereopermutators_;
+  /* Stereopermutators may be detected lazily, so the list and the flag
+   * indicating that detection is outstanding are mutable
+   */
+  mutable StereopermutatorList stereopermutators_;
+  mutable bool stereopermutatorsDeferred_ = false;
   boost::optional<AtomEnvironmentComponents> canonicalComponentsOption_;
+  //! Number of open edit transactions
+  unsigned editDepth_ = 0;
+  //! Whether a full propagation is outstanding in an edit transaction
+  bool propagationPending_ = false;
 
 /* "Private" helpers */
+  /*! @brief Constructs an atom stereopermutator on a vertex if it is non-terminal
+   *
+   * Reads only the graph and the member stereopermutator list, so calls for
+   * different vertices may run concurrently if the graph's properties are
+   * populated.
+   */
+  boost::optional<AtomStereopermutator> makeAtomStereopermutator_(
+    AtomIndex candidateIndex
+  ) const;
+
+  //! Constructs an atom stereopermutator on a vertex from its ranking
+  boost::optional<AtomStereopermutator> makeAtomStereopermutator_(
+    AtomIndex candidateIndex,
+    RankingInformation ranking
+  ) const;
+
+  /*! @brief Constructs an atom stereopermutator on a vertex from that of a
+   *   symmetry-equivalent vertex
+   *
+   * The ranking is mapped through the automorphism instead of being
+   * recalculated. If the mapped ranking is identical to the ranking of the
+   * vertex as rankPriority would assemble it, the stereopermutator is mapped
+   * too. Otherwise, it is constructed from the mapped ranking.
+   *
+   * @param candidateIndex Vertex to construct a stereopermutator on
+   * @param representativeOption Stereopermutator of the equivalent vertex
+   * @param automorphism Graph automorphism mapping the equivalent vertex
+   *   onto @p candidateIndex
+   *
+   * @pre The member stereopermutator list is empty, since rankings could
+   *   otherwise differ between symmetry-equivalent vertices.
+   */
+  boost::optional<AtomStereopermutator> transferAtomStereopermutator_(
+    AtomIndex candidateIndex,
+    const boost::optional<AtomStereopermutator>& representativeOption,
+    const std::vector<AtomIndex>& automorphism
+  ) const;
+
+  /*! @brief Constructs a bond stereopermutator on an edge if both constituting
+   *   atom stereopermutators are assigned and multiple stereopermutations exist
+   */
+  boost::optional<BondStereopermutator> makeBondStereopermutator_(
+    const BondIndex& bond,
+    const StereopermutatorList& stereopermutators
+  ) const;
+
   void tryAddAtomStereopermutator_(
     AtomIndex candidateIndex,
     StereopermutatorList& stereopermutators
@@ -42,9 +98,34 @@ struct Molecule::Impl {
     StereopermutatorList& stereopermutators
   ) const;
 
-  //! Generates a list of stereopermutators based on graph properties alone
+  /*! @brief Generates a list of stereopermutators based on graph properties alone
+   *
+   * Atom stereopermutators and then bond stereopermutators are constructed
+   * concurrently if OpenMP is available and inserted into the list in index
+   * order, so the result is independent of the number of threads.
+   *
+   * Atoms are ranked once per automorphism orbit of the graph. Atom
+   * stereopermutators of the remaining atoms of each orbit are transferred
+   * from the orbit's representative.
+   */
   StereopermutatorList detectStereopermutators_() const;
 
+  /*! @brief Performs outstanding deferred stereopermutator detection
+   *
+   * @warning Not thread-safe, like the lazily populated graph properties.
+   */
+  void materializeStereopermutators_() const;
+
+  /*! @brief Stereopermutators required for atom environment comparisons with
+   *   a particular set of components
+   *
+   * Detection of deferred stereopermutators is skipped if the components do
+   * not include shapes, since stereopermutators are then irrelevant.
+   */
+  const StereopermutatorList& stereopermutatorsFor_(
+    AtomEnvironmentComponents componentBitmask
+  ) const;
+
   //! Ensures basic expectations about what constitutes a Molecule are met
   void ensureModelInvariants_() const;
 
@@ -54,6 +135,31 @@ struct Molecule::Impl {
   //! Updates the molecule's StereopermutatorList after a graph modification
   void propagateGraphChange_();
 
+  /*! @brief Propagates an atom stereopermutator to a changed ranking
+   *
+   * Default-assigns the stereopermutator if it has a single assignment and
+   * propagates or removes bond stereopermutators on adjacent bonds.
+   */
+  void propagateAtomStereopermutator_(
+    AtomIndex vertex,
+    RankingInformation ranking
+  );
+
+  /*! @brief Updates the StereopermutatorList after an edit
+   *
+   * Outside of edit transactions, this is a full propagation. Within a
+   * transaction, only atom stereopermutators whose number of sites changed
+   * are propagated immediately, since propagation is limited to single site
+   * changes. These can only be on the edited atoms or atoms adjacent to them.
+   * Re-ranking everywhere else is deferred until the transaction is committed.
+   *
+   * @param editedAtoms Atoms whose bonds were added or removed
+   */
+  void propagateEdit_(const std::vector<AtomIndex>& editedAtoms);
+
+  //! Performs any full propagation deferred in an open edit transaction
+  void propagatePendingEdits_();
+
 
 //!@name Constructors
 //!@{
@@ -73,6 +179,9 @@ struct Molecule::Impl {
   //! Graph-only constructor
   explicit Impl(Graph graph);
 
+  //! Graph-only constructor deferring stereopermutator detection
+  Impl(Graph graph, DeferStereopermutatorsTag tag);
+
   //! Graph and positions constructor
   Impl(
     Graph graph,
@@ -260,6 +369,12 @@ struct Molecule::Impl {
     AtomIndex a,
     Shapes::Shape shape
   );
+
+  //! Opens an edit transaction, deferring full propagations
+  void beginEdit();
+
+  //! Closes an edit transaction, propagating once if it is the outermost one
+  void commitEdit();
 //!@}
 
 //!@name Information
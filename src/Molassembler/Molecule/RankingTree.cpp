@@ -23,6 +23,7 @@
 #include "Molassembler/Modeling/ShapeInference.h"
 #include "Molassembler/Molecule/MolGraphWriter.h"
 #include "Molassembler/Options.h"
+#include "Molassembler/Profiling.h"
 #include "Molassembler/StereopermutatorList.h"
 #include "Molassembler/Stereopermutators/AbstractPermutations.h"
 #include "Molassembler/Stereopermutators/FeasiblePermutations.h"
@@ -2435,7 +2436,7 @@ std::vector<RankingTree::TreeVertexIndex> RankingTree::expand_(
 
   for(
     const PrivateGraph::Vertex& molAdjacentIndex :
-    graph_.inner().adjacents(tree_[index].molIndex)
+    graph_.inner().csr().adjacents(tree_[index].molIndex)
   ) {
     if(treeOutAdjacencies.count(molAdjacentIndex) != 0) {
       continue;
@@ -2718,15 +2719,13 @@ std::vector<RankingTree::TreeVertexIndex> RankingTree::addBondOrderDuplicates_(
 ) {
   std::vector<TreeVertexIndex> newIndices;
 
-  BondIndex molGraphEdge {
-    tree_[treeSource].molIndex,
-    tree_[treeTarget].molIndex
-  };
-
   /* In case the bond order is non-fractional (e.g. aromatic / eta)
    * and > 1, add duplicate atoms corresponding to the order.
    */
-  BondType bondType = graph_.bondType(molGraphEdge);
+  BondType bondType = graph_.inner().csr().bondType(
+    tree_[treeSource].molIndex,
+    tree_[treeTarget].molIndex
+  );
 
   double bondOrder = Bond::bondOrderMap.at(
     static_cast<unsigned>(bondType)
@@ -2972,6 +2971,9 @@ RankingTree::RankingTree(
     stereopermutatorsRef_(stereopermutators),
     adaptedMolGraphviz_(adaptMolGraph_(std::move(molGraphviz)))
 {
+  MOLASSEMBLER_PROFILE_SCOPE("RankingTree");
+  MOLASSEMBLER_PROFILE_COUNT("RankingTree.trees", 1);
+
   // Add the root index
   boost::add_vertex(tree_);
 
@@ -2984,7 +2986,7 @@ RankingTree::RankingTree(
   std::set<TreeVertexIndex> branchIndices;
   for(
     const AtomIndex rootAdjacentIndex :
-    graph_.inner().adjacents(atomToRank)
+    graph_.inner().csr().adjacents(atomToRank)
   ) {
     if(
       std::find(
@@ -3456,6 +3458,8 @@ std::vector<
 std::vector<
   std::vector<AtomIndex>
 > RankingTree::getRanked() const {
+  MOLASSEMBLER_PROFILE_COUNT("RankingTree.vertices", boost::num_vertices(tree_));
+
   // We must transform the ranked tree vertex indices back to molecule indices.
   return mapToAtomIndices_(
     branchOrderingHelper_.getSets()
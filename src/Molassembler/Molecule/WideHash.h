@@ -0,0 +1,120 @@
+/*!@file
+ * @copyright This code is licensed under the 3-clause BSD license.
+ *   Copyright ETH Zurich, Laboratory of Physical Chemistry, Reiher Group.
+ *   See LICENSE.txt for details.
+ * @brief Fixed-width 128 bit unsigned integer for atom environment hashes
+ */
+
+#ifndef INCLUDE_MOLASSEMBLER_WIDE_HASH_H
+#define INCLUDE_MOLASSEMBLER_WIDE_HASH_H
+
+#include "boost/functional/hash.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <ostream>
+
+namespace Scine {
+namespace Molassembler {
+namespace Hashes {
+
+/**
+ * @brief 128 bit unsigned integer stored as two native 64 bit words
+ *
+ * Atom environment hashes are packed field by field and then only ever
+ * compared, ordered or hashed, so the full arithmetic of a multiprecision
+ * integer is unnecessary.
+ */
+struct WideHashType {
+  //! Number of bits
+  static constexpr unsigned bits = 128;
+
+  //! Least significant 64 bits
+  std::uint64_t low = 0;
+  //! Most significant 64 bits
+  std::uint64_t high = 0;
+
+  constexpr WideHashType() = default;
+  constexpr WideHashType(const std::uint64_t passLow) : low(passLow) {}
+  constexpr WideHashType(const std::uint64_t passHigh, const std::uint64_t passLow)
+    : low(passLow), high(passHigh) {}
+
+  /*! @brief Add a value shifted by a bit offset, modulo @math{2^{128}}
+   *
+   * Bits shifted past the most significant bit are discarded. Addition
+   * rather than bitwise-or keeps hashes of overlapping fields identical to
+   * those of a multiprecision integer.
+   *
+   * @complexity{@math{\Theta(1)}}
+   */
+  inline WideHashType& addBits(const std::uint64_t value, const unsigned offset) {
+    std::uint64_t shiftedLow = 0;
+    std::uint64_t shiftedHigh = 0;
+    if(offset < 64) {
+      shiftedLow = value << offset;
+      if(offset > 0) {
+        shiftedHigh = value >> (64 - offset);
+      }
+    } else if(offset < bits) {
+      shiftedHigh = value << (offset - 64);
+    }
+
+    low += shiftedLow;
+    const std::uint64_t carry = (low < shiftedLow) ? 1 : 0;
+    high += shiftedHigh + carry;
+    return *this;
+  }
+
+  inline bool operator == (const WideHashType& other) const {
+    return low == other.low && high == other.high;
+  }
+
+  inline bool operator != (const WideHashType& other) const {
+    return !(*this == other);
+  }
+
+  inline bool operator < (const WideHashType& other) const {
+    return high < other.high || (high == other.high && low < other.low);
+  }
+
+  inline bool operator > (const WideHashType& other) const {
+    return other < *this;
+  }
+};
+
+//! Mix both words into a single hash value, most significant word first
+inline std::size_t hash_value(const WideHashType& hash) {
+  std::size_t seed = 0;
+  boost::hash_combine(seed, hash.high);
+  boost::hash_combine(seed, hash.low);
+  return seed;
+}
+
+//! Write the integer in hexadecimal
+inline std::ostream& operator << (std::ostream& os, const WideHashType& hash) {
+  const auto flags = os.flags();
+  const auto fill = os.fill('0');
+  os << "0x" << std::hex << std::setw(16) << hash.high
+    << std::setw(16) << hash.low;
+  os.flags(flags);
+  os.fill(fill);
+  return os;
+}
+
+} // namespace Hashes
+} // namespace Molassembler
+} // namespace Scine
+
+namespace std {
+
+template<>
+struct hash<Scine::Molassembler::Hashes::WideHashType> {
+  inline std::size_t operator() (const Scine::Molassembler::Hashes::WideHashType& hash) const {
+    return Scine::Molassembler::Hashes::hash_value(hash);
+  }
+};
+
+} // namespace std
+
+#endif
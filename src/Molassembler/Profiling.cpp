@@ -0,0 +1,279 @@
+/*!@file
+ * @copyright This code is licensed under the 3-clause BSD license.
+ *   Copyright ETH Zurich, Laboratory of Physical Chemistry, Reiher Group.
+ *   See LICENSE.txt for details.
+ */
+
+#include "Molassembler/Profiling.h"
+
+#include "nlohmann/json.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Scine {
+namespace Molassembler {
+namespace Profiling {
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct TimerAggregate {
+  std::uint64_t calls = 0;
+  std::uint64_t totalNanoseconds = 0;
+  std::uint64_t minNanoseconds = std::numeric_limits<std::uint64_t>::max();
+  std::uint64_t maxNanoseconds = 0;
+
+  void add(const std::uint64_t nanoseconds) {
+    ++calls;
+    totalNanoseconds += nanoseconds;
+    minNanoseconds = std::min(minNanoseconds, nanoseconds);
+    maxNanoseconds = std::max(maxNanoseconds, nanoseconds);
+  }
+
+  void merge(const TimerAggregate& other) {
+    calls += other.calls;
+    totalNanoseconds += other.totalNanoseconds;
+    minNanoseconds = std::min(minNanoseconds, other.minNanoseconds);
+    maxNanoseconds = std::max(maxNanoseconds, other.maxNanoseconds);
+  }
+
+  nlohmann::json toJSON() const {
+    return {
+      {"calls", calls},
+      {"total_ns", totalNanoseconds},
+      {"min_ns", minNanoseconds},
+      {"max_ns", maxNanoseconds}
+    };
+  }
+};
+
+struct TraceEvent {
+  unsigned nameIndex;
+  std::uint64_t startNanoseconds;
+  std::uint64_t durationNanoseconds;
+};
+
+/* Keep memory usage of trace event recording bounded in long-running
+ * processes. Events past this limit per thread are dropped and counted.
+ */
+constexpr std::size_t maxTraceEventsPerThread = 1 << 20;
+
+//! Data recorded by a single thread. Only ever written by its owning thread
+struct ThreadData {
+  explicit ThreadData(unsigned index) : threadIndex(index) {}
+
+  unsigned threadIndex;
+  std::vector<TimerAggregate> timers;
+  std::vector<std::uint64_t> counters;
+  std::vector<TraceEvent> events;
+  std::uint64_t droppedEvents = 0;
+};
+
+/* Global state: the name registry and ownership of all per-thread data. Thread
+ * data outlives its thread so that data recorded by e.g. OpenMP worker threads
+ * can be exported later.
+ */
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::string> names;
+  std::vector<std::unique_ptr<ThreadData>> threads;
+  const Clock::time_point epoch = Clock::now();
+};
+
+Registry& registry() {
+  static Registry instance;
+  return instance;
+}
+
+ThreadData& threadData() {
+  thread_local ThreadData* dataPtr = nullptr;
+  if(dataPtr == nullptr) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.threads.push_back(
+      std::make_unique<ThreadData>(reg.threads.size())
+    );
+    dataPtr = reg.threads.back().get();
+  }
+
+  return *dataPtr;
+}
+
+std::uint64_t nanoseconds(const Clock::duration duration) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+}
+
+nlohmann::json timersJSON(
+  const std::vector<TimerAggregate>& timers,
+  const std::vector<std::string>& names
+) {
+  nlohmann::json object = nlohmann::json::object();
+  for(unsigned i = 0; i < timers.size(); ++i) {
+    if(timers[i].calls > 0) {
+      object[names.at(i)] = timers[i].toJSON();
+    }
+  }
+  return object;
+}
+
+nlohmann::json countersJSON(
+  const std::vector<std::uint64_t>& counters,
+  const std::vector<std::string>& names
+) {
+  nlohmann::json object = nlohmann::json::object();
+  for(unsigned i = 0; i < counters.size(); ++i) {
+    if(counters[i] > 0) {
+      object[names.at(i)] = counters[i];
+    }
+  }
+  return object;
+}
+
+} // namespace
+
+bool enabled() {
+#ifdef MOLASSEMBLER_ENABLE_PROFILING
+  return true;
+#else
+  return false;
+#endif
+}
+
+std::atomic<bool> recordTraceEvents {false};
+
+void reset() {
+  Registry& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  for(auto& dataPtr : reg.threads) {
+    dataPtr->timers.clear();
+    dataPtr->counters.clear();
+    dataPtr->events.clear();
+    dataPtr->droppedEvents = 0;
+  }
+}
+
+std::string json() {
+  Registry& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+
+  std::vector<TimerAggregate> mergedTimers(reg.names.size());
+  std::vector<std::uint64_t> mergedCounters(reg.names.size(), 0);
+
+  nlohmann::json threads = nlohmann::json::array();
+  for(const auto& dataPtr : reg.threads) {
+    for(unsigned i = 0; i < dataPtr->timers.size(); ++i) {
+      mergedTimers[i].merge(dataPtr->timers[i]);
+    }
+    for(unsigned i = 0; i < dataPtr->counters.size(); ++i) {
+      mergedCounters[i] += dataPtr->counters[i];
+    }
+
+    threads.push_back({
+      {"thread", dataPtr->threadIndex},
+      {"timers", timersJSON(dataPtr->timers, reg.names)},
+      {"counters", countersJSON(dataPtr->counters, reg.names)},
+      {"dropped_trace_events", dataPtr->droppedEvents}
+    });
+  }
+
+  const nlohmann::json result {
+    {"timers", timersJSON(mergedTimers, reg.names)},
+    {"counters", countersJSON(mergedCounters, reg.names)},
+    {"threads", std::move(threads)}
+  };
+
+  return result.dump();
+}
+
+std::string chromeTrace() {
+  Registry& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+
+  nlohmann::json events = nlohmann::json::array();
+  for(const auto& dataPtr : reg.threads) {
+    for(const TraceEvent& event : dataPtr->events) {
+      // Chrome trace timestamps and durations are in microseconds
+      events.push_back({
+        {"name", reg.names.at(event.nameIndex)},
+        {"cat", "molassembler"},
+        {"ph", "X"},
+        {"ts", event.startNanoseconds / 1e3},
+        {"dur", event.durationNanoseconds / 1e3},
+        {"pid", 0},
+        {"tid", dataPtr->threadIndex}
+      });
+    }
+  }
+
+  const nlohmann::json result {
+    {"traceEvents", std::move(events)},
+    {"displayTimeUnit", "ns"}
+  };
+
+  return result.dump();
+}
+
+namespace Detail {
+
+unsigned registerName(const char* name) {
+  Registry& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  const auto findIter = std::find(
+    std::begin(reg.names),
+    std::end(reg.names),
+    name
+  );
+  if(findIter != std::end(reg.names)) {
+    return findIter - std::begin(reg.names);
+  }
+
+  reg.names.emplace_back(name);
+  return reg.names.size() - 1;
+}
+
+void count(const unsigned nameIndex, const std::uint64_t amount) {
+  ThreadData& data = threadData();
+  if(nameIndex >= data.counters.size()) {
+    data.counters.resize(nameIndex + 1, 0);
+  }
+  data.counters[nameIndex] += amount;
+}
+
+ScopedTimer::ScopedTimer(const unsigned nameIndex)
+  : nameIndex_(nameIndex),
+    start_(Clock::now()) {}
+
+ScopedTimer::~ScopedTimer() {
+  const auto end = Clock::now();
+  const std::uint64_t duration = nanoseconds(end - start_);
+
+  ThreadData& data = threadData();
+  if(nameIndex_ >= data.timers.size()) {
+    data.timers.resize(nameIndex_ + 1);
+  }
+  data.timers[nameIndex_].add(duration);
+
+  if(recordTraceEvents.load(std::memory_order_relaxed)) {
+    if(data.events.size() < maxTraceEventsPerThread) {
+      data.events.push_back(
+        TraceEvent {
+          nameIndex_,
+          nanoseconds(start_ - registry().epoch),
+          duration
+        }
+      );
+    } else {
+      ++data.droppedEvents;
+    }
+  }
+}
+
+} // namespace Detail
+
+} // namespace Profiling
+} // namespace Molassembler
+} // namespace Scine
@@ -0,0 +1,130 @@
+/*!@file
+ * @copyright This code is licensed under the 3-clause BSD license.
+ *   Copyright ETH Zurich, Laboratory of Physical Chemistry, Reiher Group.
+ *   See LICENSE.txt for details.
+ * @brief Low-overhead instrumentation of library hot paths
+ *
+ * Instrumentation is compiled in only if the library is built with the
+ * MOLASSEMBLER_PROFILING CMake option, which sets the
+ * MOLASSEMBLER_ENABLE_PROFILING preprocessor definition for library sources.
+ * Otherwise, the instrumentation macros expand to nothing and all recorded
+ * data is empty.
+ *
+ * Timers and counters are aggregated per thread without synchronization. Data
+ * can be exported as JSON or in the Chrome trace event format (viewable in
+ * chrome://tracing or Perfetto).
+ */
+
+#ifndef INCLUDE_MOLASSEMBLER_PROFILING_H
+#define INCLUDE_MOLASSEMBLER_PROFILING_H
+
+#include "Molassembler/Export.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace Scine {
+namespace Molassembler {
+namespace Profiling {
+
+//! Whether instrumentation was compiled into the library
+MASM_EXPORT bool enabled();
+
+/*! @brief Whether individual timed scopes are recorded as trace events
+ *
+ * Aggregated timings and counters are always collected if instrumentation is
+ * compiled in. Individual trace events, needed for the Chrome trace export,
+ * are recorded only if this is set. Defaults to false. May be toggled while
+ * instrumented functions run in other threads.
+ */
+MASM_EXPORT extern std::atomic<bool> recordTraceEvents;
+
+/*! @brief Discards all recorded timings, counters and trace events
+ *
+ * @warning Not thread-safe. Do not call while instrumented library functions
+ * are running.
+ */
+MASM_EXPORT void reset();
+
+/*! @brief Aggregated timings and counters as a JSON string
+ *
+ * Contains per-thread data under the key "threads" as well as merged data
+ * over all threads under the keys "timers" and "counters". Timer aggregates
+ * list the number of calls and the total, minimal and maximal durations in
+ * nanoseconds.
+ *
+ * @warning Not thread-safe. Do not call while instrumented library functions
+ * are running.
+ */
+MASM_EXPORT std::string json();
+
+/*! @brief Recorded trace events in Chrome trace event JSON format
+ *
+ * Empty unless recordTraceEvents was set while instrumented functions ran.
+ *
+ * @warning Not thread-safe. Do not call while instrumented library functions
+ * are running.
+ */
+MASM_EXPORT std::string chromeTrace();
+
+namespace Detail {
+
+//! Register a timer or counter name, yielding its index. Thread-safe.
+unsigned registerName(const char* name);
+
+//! Add to a counter of the current thread
+void count(unsigned nameIndex, std::uint64_t amount);
+
+//! RAII timer adding its lifetime to the current thread's aggregate
+class ScopedTimer {
+public:
+  explicit ScopedTimer(unsigned nameIndex);
+  ScopedTimer(const ScopedTimer& other) = delete;
+  ScopedTimer& operator = (const ScopedTimer& other) = delete;
+  ~ScopedTimer();
+
+private:
+  unsigned nameIndex_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace Detail
+
+} // namespace Profiling
+} // namespace Molassembler
+} // namespace Scine
+
+#define MOLASSEMBLER_PROFILING_CONCAT_IMPL(a, b) a ## b
+#define MOLASSEMBLER_PROFILING_CONCAT(a, b) MOLASSEMBLER_PROFILING_CONCAT_IMPL(a, b)
+
+#ifdef MOLASSEMBLER_ENABLE_PROFILING
+/*! @brief Times the remainder of the enclosing scope under a name
+ *
+ * @param name A string literal
+ */
+#define MOLASSEMBLER_PROFILE_SCOPE(name) \
+  static const unsigned MOLASSEMBLER_PROFILING_CONCAT(masmProfileName, __LINE__) \
+    = ::Scine::Molassembler::Profiling::Detail::registerName(name); \
+  const ::Scine::Molassembler::Profiling::Detail::ScopedTimer \
+    MOLASSEMBLER_PROFILING_CONCAT(masmProfileTimer, __LINE__) { \
+      MOLASSEMBLER_PROFILING_CONCAT(masmProfileName, __LINE__) \
+    }
+
+/*! @brief Adds an amount to a named counter
+ *
+ * @param name A string literal
+ * @param amount Unsigned amount to add to the counter
+ */
+#define MOLASSEMBLER_PROFILE_COUNT(name, amount) \
+  do { \
+    static const unsigned masmProfileCounterName \
+      = ::Scine::Molassembler::Profiling::Detail::registerName(name); \
+    ::Scine::Molassembler::Profiling::Detail::count(masmProfileCounterName, amount); \
+  } while(false)
+#else
+#define MOLASSEMBLER_PROFILE_SCOPE(name)
+#define MOLASSEMBLER_PROFILE_COUNT(name, amount) do {} while(false)
+#endif
+
+#endif
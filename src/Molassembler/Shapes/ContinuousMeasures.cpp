@@ -9,6 +9,7 @@
 #include "Molassembler/Shapes/Diophantine.h"
 #include "Molassembler/Shapes/Partitioner.h"
 #include "Molassembler/Shapes/Data.h"
+#include "Molassembler/Profiling.h"
 
 #include "Molassembler/Temple/Adaptors/Iota.h"
 #include "Molassembler/Temple/Adaptors/Transform.h"
@@ -984,6 +985,8 @@ double pointGroup(
   const PositionCollection& normalizedPositions,
   const PointGroup group
 ) {
+  MOLASSEMBLER_PROFILE_SCOPE("ContinuousMeasures.pointGroup");
+
   assert(isNormalized(normalizedPositions));
 
   // Special-case Cinfv
@@ -1594,6 +1597,8 @@ ShapeResult shape(
   const PositionCollection& normalizedPositions,
   const Shape shape
 ) {
+  MOLASSEMBLER_PROFILE_SCOPE("ContinuousMeasures.shape");
+
 #ifdef NDEBUG
   // In release builds, use heuristics starting from size 9
   constexpr unsigned minSizeForHeuristics = 8;
@@ -1612,6 +1617,8 @@ ShapeResult shapeCentroidLast(
   const PositionCollection& normalizedPositions,
   const Shape shape
 ) {
+  MOLASSEMBLER_PROFILE_SCOPE("ContinuousMeasures.shapeCentroidLast");
+
 #ifdef NDEBUG
   // In release builds, use heuristics starting from size 8
   constexpr unsigned minSizeForHeuristics = 8;
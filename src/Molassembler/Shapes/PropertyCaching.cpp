@@ -60,7 +60,9 @@ Temple::MinimalCache<
   Properties::ShapeTransitionGroup
 > mappingsCache;
 
-boost::optional<const Properties::ShapeTransitionGroup&> getMapping(
+namespace {
+
+boost::optional<const Properties::ShapeTransitionGroup&> getMappingUnsynchronized(
   const Shape a,
   const Shape b,
   const boost::optional<Vertex>& removedIndexOption
@@ -151,6 +153,24 @@ boost::optional<const Properties::ShapeTransitionGroup&> getMapping(
   return mappingsCache.getOption(key);
 }
 
+} // namespace
+
+boost::optional<const Properties::ShapeTransitionGroup&> getMapping(
+  const Shape a,
+  const Shape b,
+  const boost::optional<Vertex>& removedIndexOption
+) {
+  /* Cache entries are never removed and map nodes are stable, so references
+   * to entries remain valid outside of the critical section
+   */
+  boost::optional<const Properties::ShapeTransitionGroup&> mappingOption;
+#pragma omp critical(shapeMappingsCache)
+  {
+    mappingOption = getMappingUnsynchronized(a, b, removedIndexOption);
+  }
+  return mappingOption;
+}
+
 #ifdef USE_CONSTEXPR_HAS_MULTIPLE_UNLINKED_STEREOPERMUTATIONS
 template<typename Symmetry>
 struct makeAllHasUnlinkedStereopermutationsFunctor {
@@ -185,7 +205,9 @@ Temple::MinimalCache<
   std::vector<bool>
 > hasMultipleUnlinkedCache;
 
-bool hasMultipleUnlinkedStereopermutations(
+namespace {
+
+bool hasMultipleUnlinkedStereopermutationsUnsynchronized(
   const Shape shape,
   unsigned nIdenticalLigands
 ) {
@@ -237,6 +259,20 @@ bool hasMultipleUnlinkedStereopermutations(
 #endif
 }
 
+} // namespace
+
+bool hasMultipleUnlinkedStereopermutations(
+  const Shape shape,
+  const unsigned nIdenticalLigands
+) {
+  bool result = false;
+#pragma omp critical(shapeHasMultipleUnlinkedCache)
+  {
+    result = hasMultipleUnlinkedStereopermutationsUnsynchronized(shape, nIdenticalLigands);
+  }
+  return result;
+}
+
 } // namespace Shapes
 } // namespace Molassembler
 } // namespace Scine
@@ -85,6 +85,8 @@ extern Temple::MinimalCache<
  *   target is one less than that of the source. Defaults to None.
  *
  * @returns The symmetry transition if possible, None otherwise
+ *
+ * @note Thread-safe. Access to the cache is serialized.
  */
 boost::optional<const Properties::ShapeTransitionGroup&> getMapping(
   Shape a,
@@ -126,6 +128,8 @@ extern Temple::MinimalCache<
  *
  * @returns Whether there are multiple stereopermutations assuming no ligands
  *   are linked
+ *
+ * @note Thread-safe. Access to the cache is serialized.
  */
 MASM_EXPORT bool hasMultipleUnlinkedStereopermutations(
   Shape shape,
@@ -273,8 +273,16 @@ AtomStereopermutator::Impl::Impl(
 ) : centerAtom_ {centerAtom},
     shape_ {shape},
     ranking_ {std::move(ranking)},
-    abstract_ {ranking_, shape_},
-    feasible_ {abstract_, shape_, centerAtom_, ranking_, graph},
+    abstract_ {std::make_shared<Stereopermutators::Abstract>(ranking_, shape_)},
+    feasible_ {
+      std::make_shared<Stereopermutators::Feasible>(
+        *abstract_,
+        shape_,
+        centerAtom_,
+        ranking_,
+        graph
+      )
+    },
     assignmentOption_ {boost::none},
     shapePositionMap_ {},
     thermalized_ {thermalized(
@@ -287,7 +295,7 @@ AtomStereopermutator::Impl::Impl(
 
 /* Modification */
 void AtomStereopermutator::Impl::assign(boost::optional<unsigned> assignment) {
-  if(assignment && assignment.value() >= feasible_.indices.size()) {
+  if(assignment && assignment.value() >= feasible_->indices.size()) {
     throw std::out_of_range("Supplied assignment index is out of range");
   }
 
@@ -299,12 +307,12 @@ void AtomStereopermutator::Impl::assign(boost::optional<unsigned> assignment) {
    */
   if(assignmentOption_) {
     shapePositionMap_ = siteToShapeVertexMap(
-      abstract_.permutations.list.at(
-        feasible_.indices.at(
+      abstract_->permutations.list.at(
+        feasible_->indices.at(
           assignmentOption_.value()
         )
       ),
-      abstract_.canonicalSites,
+      abstract_->canonicalSites,
       ranking_.links
     );
   } else { // Wipe the map
@@ -336,7 +344,7 @@ void AtomStereopermutator::Impl::assign(std::vector<Shapes::Vertex> vertexMappin
   auto soughtStereopermutation = stereopermutationFromSiteToShapeVertexMap(
     SiteToShapeVertexMap {vertexMapping},
     ranking_.links,
-    abstract_.canonicalSites
+    abstract_->canonicalSites
   );
 
   auto soughtRotations = Stereopermutations::generateAllRotations(soughtStereopermutation, shape_);
@@ -347,10 +355,10 @@ void AtomStereopermutator::Impl::assign(std::vector<Shapes::Vertex> vertexMappin
    * as long as we use continuous shape measure-based shape classification.
    */
   boost::optional<unsigned> foundStereopermutation;
-  const unsigned A = feasible_.indices.size();
+  const unsigned A = feasible_->indices.size();
   for(unsigned a = 0; a < A; ++a) {
-    const auto& feasiblePermutation = abstract_.permutations.list.at(
-      feasible_.indices.at(a)
+    const auto& feasiblePermutation = abstract_->permutations.list.at(
+      feasible_->indices.at(a)
     );
     auto findIter = std::find(
       std::begin(soughtRotations),
@@ -382,9 +390,9 @@ void AtomStereopermutator::Impl::assignRandom(Random::Engine& engine) {
       Temple::Random::pickDiscrete(
         // Map the feasible permutations onto their weights
         Temple::map(
-          feasible_.indices,
+          feasible_->indices,
           [&](const unsigned permutationIndex) -> unsigned {
-            return abstract_.permutations.weights.at(permutationIndex);
+            return abstract_->permutations.weights.at(permutationIndex);
           }
         ),
         engine
@@ -654,19 +662,21 @@ boost::optional<AtomStereopermutator::PropagatedState> AtomStereopermutator::Imp
     }
   );
 
-  // Extract old state from the class
+  /* Extract old state from the class. The stereopermutations may be shared
+   * with copies and are therefore copied out.
+   */
   auto oldStateTuple = std::make_tuple(
     std::move(ranking_),
-    std::move(abstract_),
-    std::move(feasible_),
+    Stereopermutators::Abstract {*abstract_},
+    Stereopermutators::Feasible {*feasible_},
     std::move(shapePositionMap_)
   );
 
   // Overwrite the class state
   shape_ = newShape;
   ranking_ = std::move(newRanking);
-  abstract_ = std::move(newAbstract);
-  feasible_ = std::move(newFeasible);
+  abstract_ = std::make_shared<Stereopermutators::Abstract>(std::move(newAbstract));
+  feasible_ = std::make_shared<Stereopermutators::Feasible>(std::move(newFeasible));
   thermalized_ = thermalized(
     graph,
     centerAtom_,
@@ -729,11 +739,11 @@ void AtomStereopermutator::Impl::propagateVertexRemoval(const AtomIndex removedI
 }
 
 const Stereopermutators::Abstract& AtomStereopermutator::Impl::getAbstract() const {
-  return abstract_;
+  return *abstract_;
 }
 
 const Stereopermutators::Feasible& AtomStereopermutator::Impl::getFeasible() const {
-  return feasible_;
+  return *feasible_;
 }
 
 const RankingInformation& AtomStereopermutator::Impl::getRanking() const {
@@ -832,7 +842,7 @@ boost::optional<unsigned> AtomStereopermutator::Impl::indexOfPermutation() const
 
   return Temple::Optionals::map(
     assignmentOption_,
-    Temple::Functor::at(feasible_.indices)
+    Temple::Functor::at(feasible_->indices)
   );
 }
 
@@ -887,14 +897,14 @@ AtomStereopermutator::Impl::minimalChiralConstraints(const bool enforce) const {
 std::string AtomStereopermutator::Impl::info() const {
   std::string returnString = std::to_string(centerAtom_) + ": "s + Shapes::name(shape_) +", "s;
 
-  const auto& characters = abstract_.symbolicCharacters;
+  const auto& characters = abstract_->symbolicCharacters;
   std::copy(
     characters.begin(),
     characters.end(),
     std::back_inserter(returnString)
   );
 
-  for(const auto& link : abstract_.selfReferentialLinks) {
+  for(const auto& link : abstract_->selfReferentialLinks) {
     returnString += ", "s + characters.at(link.first) + "-"s + characters.at(link.second);
   }
 
@@ -957,7 +967,7 @@ unsigned AtomStereopermutator::Impl::numAssignments() const {
     return 1;
   }
 
-  return feasible_.indices.size();
+  return feasible_->indices.size();
 }
 
 unsigned AtomStereopermutator::Impl::numStereopermutations() const {
@@ -965,7 +975,7 @@ unsigned AtomStereopermutator::Impl::numStereopermutations() const {
     return 1;
   }
 
-  return abstract_.permutations.list.size();
+  return abstract_->permutations.list.size();
 }
 
 void AtomStereopermutator::Impl::setShape(
@@ -979,18 +989,18 @@ void AtomStereopermutator::Impl::setShape(
 
   shape_ = shape;
 
-  abstract_ = Stereopermutators::Abstract {
+  abstract_ = std::make_shared<Stereopermutators::Abstract>(
     ranking_,
     shape_
-  };
+  );
 
-  feasible_ = Stereopermutators::Feasible {
-    abstract_,
+  feasible_ = std::make_shared<Stereopermutators::Feasible>(
+    *abstract_,
     shape_,
     centerAtom_,
     ranking_,
     graph
-  };
+  );
 
   thermalized_ = thermalized(
     graph,
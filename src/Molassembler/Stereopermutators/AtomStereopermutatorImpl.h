@@ -16,6 +16,8 @@
 
 #include "boost/optional.hpp"
 
+#include <memory>
+
 namespace Scine {
 namespace Molassembler {
 
@@ -248,11 +250,15 @@ private:
   //! Ranking information of substituents
   RankingInformation ranking_;
 
+  /* Abstract and feasible stereopermutations depend only on the shape and the
+   * ranking's structure, not on atom indices. They are shared between copies
+   * and replaced instead of modified.
+   */
   //! Abstract stereopermutations and intermediate state
-  Stereopermutators::Abstract abstract_;
+  std::shared_ptr<const Stereopermutators::Abstract> abstract_;
 
   //! Models abstract stereopermutations and decides three-dimensional feasibility
-  Stereopermutators::Feasible feasible_;
+  std::shared_ptr<const Stereopermutators::Feasible> feasible_;
 
   //! The current state of assignment (if or not, and if so, which)
   boost::optional<unsigned> assignmentOption_;
@@ -163,7 +163,7 @@ std::vector<char> BondStereopermutator::Impl::charifyRankedSites_(
 }
 
 const Stereopermutations::Composite& BondStereopermutator::Impl::composite() const {
-  return composite_;
+  return *composite_;
 }
 
 double BondStereopermutator::Impl::dihedral(
@@ -184,7 +184,7 @@ double BondStereopermutator::Impl::dihedral(
 
   ReferencePair references {stereopermutatorA, stereopermutatorB};
   std::pair<unsigned, unsigned> siteIndices {siteIndexA, siteIndexB};
-  if(stereopermutatorA.placement() == composite_.orientations().second.identifier) {
+  if(stereopermutatorA.placement() == composite_->orientations().second.identifier) {
     std::swap(references.first, references.second);
     std::swap(siteIndices.first, siteIndices.second);
     swapped = true;
@@ -201,7 +201,7 @@ double BondStereopermutator::Impl::dihedral(
   std::pair<Shapes::Vertex, Shapes::Vertex> vertices;
   double dihedralAngle;
 
-  for(const auto& dihedralTuple : composite_.allPermutations().at(*assignment_).dihedrals) {
+  for(const auto& dihedralTuple : composite_->allPermutations().at(*assignment_).dihedrals) {
     std::tie(vertices.first, vertices.second, dihedralAngle) = dihedralTuple;
 
     if(
@@ -777,12 +777,14 @@ BondStereopermutator::Impl::Impl(
   const BondIndex edge,
   Alignment alignment
 ) : composite_ {
-      makeOrientationState_(stereopermutatorA, stereopermutatorA.getShapePositionMap(), stereopermutatorB),
-      makeOrientationState_(stereopermutatorB, stereopermutatorB.getShapePositionMap(), stereopermutatorA),
-      static_cast<Stereopermutations::Composite::Alignment>(alignment)
+      std::make_shared<Stereopermutations::Composite>(
+        makeOrientationState_(stereopermutatorA, stereopermutatorA.getShapePositionMap(), stereopermutatorB),
+        makeOrientationState_(stereopermutatorB, stereopermutatorB.getShapePositionMap(), stereopermutatorA),
+        static_cast<Stereopermutations::Composite::Alignment>(alignment)
+      )
     },
     edge_(edge),
-    feasiblePermutations_(composite_.nonEquivalentPermutationIndices()),
+    feasiblePermutations_(composite_->nonEquivalentPermutationIndices()),
     assignment_(boost::none)
 {}
 
@@ -791,10 +793,14 @@ BondStereopermutator::Impl::Impl(
   const StereopermutatorList& stereopermutators,
   const BondIndex edge,
   Alignment alignment
-) : composite_(constructComposite_(stereopermutators, edge, alignment)),
+) : composite_(
+      std::make_shared<Stereopermutations::Composite>(
+        constructComposite_(stereopermutators, edge, alignment)
+      )
+    ),
     edge_(edge),
     feasiblePermutations_(
-      notObviouslyInfeasibleStereopermutations(graph, stereopermutators, composite_)
+      notObviouslyInfeasibleStereopermutations(graph, stereopermutators, *composite_)
     ),
     assignment_(boost::none)
 {}
@@ -803,12 +809,12 @@ BondStereopermutator::Impl::Impl(
 /* Modification */
 void BondStereopermutator::Impl::assign(boost::optional<unsigned> assignment) {
   if(assignment && assignment.value() >= numAssignments()) {
-    /* The distinction here between numAssignments and composite_.permutations()
+    /* The distinction here between numAssignments and composite_->permutations()
      * is important because if the composite is isotropic, we simulate that
      * there is only a singular assignment (see numAssignments), although
      * all permutations are generated and present for fitting anyway.
      *
-     * If this were composite_.permutations(), we would accept assignments other
+     * If this were composite_->permutations(), we would accept assignments other
      * than zero if the underlying composite is isotropic, but not yield the
      * same assignment index when asked which assignment is currently set
      * in assigned().
@@ -836,9 +842,12 @@ void BondStereopermutator::Impl::assignRandom(Random::Engine& engine) {
 
 void BondStereopermutator::Impl::applyPermutation(const std::vector<AtomIndex>& permutation) {
   /* Composite's OrientationState identifiers change (these have no impact on
-   * assignment ordering however, so that should be safe)
+   * assignment ordering however, so that should be safe). The composite may
+   * be shared with copies, so a permuted duplicate replaces it.
    */
-  composite_.applyIdentifierPermutation(permutation);
+  auto permutedComposite = std::make_shared<Stereopermutations::Composite>(*composite_);
+  permutedComposite->applyIdentifierPermutation(permutation);
+  composite_ = std::move(permutedComposite);
 
   // Edge we sit on changes according to the permutation
   edge_ = BondIndex {
@@ -855,12 +864,12 @@ void BondStereopermutator::Impl::fit(
   const FittingMode mode
 ) {
   // Early exit
-  if(composite_.countNonEquivalentPermutations() == 0) {
+  if(composite_->countNonEquivalentPermutations() == 0) {
     assignment_ = boost::none;
     return;
   }
 
-  const auto alignedReferences = align(fittingReferences, composite_);
+  const auto alignedReferences = align(fittingReferences, *composite_);
   Stereopermutations::Composite matchedComposite {
     makeOrientationState_(
       alignedReferences.first.stereopermutator,
@@ -872,7 +881,7 @@ void BondStereopermutator::Impl::fit(
       alignedReferences.second.shapeMap,
       alignedReferences.first.stereopermutator
     ),
-    composite_.alignment()
+    composite_->alignment()
   };
 
   auto makeSitePositions = [&angstromWrapper](const AtomStereopermutator& permutator) -> auto {
@@ -905,8 +914,8 @@ void BondStereopermutator::Impl::fit(
   for(const unsigned i : feasiblePermutations_) {
     permutationMapToFeasibleBase.emplace(i, i);
   }
-  for(unsigned i = 0; i < composite_.allPermutations().size(); ++i) {
-    unsigned base = composite_.rankingEquivalentBase(i);
+  for(unsigned i = 0; i < composite_->allPermutations().size(); ++i) {
+    unsigned base = composite_->rankingEquivalentBase(i);
 
     if(permutationMapToFeasibleBase.count(base) > 0) {
       permutationMapToFeasibleBase.emplace(i, base);
@@ -962,8 +971,8 @@ void BondStereopermutator::Impl::fit(
      * substituents at one side, the deviation per dihedral should be smaller
      * than if there were only two).
      */
-    const double misalignmentPerDihedral = misalignment / composite_.allPermutations().at(feasiblePermutationIndex).dihedrals.size();
-    const double acceptableMisalignment = assignmentAcceptanceParameter * 2 * M_PI / composite_.order();
+    const double misalignmentPerDihedral = misalignment / composite_->allPermutations().at(feasiblePermutationIndex).dihedrals.size();
+    const double acceptableMisalignment = assignmentAcceptanceParameter * 2 * M_PI / composite_->order();
     if(
       mode == FittingMode::Thresholded
       && misalignmentPerDihedral > acceptableMisalignment
@@ -1019,17 +1028,17 @@ void BondStereopermutator::Impl::propagateGraphChange(
 
   /* Construct a new Composite with the new information */
   bool changedIsFirstInOldOrientations = (
-    composite_.orientations().first.identifier == newPermutator.placement()
+    composite_->orientations().first.identifier == newPermutator.placement()
   );
 
   const OrientationState& oldOrientation = select(
-    composite_.orientations(),
+    composite_->orientations(),
     changedIsFirstInOldOrientations
   );
 
   // Reuse the OrientationState of the "other" atom stereopermutator
   const OrientationState& unchangedOrientation = select(
-    composite_.orientations(),
+    composite_->orientations(),
     !changedIsFirstInOldOrientations
   );
 
@@ -1072,7 +1081,7 @@ void BondStereopermutator::Impl::propagateGraphChange(
    * an assignment, we can choose any.
    */
   if(newComposite.isIsotropic()) {
-    composite_ = std::move(newComposite);
+    composite_ = std::make_shared<Stereopermutations::Composite>(std::move(newComposite));
     feasiblePermutations_ = std::move(newFeasiblePermutations);
     if(!feasiblePermutations_.empty()) {
       assignment_ = 0;
@@ -1084,7 +1093,7 @@ void BondStereopermutator::Impl::propagateGraphChange(
    * isotropic after the ranking change, then this permutator stays unassigned.
    */
   if(assignment_ == boost::none) {
-    composite_ = std::move(newComposite);
+    composite_ = std::make_shared<Stereopermutations::Composite>(std::move(newComposite));
     feasiblePermutations_ = std::move(newFeasiblePermutations);
     return;
   }
@@ -1115,7 +1124,7 @@ void BondStereopermutator::Impl::propagateGraphChange(
 
   using DihedralTuple = Stereopermutations::Composite::Permutation::DihedralTuple;
   // We know the permutator is assigned from a few lines earlier
-  const std::vector<DihedralTuple>& oldDihedralList = composite_.allPermutations().at(
+  const std::vector<DihedralTuple>& oldDihedralList = composite_->allPermutations().at(
     feasiblePermutations_.at(*assignment_)
   ).dihedrals;
 
@@ -1220,14 +1229,14 @@ void BondStereopermutator::Impl::propagateGraphChange(
 
   // Overwrite class state
   assignment_ = feasibleIter - std::begin(newFeasiblePermutations);
-  composite_ = std::move(newComposite);
+  composite_ = std::make_shared<Stereopermutations::Composite>(std::move(newComposite));
   feasiblePermutations_ = std::move(newFeasiblePermutations);
 }
 
 /* Information */
 BondStereopermutator::Alignment BondStereopermutator::Impl::alignment() const {
   return static_cast<BondStereopermutator::Alignment>(
-    composite_.alignment()
+    composite_->alignment()
   );
 }
 
@@ -1236,7 +1245,7 @@ boost::optional<unsigned> BondStereopermutator::Impl::assigned() const {
 }
 
 bool BondStereopermutator::Impl::hasSameCompositeOrientation(const BondStereopermutator::Impl& other) const {
-  return composite_ == other.composite_;
+  return *composite_ == *other.composite_;
 }
 
 boost::optional<unsigned> BondStereopermutator::Impl::indexOfPermutation() const {
@@ -1251,7 +1260,7 @@ unsigned BondStereopermutator::Impl::numAssignments() const {
 }
 
 unsigned BondStereopermutator::Impl::numStereopermutations() const {
-  return composite_.countNonEquivalentPermutations();
+  return composite_->countNonEquivalentPermutations();
 }
 
 std::string BondStereopermutator::Impl::info() const {
@@ -1259,9 +1268,9 @@ std::string BondStereopermutator::Impl::info() const {
 
   std::string returnString;
 
-  returnString += std::to_string(composite_.orientations().first.identifier);
+  returnString += std::to_string(composite_->orientations().first.identifier);
   returnString += "-";
-  returnString += std::to_string(composite_.orientations().second.identifier);
+  returnString += std::to_string(composite_->orientations().second.identifier);
 
   const unsigned A = numAssignments();
 
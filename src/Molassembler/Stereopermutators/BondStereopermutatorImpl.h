@@ -15,6 +15,8 @@
 #include "Molassembler/Stereopermutation/Composites.h"
 #include "Molassembler/DistanceGeometry/DistanceGeometry.h"
 
+#include <memory>
+
 namespace Scine {
 namespace Molassembler {
 
@@ -143,15 +145,16 @@ struct BondStereopermutator::Impl : public Temple::Crtp::LexicographicComparable
 
 /* Operators */
   inline auto tie() const {
-    return std::make_tuple(std::ref(composite_), assigned());
+    return std::make_tuple(std::cref(*composite_), assigned());
   }
 
 private:
   /*!
    * Object representing union of both atom stereopermutators, yields abstract
-   * spatial arrangements
+   * spatial arrangements. Shared between copies and replaced instead of
+   * modified.
    */
-  Stereopermutations::Composite composite_;
+  std::shared_ptr<const Stereopermutations::Composite> composite_;
   //! Edge this stereopermutator is placed on
   BondIndex edge_;
   //! List of indices into allPermutations of composite_ that are not obviously infeasible
@@ -12,12 +12,20 @@
 #include "Molassembler/Shapes/PropertyCaching.h"
 #include "Molassembler/Shapes/Shapes.h"
 #include "Molassembler/Graph/Bridge.h"
+#include "Molassembler/Graph/CsrGraph.h"
+#include "Molassembler/Molecule/AtomEnvironmentHash.h"
 #include "Molassembler/Molecule.h"
 #include "Molassembler/AtomStereopermutator.h"
 #include "Molassembler/BondStereopermutator.h"
 #include "Molassembler/StereopermutatorList.h"
+#include "Molassembler/Profiling.h"
 #include "Molassembler/Temple/Functional.h"
 
+#include <atomic>
+#include <exception>
+#include <map>
+#include <set>
+
 /* TODO
  * - Missing algorithm for stereopermutator extension
  * - Ensure comparisons are symmetric! I.e. not needle-haystack but
@@ -74,6 +82,7 @@ struct SubgraphCallback {
   const Graph& targetGraph;
   std::reference_wrapper<IndexMapVector> mappingsRef;
   bool removeHydrogenPermutations = true;
+  bool stopAfterFirst = false;
 
   SubgraphCallback(const Graph& a, const Graph& b, IndexMapVector& mappings)
     : N {a.N()}, targetGraph(b), mappingsRef(mappings) {}
@@ -113,8 +122,8 @@ struct SubgraphCallback {
 
     mappingsRef.get().push_back(std::move(indexMap));
 
-    //! Don't force stop after any mappings are found
-    return true;
+    //! Don't force stop after any mappings are found unless requested
+    return !stopAfterFirst;
   }
 
   template<class AbMap, class BaMap>
@@ -227,10 +236,12 @@ std::vector<IndexMap> completeImpl(
   const PartialMolecule& needle,
   const PartialMolecule& haystack,
   VertexStrictness vertexStrictness = VertexStrictness::ElementType,
-  EdgeStrictness edgeStrictness = EdgeStrictness::Topographic
+  EdgeStrictness edgeStrictness = EdgeStrictness::Topographic,
+  const bool stopAfterFirst = false
 ) {
   std::vector<IndexMap> mappings;
   SubgraphCallback callback {needle.graph, haystack.graph, mappings};
+  callback.stopAfterFirst = stopAfterFirst;
 
   boost::vf2_subgraph_mono(
     needle.graph.inner().bgl(),
@@ -247,6 +258,400 @@ std::vector<IndexMap> completeImpl(
   return mappings;
 }
 
+void checkGraphStrictness(
+  const VertexStrictness vertexStrictness,
+  const EdgeStrictness edgeStrictness
+) {
+  if(underlying(vertexStrictness) >= underlying(VertexStrictness::SubsumeShape)) {
+    throw std::runtime_error("Requested vertex comparison strictness not possible without stereopermutator information");
+  }
+
+  if(underlying(edgeStrictness) >= underlying(EdgeStrictness::SubsumeStereopermutation)) {
+    throw std::runtime_error("Requested edge comparison strictness not possible without stereopermutator information");
+  }
+}
+
+//! Whether each vertex is part of a cycle, i.e. has an incident non-bridge edge
+std::vector<bool> ringMembership(const PrivateGraph& graph) {
+  const auto& bridges = graph.removalSafetyData().bridges;
+  std::vector<bool> rings(graph.N(), false);
+  for(const PrivateGraph::Edge& edge : graph.edges()) {
+    if(bridges.count(edge) == 0) {
+      rings[graph.source(edge)] = true;
+      rings[graph.target(edge)] = true;
+    }
+  }
+  return rings;
+}
+
+IndexMap toIndexMap(const Matcher::Mapping& mapping) {
+  IndexMap bimap;
+  for(AtomIndex i = 0; i < mapping.size(); ++i) {
+    bimap.insert(IndexMap::value_type(i, mapping[i]));
+  }
+  return bimap;
+}
+
+//! Finalizer of the splitmix64 generator, scrambles all bits of a feature
+inline std::uint64_t mix(std::uint64_t x) {
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  return x ^ (x >> 31);
+}
+
+inline std::uint64_t extend(const std::uint64_t feature, const std::uint64_t value) {
+  return mix(feature ^ (value + 0x9e3779b97f4a7c15ull + (feature << 6) + (feature >> 2)));
+}
+
+/* Collects features of a graph that are preserved by subgraph monomorphisms
+ * into a fingerprint. Untyped features serve topographic edge matching,
+ * typed features include bond types.
+ */
+struct FingerprintBuilder {
+  //! Longest labeled path in bonds
+  static constexpr unsigned maxPathBonds = 3;
+  //! Distinguishes feature kinds
+  enum Kind : std::uint64_t {Count = 1, UntypedPath = 2, TypedPath = 3};
+
+  FingerprintBuilder(const CsrGraph& passCsr, const bool passUntyped, const bool passTyped)
+    : csr(passCsr), untyped(passUntyped), typed(passTyped)
+  {
+    fingerprint.fill(0);
+
+    // Vertex labels are element-only atom environment hashes
+    const unsigned N = csr.N();
+    labels.reserve(N);
+    for(AtomIndex i = 0; i < N; ++i) {
+      labels.push_back(
+        Hashes::atomEnvironment(csr, boost::none, AtomEnvironmentComponents::ElementTypes, i).low
+      );
+    }
+  }
+
+  void set(const std::uint64_t feature) {
+    const std::uint64_t bit = mix(feature) % (64 * Library::fingerprintWords);
+    fingerprint[bit / 64] |= (std::uint64_t {1} << (bit % 64));
+  }
+
+  /* A needle with c atoms of an element maps onto at least c haystack atoms
+   * of that element, so every power of two up to c is a feature
+   */
+  void addCounts() {
+    std::map<std::uint64_t, unsigned> counts;
+    for(const std::uint64_t label : labels) {
+      ++counts[label];
+    }
+    for(const auto& labelCountPair : counts) {
+      for(unsigned k = 1; k <= labelCountPair.second; k *= 2) {
+        set(extend(extend(Kind::Count, labelCountPair.first), k));
+      }
+    }
+  }
+
+  void addPaths() {
+    for(AtomIndex i = 0; i < csr.N(); ++i) {
+      path.assign(1, i);
+      extendPath(
+        extend(Kind::UntypedPath, labels[i]),
+        extend(Kind::TypedPath, labels[i])
+      );
+    }
+  }
+
+  void extendPath(const std::uint64_t untypedFeature, const std::uint64_t typedFeature) {
+    const AtomIndex back = path.back();
+    const std::size_t begin = csr.offsets()[back];
+    const std::size_t end = csr.offsets()[back + 1];
+    for(std::size_t k = begin; k < end; ++k) {
+      const AtomIndex next = csr.adjacents()[k];
+      if(std::find(std::begin(path), std::end(path), next) != std::end(path)) {
+        continue;
+      }
+
+      const std::uint64_t nextUntyped = extend(untypedFeature, labels[next]);
+      const std::uint64_t nextTyped = extend(
+        extend(typedFeature, static_cast<std::uint64_t>(csr.bondTypes()[k]) + 1),
+        labels[next]
+      );
+      if(untyped) {
+        set(nextUntyped);
+      }
+      if(typed) {
+        set(nextTyped);
+      }
+
+      if(path.size() < maxPathBonds) {
+        path.push_back(next);
+        extendPath(nextUntyped, nextTyped);
+        path.pop_back();
+      }
+    }
+  }
+
+  const CsrGraph& csr;
+  const bool untyped;
+  const bool typed;
+  std::vector<std::uint64_t> labels;
+  std::vector<AtomIndex> path;
+  Library::Fingerprint fingerprint;
+};
+
+Library::Fingerprint makeFingerprint(const Graph& graph, const bool untyped, const bool typed) {
+  FingerprintBuilder builder {graph.inner().csr(), untyped, typed};
+  builder.addCounts();
+  builder.addPaths();
+  return builder.fingerprint;
+}
+
+/* Anytime maximum common induced subgraph branch and bound after McSplit
+ * (McCreesh, Prosser, Trimble, 2017)
+ */
+class McSplit {
+public:
+  //! Vertices of either graph that are interchangeable in the current mapping
+  struct Bidomain {
+    std::vector<AtomIndex> left;
+    std::vector<AtomIndex> right;
+  };
+
+  using Domains = std::vector<Bidomain>;
+  using Pairs = std::vector<std::pair<AtomIndex, AtomIndex>>;
+
+  McSplit(
+    const CsrGraph& a,
+    const CsrGraph& b,
+    const bool bondTypes,
+    const SearchBudget& budget
+  ) : a_(a), b_(b), bondTypes_(bondTypes), budget_(budget),
+      start_(std::chrono::steady_clock::now())
+  {}
+
+  void run() {
+    // Initial domains partition vertices by element type
+    std::map<Utils::ElementType, Bidomain> elementDomains;
+    for(AtomIndex i = 0; i < a_.N(); ++i) {
+      elementDomains[a_.elementType(i)].left.push_back(i);
+    }
+    for(AtomIndex j = 0; j < b_.N(); ++j) {
+      elementDomains[b_.elementType(j)].right.push_back(j);
+    }
+    Domains domains;
+    for(auto& elementDomainPair : elementDomains) {
+      if(!elementDomainPair.second.left.empty() && !elementDomainPair.second.right.empty()) {
+        domains.push_back(std::move(elementDomainPair.second));
+      }
+    }
+
+    Pairs current;
+    if(!budget_.parallel || domains.empty()) {
+      solve_(std::move(domains), current);
+      return;
+    }
+
+    // Distribute the branches of the root node across threads
+    if(!enter_(current) || bound_(domains, current) <= bestSize_) {
+      return;
+    }
+
+    std::vector<std::pair<Domains, Pairs>> branches;
+    const unsigned d = select_(domains);
+    const AtomIndex v = pickLeft_(domains[d]);
+    for(const AtomIndex w : orderedRight_(domains[d])) {
+      branches.emplace_back(filter_(domains, v, w), Pairs {{v, w}});
+    }
+    removeLeft_(domains, d, v);
+    branches.emplace_back(std::move(domains), Pairs {});
+
+    const unsigned B = branches.size();
+    std::vector<std::exception_ptr> exceptions(B);
+#pragma omp parallel for schedule(dynamic)
+    for(unsigned i = 0; i < B; ++i) {
+      try {
+        solve_(std::move(branches[i].first), branches[i].second);
+      } catch(...) {
+        exceptions[i] = std::current_exception();
+      }
+    }
+
+    for(const auto& exceptionPtr : exceptions) {
+      if(exceptionPtr) {
+        std::rethrow_exception(exceptionPtr);
+      }
+    }
+  }
+
+  AnytimeResult result() const {
+    AnytimeResult anytimeResult;
+    for(const auto& pair : best_) {
+      anytimeResult.mapping.insert(IndexMap::value_type(pair.first, pair.second));
+    }
+    anytimeResult.optimal = !aborted_;
+    anytimeResult.nodes = nodes_;
+    return anytimeResult;
+  }
+
+private:
+  //! Edge label between two vertices, zero if not adjacent
+  unsigned label_(const CsrGraph& graph, const AtomIndex i, const AtomIndex j) const {
+    for(std::size_t k = graph.offsets()[i]; k < graph.offsets()[i + 1]; ++k) {
+      if(graph.adjacents()[k] == j) {
+        return bondTypes_ ? static_cast<unsigned>(graph.bondTypes()[k]) + 1 : 1;
+      }
+    }
+    return 0;
+  }
+
+  //! Records the current mapping and counts a search node within the budget
+  bool enter_(const Pairs& current) {
+    if(current.size() > bestSize_) {
+#pragma omp critical(mcsplitIncumbent)
+      {
+        if(current.size() > best_.size()) {
+          best_ = current;
+          bestSize_ = current.size();
+        }
+      }
+    }
+
+    if(aborted_) {
+      return false;
+    }
+
+    const unsigned long long count = ++nodes_;
+    if(budget_.nodes > 0 && count > budget_.nodes) {
+      aborted_ = true;
+      return false;
+    }
+
+    // Checking the clock is expensive compared to a search node
+    if(
+      budget_.time.count() > 0
+      && count % 64 == 0
+      && std::chrono::steady_clock::now() - start_ > budget_.time
+    ) {
+      aborted_ = true;
+      return false;
+    }
+
+    return true;
+  }
+
+  static unsigned bound_(const Domains& domains, const Pairs& current) {
+    unsigned bound = current.size();
+    for(const Bidomain& domain : domains) {
+      bound += std::min(domain.left.size(), domain.right.size());
+    }
+    return bound;
+  }
+
+  //! Domain with the smallest larger side
+  static unsigned select_(const Domains& domains) {
+    unsigned best = 0;
+    for(unsigned i = 1; i < domains.size(); ++i) {
+      const auto size = [&](const unsigned j) {
+        return std::max(domains[j].left.size(), domains[j].right.size());
+      };
+      if(size(i) < size(best)) {
+        best = i;
+      }
+    }
+    return best;
+  }
+
+  AtomIndex pickLeft_(const Bidomain& domain) const {
+    return *std::max_element(
+      std::begin(domain.left),
+      std::end(domain.left),
+      [&](const AtomIndex i, const AtomIndex j) {
+        return a_.degree(i) < a_.degree(j);
+      }
+    );
+  }
+
+  std::vector<AtomIndex> orderedRight_(const Bidomain& domain) const {
+    std::vector<AtomIndex> right = domain.right;
+    std::stable_sort(
+      std::begin(right),
+      std::end(right),
+      [&](const AtomIndex i, const AtomIndex j) {
+        return b_.degree(i) > b_.degree(j);
+      }
+    );
+    return right;
+  }
+
+  static void removeLeft_(Domains& domains, const unsigned d, const AtomIndex v) {
+    auto& left = domains[d].left;
+    left.erase(std::find(std::begin(left), std::end(left), v));
+    if(left.empty()) {
+      domains.erase(std::begin(domains) + d);
+    }
+  }
+
+  //! Refine all domains by their edge labels to the newly matched pair
+  Domains filter_(const Domains& domains, const AtomIndex v, const AtomIndex w) const {
+    constexpr unsigned nLabels = nBondTypes + 1;
+    std::array<Bidomain, nLabels> split;
+
+    Domains refined;
+    for(const Bidomain& domain : domains) {
+      for(const AtomIndex x : domain.left) {
+        if(x != v) {
+          split[label_(a_, v, x)].left.push_back(x);
+        }
+      }
+      for(const AtomIndex y : domain.right) {
+        if(y != w) {
+          split[label_(b_, w, y)].right.push_back(y);
+        }
+      }
+
+      for(Bidomain& part : split) {
+        if(!part.left.empty() && !part.right.empty()) {
+          refined.push_back(std::move(part));
+        }
+        part.left.clear();
+        part.right.clear();
+      }
+    }
+
+    return refined;
+  }
+
+  void solve_(Domains domains, Pairs& current) {
+    if(!enter_(current) || bound_(domains, current) <= bestSize_) {
+      return;
+    }
+
+    const unsigned d = select_(domains);
+    const AtomIndex v = pickLeft_(domains[d]);
+    for(const AtomIndex w : orderedRight_(domains[d])) {
+      current.emplace_back(v, w);
+      solve_(filter_(domains, v, w), current);
+      current.pop_back();
+
+      if(aborted_ || bound_(domains, current) <= bestSize_) {
+        return;
+      }
+    }
+
+    // Leave v unmatched
+    removeLeft_(domains, d, v);
+    solve_(std::move(domains), current);
+  }
+
+  const CsrGraph& a_;
+  const CsrGraph& b_;
+  const bool bondTypes_;
+  const SearchBudget budget_;
+  const std::chrono::steady_clock::time_point start_;
+
+  Pairs best_;
+  std::atomic<unsigned> bestSize_ {0};
+  std::atomic<bool> aborted_ {false};
+  std::atomic<unsigned long long> nodes_ {0};
+};
+
 } // namespace
 
 std::vector<IndexMap> complete(
@@ -283,13 +688,7 @@ std::vector<IndexMap> maximum(
   const VertexStrictness vertexStrictness,
   const EdgeStrictness edgeStrictness
 ) {
-  if(underlying(vertexStrictness) >= underlying(VertexStrictness::SubsumeShape)) {
-    throw std::runtime_error("Requested vertex comparison strictness not possible without stereopermutator information");
-  }
-
-  if(underlying(edgeStrictness) >= underlying(EdgeStrictness::SubsumeStereopermutation)) {
-    throw std::runtime_error("Requested edge comparison strictness not possible without stereopermutator information");
-  }
+  checkGraphStrictness(vertexStrictness, edgeStrictness);
 
   return maximumImpl(
     PartialMolecule(a),
@@ -313,6 +712,389 @@ std::vector<IndexMap> maximum(
   );
 }
 
+AnytimeResult anytimeMaximum(
+  const Graph& a,
+  const Graph& b,
+  const SearchBudget& budget,
+  const VertexStrictness vertexStrictness,
+  const EdgeStrictness edgeStrictness
+) {
+  MOLASSEMBLER_PROFILE_SCOPE("Subgraphs.anytimeMaximum");
+  checkGraphStrictness(vertexStrictness, edgeStrictness);
+
+  McSplit search {
+    a.inner().csr(),
+    b.inner().csr(),
+    underlying(edgeStrictness) >= underlying(EdgeStrictness::BondType),
+    budget
+  };
+  search.run();
+  return search.result();
+}
+
+constexpr unsigned Matcher::noPosition;
+
+Matcher::Matcher(
+  const Graph& needle,
+  const VertexStrictness vertexStrictness,
+  const EdgeStrictness edgeStrictness,
+  const bool uniqueImages
+) : bondTypes_(underlying(edgeStrictness) >= underlying(EdgeStrictness::BondType)),
+    uniqueImages_(uniqueImages)
+{
+  checkGraphStrictness(vertexStrictness, edgeStrictness);
+
+  const CsrGraph& csr = needle.inner().csr();
+  const std::vector<bool> needleRings = ringMembership(needle.inner());
+  const unsigned N = csr.N();
+
+  /* Greedily order vertices so that each is adjacent to as many previously
+   * ordered vertices as possible, preferring high degree. Disconnected
+   * components start anew at their highest degree vertex.
+   */
+  std::vector<unsigned> positions(N, noPosition);
+  std::vector<unsigned> orderedAdjacents(N, 0);
+  order_.reserve(N);
+  while(order_.size() < N) {
+    AtomIndex best = N;
+    for(AtomIndex i = 0; i < N; ++i) {
+      if(positions[i] != noPosition) {
+        continue;
+      }
+
+      if(
+        best == N
+        || std::make_tuple(orderedAdjacents[i], csr.degree(i))
+          > std::make_tuple(orderedAdjacents[best], csr.degree(best))
+      ) {
+        best = i;
+      }
+    }
+
+    positions[best] = order_.size();
+    order_.push_back(best);
+    for(const AtomIndex j : csr.adjacents(best)) {
+      ++orderedAdjacents[j];
+    }
+  }
+
+  checkOffsets_.reserve(N + 1);
+  checkOffsets_.push_back(0);
+  for(unsigned p = 0; p < N; ++p) {
+    const AtomIndex i = order_[p];
+    elements_.push_back(csr.elementType(i));
+    degrees_.push_back(csr.degree(i));
+    rings_.push_back(needleRings[i]);
+
+    unsigned parent = noPosition;
+    for(std::size_t k = csr.offsets()[i]; k < csr.offsets()[i + 1]; ++k) {
+      const unsigned q = positions[csr.adjacents()[k]];
+      if(q < p) {
+        checks_.push_back(Check {q, csr.bondTypes()[k]});
+        if(parent == noPosition) {
+          parent = q;
+        }
+      }
+    }
+    parents_.push_back(parent);
+    checkOffsets_.push_back(checks_.size());
+  }
+}
+
+unsigned Matcher::stream(const Graph& haystack, const MappingCallback& callback) const {
+  MOLASSEMBLER_PROFILE_SCOPE("Subgraphs.Matcher.stream");
+
+  const unsigned n = order_.size();
+  const CsrGraph& csr = haystack.inner().csr();
+  const unsigned N = csr.N();
+  if(n == 0 || n > N) {
+    return 0;
+  }
+
+  const std::vector<bool> haystackRings = ringMembership(haystack.inner());
+  const auto& offsets = csr.offsets();
+  const auto& adjacents = csr.adjacents();
+
+  // Haystack vertex matched at each position, and candidate cursors
+  std::vector<AtomIndex> images(n);
+  std::vector<std::size_t> cursors(n);
+  std::vector<std::size_t> cursorEnds(n);
+  std::vector<bool> used(N, false);
+  Mapping mapping(n);
+  std::set<std::vector<AtomIndex>> foundImages;
+  unsigned reported = 0;
+
+  auto initialize = [&](const unsigned p) {
+    if(parents_[p] == noPosition) {
+      cursors[p] = 0;
+      cursorEnds[p] = N;
+    } else {
+      const AtomIndex parentImage = images[parents_[p]];
+      cursors[p] = offsets[parentImage];
+      cursorEnds[p] = offsets[parentImage + 1];
+    }
+  };
+
+  auto feasible = [&](const unsigned p, const AtomIndex v) -> bool {
+    if(
+      used[v]
+      || csr.elementType(v) != elements_[p]
+      || csr.degree(v) < degrees_[p]
+      || (rings_[p] && !haystackRings[v])
+    ) {
+      return false;
+    }
+
+    for(unsigned c = checkOffsets_[p]; c < checkOffsets_[p + 1]; ++c) {
+      const Check& check = checks_[c];
+      const AtomIndex w = images[check.position];
+      bool found = false;
+      for(std::size_t k = offsets[v]; k < offsets[v + 1]; ++k) {
+        if(adjacents[k] == w) {
+          found = !bondTypes_ || csr.bondTypes()[k] == check.bondType;
+          break;
+        }
+      }
+      if(!found) {
+        return false;
+      }
+    }
+
+    return true;
+  };
+
+  // Sorted image vertices followed by sorted image edges
+  auto imageKey = [&]() -> std::vector<AtomIndex> {
+    std::vector<AtomIndex> vertices = images;
+    std::sort(std::begin(vertices), std::end(vertices));
+    std::vector<std::pair<AtomIndex, AtomIndex>> edges;
+    edges.reserve(checks_.size());
+    for(unsigned p = 0; p < n; ++p) {
+      for(unsigned c = checkOffsets_[p]; c < checkOffsets_[p + 1]; ++c) {
+        edges.push_back(std::minmax(images[p], images[checks_[c].position]));
+      }
+    }
+    std::sort(std::begin(edges), std::end(edges));
+    for(const auto& edge : edges) {
+      vertices.push_back(edge.first);
+      vertices.push_back(edge.second);
+    }
+    return vertices;
+  };
+
+  unsigned p = 0;
+  initialize(p);
+  while(true) {
+    // Advance to the next feasible candidate at the current position
+    bool advanced = false;
+    while(cursors[p] < cursorEnds[p]) {
+      const std::size_t cursor = cursors[p]++;
+      const AtomIndex v = (parents_[p] == noPosition) ? cursor : adjacents[cursor];
+      if(feasible(p, v)) {
+        images[p] = v;
+        advanced = true;
+        break;
+      }
+    }
+
+    if(!advanced) {
+      if(p == 0) {
+        break;
+      }
+      --p;
+      used[images[p]] = false;
+      continue;
+    }
+
+    if(p + 1 < n) {
+      used[images[p]] = true;
+      ++p;
+      initialize(p);
+      continue;
+    }
+
+    // Complete mapping
+    if(uniqueImages_ && !foundImages.insert(imageKey()).second) {
+      continue;
+    }
+
+    for(unsigned q = 0; q < n; ++q) {
+      mapping[order_[q]] = images[q];
+    }
+    ++reported;
+    if(!callback(mapping)) {
+      break;
+    }
+  }
+
+  return reported;
+}
+
+boost::optional<IndexMap> Matcher::first(const Graph& haystack) const {
+  boost::optional<IndexMap> mapOption;
+  stream(
+    haystack,
+    [&mapOption](const Mapping& mapping) -> bool {
+      mapOption = toIndexMap(mapping);
+      return false;
+    }
+  );
+  return mapOption;
+}
+
+unsigned Matcher::count(const Graph& haystack) const {
+  return stream(
+    haystack,
+    [](const Mapping& /* mapping */) -> bool { return true; }
+  );
+}
+
+std::vector<IndexMap> Matcher::find(const Graph& haystack, const unsigned limit) const {
+  std::vector<IndexMap> mappings;
+  if(limit == 0) {
+    return mappings;
+  }
+
+  stream(
+    haystack,
+    [&](const Mapping& mapping) -> bool {
+      mappings.push_back(toIndexMap(mapping));
+      return mappings.size() < limit;
+    }
+  );
+  return mappings;
+}
+
+constexpr unsigned Library::fingerprintWords;
+
+Library::Library(std::vector<Molecule> molecules) {
+  molecules_.reserve(molecules.size());
+  fingerprints_.reserve(molecules.size() * fingerprintWords);
+  for(auto& molecule : molecules) {
+    add(std::move(molecule));
+  }
+}
+
+unsigned Library::add(Molecule molecule) {
+  const Fingerprint moleculeFingerprint = makeFingerprint(molecule.graph(), true, true);
+  fingerprints_.insert(
+    std::end(fingerprints_),
+    std::begin(moleculeFingerprint),
+    std::end(moleculeFingerprint)
+  );
+  molecules_.push_back(std::move(molecule));
+  return molecules_.size() - 1;
+}
+
+const Molecule& Library::at(const unsigned i) const {
+  return molecules_.at(i);
+}
+
+Library::Fingerprint Library::fingerprint(
+  const Graph& needle,
+  const EdgeStrictness edgeStrictness
+) {
+  const bool typed = underlying(edgeStrictness) >= underlying(EdgeStrictness::BondType);
+  return makeFingerprint(needle, !typed, typed);
+}
+
+std::vector<unsigned> Library::screen(
+  const Graph& needle,
+  const EdgeStrictness edgeStrictness
+) const {
+  MOLASSEMBLER_PROFILE_SCOPE("Subgraphs.Library.screen");
+
+  const Fingerprint needleFingerprint = fingerprint(needle, edgeStrictness);
+  const unsigned needleSize = needle.N();
+
+  std::vector<unsigned> candidates;
+  const unsigned M = size();
+  const std::uint64_t* row = fingerprints_.data();
+  for(unsigned i = 0; i < M; ++i, row += fingerprintWords) {
+    // Branchless over the fixed word count so that the loop vectorizes
+    std::uint64_t missing = 0;
+    for(unsigned w = 0; w < fingerprintWords; ++w) {
+      missing |= needleFingerprint[w] & ~row[w];
+    }
+
+    if(missing == 0 && molecules_[i].graph().N() >= needleSize) {
+      candidates.push_back(i);
+    }
+  }
+
+  MOLASSEMBLER_PROFILE_COUNT("Subgraphs.Library.candidates", candidates.size());
+  return candidates;
+}
+
+void Library::search(
+  const Graph& needle,
+  const MatchCallback& callback,
+  const Matches matches,
+  const VertexStrictness vertexStrictness,
+  const EdgeStrictness edgeStrictness
+) const {
+  checkGraphStrictness(vertexStrictness, edgeStrictness);
+
+  const std::vector<unsigned> candidates = screen(needle, edgeStrictness);
+  const unsigned C = candidates.size();
+  std::vector<std::exception_ptr> exceptions(C);
+  std::atomic<bool> stop {false};
+
+#pragma omp parallel for schedule(dynamic)
+  for(unsigned k = 0; k < C; ++k) {
+    if(stop) {
+      continue;
+    }
+
+    try {
+      const unsigned i = candidates[k];
+      std::vector<IndexMap> mappings = completeImpl(
+        PartialMolecule(needle),
+        PartialMolecule(molecules_[i].graph()),
+        vertexStrictness,
+        edgeStrictness,
+        matches == Matches::First
+      );
+
+      if(!mappings.empty()) {
+#pragma omp critical(subgraphLibraryCallback)
+        {
+          if(!stop && !callback(i, std::move(mappings))) {
+            stop = true;
+          }
+        }
+      }
+    } catch(...) {
+      exceptions[k] = std::current_exception();
+    }
+  }
+
+  for(const auto& exceptionPtr : exceptions) {
+    if(exceptionPtr) {
+      std::rethrow_exception(exceptionPtr);
+    }
+  }
+}
+
+unsigned Library::count(
+  const Graph& needle,
+  const VertexStrictness vertexStrictness,
+  const EdgeStrictness edgeStrictness
+) const {
+  unsigned matchCount = 0;
+  search(
+    needle,
+    [&matchCount](unsigned /* i */, std::vector<IndexMap> /* mappings */) -> bool {
+      ++matchCount;
+      return true;
+    },
+    Matches::First,
+    vertexStrictness,
+    edgeStrictness
+  );
+  return matchCount;
+}
+
 } // namespace Subgraphs
 } // namespace Molassembler
 } // namespace Scine
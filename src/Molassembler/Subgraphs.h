@@ -9,15 +9,16 @@
 #define INCLUDE_MOLASSEMBLER_SUBGRAPHS_H
 
 #include "boost/bimap.hpp"
-#include "Molassembler/Types.h"
+#include "Molassembler/Molecule.h"
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <limits>
 
 namespace Scine {
 namespace Molassembler {
 
-// Forward-declarations
-class Molecule;
-class Graph;
-
 namespace Subgraphs {
 
 /*!
@@ -179,6 +180,308 @@ MASM_EXPORT std::vector<IndexMap> maximum(
   EdgeStrictness edgeStrictness = EdgeStrictness::Topographic
 );
 
+/**
+ * @brief Limits on an anytime maximum common subgraph search
+ *
+ * A zero limit is no limit.
+ */
+struct MASM_EXPORT SearchBudget {
+  //! Wall-clock time limit
+  std::chrono::milliseconds time {0};
+  //! Limit on the number of branch and bound search nodes
+  unsigned long long nodes = 0;
+  //! Whether to distribute the top-level branches across threads
+  bool parallel = false;
+};
+
+//! Result of an anytime maximum common subgraph search
+struct MASM_EXPORT AnytimeResult {
+  //! Best mapping found, from vertices of the first to the second graph
+  IndexMap mapping;
+  //! Whether the search completed, proving the mapping maximum
+  bool optimal = false;
+  //! Number of branch and bound search nodes visited
+  unsigned long long nodes = 0;
+};
+
+/*!
+ * @brief Find a maximum common induced subgraph within a search budget
+ *
+ * Branch and bound in the manner of McSplit: vertices of both graphs are
+ * partitioned into label classes that are refined by adjacency (and bond
+ * type) to each matched pair, and the sum over classes of the smaller class
+ * size bounds how far the current mapping can be extended. When the budget
+ * is exhausted, the best mapping found so far is returned.
+ *
+ * Like maximum(), the common subgraph is induced and may be disconnected,
+ * but only a single mapping is found.
+ *
+ * @params a The first graph
+ * @params b The second graph
+ * @params budget Time and node limits of the search
+ * @params vertexStrictness Strictness with which to allow vertex matching.
+ *   Maximum strictness is VertexStrictness::ElementType.
+ * @params edgeStrictness Strictness with which to allow edge matching.
+ *   Maximum strictness is EdgeStrictness::BondType.
+ *
+ * @throws std::runtime_error If the requested strictness requires
+ *   stereopermutator information
+ *
+ * @complexity{Exponential in the worst case, limited by the budget}
+ */
+MASM_EXPORT AnytimeResult anytimeMaximum(
+  const Graph& a,
+  const Graph& b,
+  const SearchBudget& budget = SearchBudget {},
+  VertexStrictness vertexStrictness = VertexStrictness::ElementType,
+  EdgeStrictness edgeStrictness = EdgeStrictness::Topographic
+);
+
+/**
+ * @brief Subgraph monomorphism matcher for a fixed needle
+ *
+ * Backtracking matcher in the manner of VF2 that works on compact adjacency
+ * arrays. Needle vertices are matched in an order in which each vertex is
+ * adjacent to as many previously matched vertices as possible, so that
+ * candidates are drawn from the adjacencies of an already matched vertex.
+ * Candidates are pruned by element type, degree and ring membership before
+ * adjacencies to matched vertices are checked.
+ *
+ * Unlike complete(), mappings are not materialized unless requested, and
+ * enumeration can be stopped at any point. Optionally, mappings that are
+ * equivalent under automorphisms of the needle, i.e. that have the same image
+ * in the haystack, are reported only once.
+ *
+ * @note Ring membership of the haystack is determined from its cached
+ *   removal safety data, so matching is not thread-safe on a haystack whose
+ *   cached properties have not been populated.
+ */
+class MASM_EXPORT Matcher {
+public:
+//!@name Member types
+//!@{
+  //! Haystack vertex for each needle vertex
+  using Mapping = std::vector<AtomIndex>;
+  /*! @brief Receives mappings as they are found
+   *
+   * Returning false stops the enumeration.
+   */
+  using MappingCallback = std::function<bool(const Mapping&)>;
+//!@}
+
+//!@name Constructors
+//!@{
+  /*! @brief Prepare matching of a needle
+   *
+   * @param needle The smaller graph to search for
+   * @param vertexStrictness Strictness with which to allow vertex matching.
+   *   Maximum strictness is VertexStrictness::ElementType.
+   * @param edgeStrictness Strictness with which to allow edge matching.
+   *   Maximum strictness is EdgeStrictness::BondType.
+   * @param uniqueImages Whether to report only one of each set of mappings
+   *   that are equivalent under needle automorphisms
+   *
+   * @throws std::runtime_error If the requested strictness requires
+   *   stereopermutator information
+   *
+   * @complexity{@math{O(N^2)}}
+   */
+  explicit Matcher(
+    const Graph& needle,
+    VertexStrictness vertexStrictness = VertexStrictness::ElementType,
+    EdgeStrictness edgeStrictness = EdgeStrictness::Topographic,
+    bool uniqueImages = false
+  );
+//!@}
+
+//!@name Matching
+//!@{
+  /*! @brief Stream all mappings into a callback
+   *
+   * @returns The number of mappings passed to the callback
+   */
+  unsigned stream(const Graph& haystack, const MappingCallback& callback) const;
+
+  //! First mapping found, if any
+  boost::optional<IndexMap> first(const Graph& haystack) const;
+
+  //! Number of mappings, without materializing them
+  unsigned count(const Graph& haystack) const;
+
+  //! Up to @p limit mappings
+  std::vector<IndexMap> find(
+    const Graph& haystack,
+    unsigned limit = std::numeric_limits<unsigned>::max()
+  ) const;
+//!@}
+
+private:
+  //! Adjacency to a vertex earlier in the match order
+  struct Check {
+    unsigned position;
+    BondType bondType;
+  };
+
+  //! Position of no vertex in the match order
+  static constexpr unsigned noPosition = std::numeric_limits<unsigned>::max();
+
+  bool bondTypes_;
+  bool uniqueImages_;
+  //! Needle vertex at each position of the match order
+  std::vector<AtomIndex> order_;
+  //! Element type of the needle vertex at each position
+  std::vector<Utils::ElementType> elements_;
+  //! Degree of the needle vertex at each position
+  std::vector<unsigned> degrees_;
+  //! Ring membership of the needle vertex at each position
+  std::vector<bool> rings_;
+  //! An earlier adjacent position for each position, or noPosition
+  std::vector<unsigned> parents_;
+  //! Adjacencies to earlier positions, delimited by checkOffsets_
+  std::vector<Check> checks_;
+  std::vector<unsigned> checkOffsets_;
+};
+
+/**
+ * @brief Substructure search index over a library of molecules
+ *
+ * Each molecule is stored with a fixed-width fingerprint of features that
+ * subgraph monomorphisms preserve: element counts and element-labeled paths
+ * of up to three bonds, both with and without bond types. Any haystack
+ * containing a needle has a fingerprint that is a bitwise superset of the
+ * needle's fingerprint, so most haystacks can be discarded by a contiguous
+ * scan over the fingerprint table before exact matching is attempted on the
+ * survivors in parallel.
+ *
+ * @code{.cpp}
+ * Subgraphs::Library library;
+ * for(auto& molecule : molecules) {
+ *   library.add(std::move(molecule));
+ * }
+ * const Molecule pattern = IO::Experimental::parseSmilesSingleMolecule("C(=O)N");
+ * const unsigned hits = library.count(pattern.graph());
+ * @endcode
+ */
+class MASM_EXPORT Library {
+public:
+//!@name Member types
+//!@{
+  //! Number of 64 bit words in a fingerprint
+  static constexpr unsigned fingerprintWords = 16;
+  //! Fixed-width fingerprint bitset
+  using Fingerprint = std::array<std::uint64_t, fingerprintWords>;
+
+  //! How many mappings to find in each matching molecule
+  enum class Matches {
+    //! All mappings, as in complete()
+    All,
+    //! Only the first mapping found
+    First
+  };
+
+  /*! @brief Receives matches as they are found
+   *
+   * Called with the library index of a matching molecule and its mappings.
+   * Calls are serialized, but their order is unspecified. Returning false
+   * stops the search.
+   */
+  using MatchCallback = std::function<bool(unsigned, std::vector<IndexMap>)>;
+//!@}
+
+//!@name Constructors
+//!@{
+  //! Empty library
+  Library() = default;
+
+  /*! @brief Index a list of molecules
+   *
+   * @complexity{@math{\Theta(M)} fingerprints}
+   */
+  explicit Library(std::vector<Molecule> molecules);
+//!@}
+
+//!@name Modification
+//!@{
+  /*! @brief Add a molecule to the library
+   *
+   * @complexity{@math{O(N)} for sparse graphs of bounded degree}
+   * @returns The library index of the added molecule
+   */
+  unsigned add(Molecule molecule);
+//!@}
+
+//!@name Information
+//!@{
+  //! Number of molecules in the library
+  inline unsigned size() const {
+    return molecules_.size();
+  }
+
+  /*! @brief Access a library molecule
+   *
+   * @throws std::out_of_range If the index is invalid
+   */
+  const Molecule& at(unsigned i) const;
+
+  /*! @brief Fingerprint of a needle graph
+   *
+   * Contains only the features relevant to the edge strictness. Library
+   * molecules store the features of both implemented edge strictnesses.
+   *
+   * @complexity{@math{O(N)} for sparse graphs of bounded degree}
+   */
+  static Fingerprint fingerprint(const Graph& needle, EdgeStrictness edgeStrictness);
+//!@}
+
+//!@name Searching
+//!@{
+  /*! @brief Indices of library molecules that may contain the needle
+   *
+   * No molecule that contains the needle is discarded.
+   *
+   * @complexity{@math{\Theta(M)}}
+   */
+  std::vector<unsigned> screen(
+    const Graph& needle,
+    EdgeStrictness edgeStrictness = EdgeStrictness::Topographic
+  ) const;
+
+  /*! @brief Stream subgraph matches of a needle in the library
+   *
+   * Screens the library and runs complete() on surviving molecules in
+   * parallel, passing each molecule's non-empty mappings to @p callback.
+   *
+   * @throws std::runtime_error If the requested strictness requires
+   *   stereopermutator information
+   */
+  void search(
+    const Graph& needle,
+    const MatchCallback& callback,
+    Matches matches = Matches::All,
+    VertexStrictness vertexStrictness = VertexStrictness::ElementType,
+    EdgeStrictness edgeStrictness = EdgeStrictness::Topographic
+  ) const;
+
+  /*! @brief Number of library molecules containing the needle
+   *
+   * Stops matching each molecule at its first mapping.
+   *
+   * @throws std::runtime_error If the requested strictness requires
+   *   stereopermutator information
+   */
+  unsigned count(
+    const Graph& needle,
+    VertexStrictness vertexStrictness = VertexStrictness::ElementType,
+    EdgeStrictness edgeStrictness = EdgeStrictness::Topographic
+  ) const;
+//!@}
+
+private:
+  std::vector<Molecule> molecules_;
+  //! Concatenated fingerprints of all molecules
+  std::vector<std::uint64_t> fingerprints_;
+};
+
 } // namespace Subgraphs
 } // namespace Molassembler
 } // namespace Scine
@@ -0,0 +1,125 @@
+/*!@file
+ * @copyright This code is licensed under the 3-clause BSD license.
+ *   Copyright ETH Zurich, Laboratory of Physical Chemistry, Reiher Group.
+ *   See LICENSE.txt for details.
+ */
+
+#include "boost/test/unit_test.hpp"
+
+#include "Molassembler/DistanceGeometry/ConformerGeneration.h"
+#include "Molassembler/Conformers.h"
+#include "Molassembler/IO.h"
+#include "Molassembler/Molecule.h"
+#include "Molassembler/Prng.h"
+#include "Molassembler/StereopermutatorList.h"
+
+using namespace Scine::Molassembler;
+
+BOOST_AUTO_TEST_CASE(AssignmentFailureMemoThreshold, *boost::unit_test::label("DG")) {
+  using DistanceGeometry::AssignmentFailureMemo;
+
+  AssignmentFailureMemo memo;
+  const AssignmentFailureMemo::Key failing {0, 4, 0, 1};
+  const AssignmentFailureMemo::Key flaky {0, 4, 0, 0};
+
+  BOOST_CHECK(!memo.infeasible(failing));
+  for(unsigned i = 0; i < AssignmentFailureMemo::failureThreshold; ++i) {
+    BOOST_CHECK(!memo.infeasible(failing));
+    memo.record(failing, false);
+    memo.record(flaky, false);
+  }
+  BOOST_CHECK(memo.infeasible(failing));
+  BOOST_CHECK(memo.infeasible(flaky));
+
+  // A single success makes an assignment feasible for good
+  memo.record(flaky, true);
+  memo.record(flaky, false);
+  BOOST_CHECK(!memo.infeasible(flaky));
+  BOOST_CHECK(memo.infeasible(failing));
+}
+
+BOOST_AUTO_TEST_CASE(AvoidInfeasibleAssignments, *boost::unit_test::label("DG")) {
+  using DistanceGeometry::AssignmentFailureMemo;
+
+  Molecule mol = IO::read("stereocenter_detection_molecules/RSs-halogenated-propane.mol");
+  std::vector<AtomIndex> stereocenters;
+  for(const auto& permutator : mol.stereopermutators().atomStereopermutators()) {
+    if(permutator.numAssignments() > 1) {
+      stereocenters.push_back(permutator.placement());
+    }
+  }
+  for(const AtomIndex i : stereocenters) {
+    mol.assignStereopermutator(i, boost::none);
+  }
+  BOOST_REQUIRE(mol.stereopermutators().hasUnassignedStereopermutators());
+
+  // Keys only depend on the assignments
+  BOOST_CHECK(
+    AssignmentFailureMemo::key(mol) == AssignmentFailureMemo::key(Molecule {mol})
+  );
+
+  DistanceGeometry::Configuration configuration;
+  configuration.avoidInfeasibleAssignments = true;
+  const auto ensemble = generateRandomEnsemble(mol, 4, configuration);
+  for(const auto& conformerResult : ensemble) {
+    BOOST_CHECK_MESSAGE(
+      conformerResult,
+      "Conformer generation avoiding infeasible assignments failed: "
+      << conformerResult.error().message()
+    );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(RedrawInfeasibleAssignments, *boost::unit_test::label("DG")) {
+  using DistanceGeometry::AssignmentFailureMemo;
+
+  Molecule mol = IO::read("stereocenter_detection_molecules/RSs-halogenated-propane.mol");
+  for(const auto& permutator : mol.stereopermutators().atomStereopermutators()) {
+    if(permutator.numAssignments() > 1) {
+      mol.assignStereopermutator(permutator.placement(), boost::none);
+    }
+  }
+  BOOST_REQUIRE(mol.stereopermutators().hasUnassignedStereopermutators());
+
+  Random::Engine engine {1042};
+
+  /* Pick an assignment and let its modeling fail often enough for it to be
+   * known infeasible
+   */
+  AssignmentFailureMemo memo;
+  const auto infeasibleKey = AssignmentFailureMemo::key(
+    DistanceGeometry::Detail::narrow(mol, engine)
+  );
+  for(unsigned i = 0; i < AssignmentFailureMemo::failureThreshold; ++i) {
+    memo.record(infeasibleKey, false);
+  }
+  BOOST_REQUIRE(memo.infeasible(infeasibleKey));
+  BOOST_REQUIRE_EQUAL(memo.redraws(), 0u);
+
+  /* Generate conformers until random assignment has drawn the infeasible
+   * assignment at least once. Modeling it would succeed and mark it feasible,
+   * so it must have been redrawn each time.
+   */
+  const DistanceGeometry::Configuration configuration;
+  std::shared_ptr<DistanceGeometry::MoleculeDGInformation> DgDataPtr;
+  const unsigned maxConformers = 100;
+  for(unsigned i = 0; i < maxConformers && memo.redraws() == 0; ++i) {
+    const auto conformerResult = DistanceGeometry::generateConformer(
+      mol,
+      configuration,
+      DgDataPtr,
+      true,
+      engine,
+      1,
+      &memo
+    );
+    BOOST_CHECK_MESSAGE(
+      conformerResult,
+      "Conformer generation with a known infeasible assignment failed: "
+      << conformerResult.error().message()
+    );
+  }
+
+  BOOST_CHECK_GT(memo.redraws(), 0u);
+  BOOST_CHECK(memo.infeasible(infeasibleKey));
+}
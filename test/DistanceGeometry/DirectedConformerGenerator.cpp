@@ -28,6 +28,10 @@
 #include <iomanip>
 #include <iostream>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace std::string_literals;
 using namespace Scine;
 using namespace Molassembler;
@@ -227,3 +231,53 @@ BOOST_AUTO_TEST_CASE(DirConfGenRelabeler, *boost::unit_test::label("DG")) {
   auto binIndices = relabeler.binIndices(bins);
   auto midpoints = relabeler.binMidpointIntegers(binIndices, bins);
 }
+
+BOOST_AUTO_TEST_CASE(DirConfGenIndexedEnumeration, *boost::unit_test::label("DG")) {
+  auto mol = IO::Experimental::parseSmilesSingleMolecule("CCC(=O)O");
+  auto generator = DirectedConformerGenerator(mol);
+
+  DirectedConformerGenerator::EnumerationSettings settings;
+  settings.indexedEnumeration = true;
+
+  using DecisionLists = std::vector<DirectedConformerGenerator::DecisionList>;
+  auto enumerateDecisionLists = [&]() {
+    DecisionLists decisionLists;
+    generator.enumerate(
+      [&](const auto& decisionList, const auto& /* conf */) {
+        decisionLists.push_back(decisionList);
+      },
+      1010,
+      settings
+    );
+    return decisionLists;
+  };
+
+  // Serial reference
+#ifdef _OPENMP
+  const int maxThreads = omp_get_max_threads();
+  omp_set_num_threads(1);
+#endif
+  const DecisionLists serialDecisionLists = enumerateDecisionLists();
+#ifdef _OPENMP
+  omp_set_num_threads(maxThreads);
+#endif
+
+  const DecisionLists decisionLists = enumerateDecisionLists();
+
+  BOOST_REQUIRE_EQUAL(generator.idealEnsembleSize(), 12);
+  BOOST_CHECK_EQUAL(generator.decisionListSetSize(), generator.idealEnsembleSize());
+  BOOST_CHECK_MESSAGE(
+    decisionLists.size() >= 10,
+    "Expected at least 10 conformers from indexed enumeration, got " << decisionLists.size()
+  );
+
+  // Each index is generated from its own seed regardless of the thread count
+  BOOST_CHECK_EQUAL(decisionLists.size(), serialDecisionLists.size());
+  BOOST_CHECK(decisionLists == serialDecisionLists);
+
+  // Callbacks are in order of decision list index, so each list is unique
+  BOOST_CHECK(std::is_sorted(std::begin(decisionLists), std::end(decisionLists)));
+  BOOST_CHECK(
+    std::adjacent_find(std::begin(decisionLists), std::end(decisionLists)) == std::end(decisionLists)
+  );
+}
@@ -0,0 +1,102 @@
+/*!@file
+ * @copyright This code is licensed under the 3-clause BSD license.
+ *   Copyright ETH Zurich, Laboratory of Physical Chemistry, Reiher Group.
+ *   See LICENSE.txt for details.
+ */
+
+#include "boost/test/unit_test.hpp"
+
+#include "Molassembler/DistanceGeometry/EnsembleFilter.h"
+#include "Molassembler/DistanceGeometry/Error.h"
+#include "Molassembler/Graph/Canonicalization.h"
+#include "Molassembler/Graph.h"
+#include "Molassembler/Conformers.h"
+#include "Molassembler/IO.h"
+#include "Molassembler/Molecule.h"
+
+#include <Eigen/Geometry>
+
+using namespace Scine::Molassembler;
+using DistanceGeometry::EnsembleFilter;
+
+BOOST_AUTO_TEST_CASE(EnsembleFilterRejectsDuplicates, *boost::unit_test::label("DG")) {
+  const Eigen::MatrixXd positions = 2 * Eigen::MatrixXd::Random(8, 3);
+  const Eigen::Matrix3d rotation = Eigen::AngleAxisd(
+    0.8,
+    Eigen::Vector3d(1, -2, 3).normalized()
+  ).toRotationMatrix();
+  const Eigen::MatrixXd rotated = (positions * rotation.transpose()).rowwise() + Eigen::RowVector3d(1, 2, 3);
+
+  BOOST_CHECK_SMALL(EnsembleFilter::rmsd(positions, rotated), 1e-8);
+
+  // Descriptor distance is a lower bound to the RMSD
+  const Eigen::MatrixXd perturbed = positions + 0.3 * Eigen::MatrixXd::Random(8, 3);
+  BOOST_CHECK_LE(
+    (EnsembleFilter::descriptor(positions) - EnsembleFilter::descriptor(perturbed)).norm(),
+    EnsembleFilter::rmsd(positions, perturbed) + 1e-10
+  );
+
+  EnsembleFilter filter {0.1};
+  BOOST_CHECK(filter.accept(positions));
+  BOOST_CHECK(!filter.accept(rotated));
+  BOOST_CHECK(filter.accept(2 * positions));
+  BOOST_CHECK_EQUAL(filter.size(), 2);
+
+  // Exchanging equivalent atoms is only a duplicate if symmetry-aware
+  Eigen::MatrixXd swapped = rotated;
+  swapped.row(1) = rotated.row(5);
+  swapped.row(5) = rotated.row(1);
+  const std::vector<std::vector<AtomIndex>> swap {{0, 5, 2, 3, 4, 1, 6, 7}};
+  BOOST_CHECK_GT(EnsembleFilter::rmsd(positions, swapped), 0.1);
+  BOOST_CHECK_SMALL(EnsembleFilter::rmsd(positions, swapped, swap), 1e-8);
+
+  EnsembleFilter symmetricFilter {0.1, swap};
+  BOOST_CHECK(symmetricFilter.accept(positions));
+  BOOST_CHECK(!symmetricFilter.accept(swapped));
+
+  // Relabelings not generated by the automorphisms are not applied
+  Eigen::MatrixXd otherSwapped = rotated;
+  otherSwapped.row(2) = rotated.row(6);
+  otherSwapped.row(6) = rotated.row(2);
+  BOOST_CHECK_GT(EnsembleFilter::rmsd(positions, otherSwapped, swap), 0.1);
+  BOOST_CHECK(symmetricFilter.accept(otherSwapped));
+
+  // Descent steps include generator inverses
+  Eigen::MatrixXd cycled = rotated;
+  cycled.row(1) = rotated.row(3);
+  cycled.row(3) = rotated.row(5);
+  cycled.row(5) = rotated.row(1);
+  const std::vector<std::vector<AtomIndex>> cycle {{0, 3, 2, 5, 4, 1, 6, 7}};
+  BOOST_CHECK_SMALL(EnsembleFilter::rmsd(positions, cycled, cycle), 1e-8);
+}
+
+BOOST_AUTO_TEST_CASE(DeduplicatedEnsembles, *boost::unit_test::label("DG")) {
+  // Hydrogen atoms of each methylene and methyl group are equivalent
+  const Molecule octadecane = IO::read("various/octadecane.mol");
+  const AutomorphismOrbits orbits {
+    octadecane.graph().N(),
+    EnsembleFilter::automorphisms(octadecane)
+  };
+  BOOST_CHECK_LT(orbits.size(), octadecane.graph().N());
+
+  const Molecule mol = IO::read("stereocenter_detection_molecules/RSs-halogenated-propane.mol");
+
+  // With an enormous threshold, only a single conformer is accepted
+  DistanceGeometry::Configuration configuration;
+  configuration.deduplicationRmsd = 100;
+  configuration.symmetryAwareDeduplication = true;
+  const auto ensemble = generateEnsemble(mol, 6, 1010, configuration);
+
+  unsigned accepted = 0;
+  for(const auto& conformerResult : ensemble) {
+    if(conformerResult) {
+      ++accepted;
+    } else {
+      BOOST_CHECK_MESSAGE(
+        conformerResult.error() == DgError::DuplicateConformer,
+        "Unexpected conformer generation failure: " << conformerResult.error().message()
+      );
+    }
+  }
+  BOOST_CHECK_EQUAL(accepted, 1);
+}
@@ -13,10 +13,15 @@
 #include "Molassembler/DistanceGeometry/ExplicitBoundsGraph.h"
 #include "Molassembler/DistanceGeometry/SpatialModel.h"
 #include "Molassembler/IO.h"
+#include "Molassembler/IO/SmilesParser.h"
+#include "Molassembler/Prng.h"
+#include "Molassembler/Temple/Random.h"
 #include "ShortestPathsGraphTests.h"
 
 #include <iostream>
 #include <iomanip>
+#include <limits>
+#include <numeric>
 
 inline std::ostream& nl(std::ostream& os) {
   os << '\n';
@@ -107,3 +112,182 @@ BOOST_AUTO_TEST_CASE(ExplicitBoundsGraphStructure, *boost::unit_test::label("DG"
   }
 #endif
 }
+
+BOOST_AUTO_TEST_CASE(ExplicitBoundsGraphSparseBounds, *boost::unit_test::label("DG")) {
+  using namespace Scine::Molassembler;
+  using namespace DistanceGeometry;
+
+  for(
+    const boost::filesystem::path& currentFilePath :
+    boost::filesystem::recursive_directory_iterator("stereocenter_detection_molecules")
+  ) {
+    Molecule molecule = IO::read(
+      currentFilePath.string()
+    );
+
+    SpatialModel spatialModel {molecule, Configuration {}};
+    const PairwiseBounds bounds = spatialModel.makePairwiseBounds();
+    const Eigen::MatrixXd boundsMatrix = bounds.toMatrix();
+
+    // Sparse representation round trips through the dense one
+    const AtomIndex N = molecule.graph().N();
+    BOOST_REQUIRE_EQUAL(bounds.N(), N);
+    unsigned explicitPairs = 0;
+    for(AtomIndex i = 0; i < N; ++i) {
+      for(AtomIndex j = i + 1; j < N; ++j) {
+        const auto pairBounds = bounds.get(j, i);
+        if(pairBounds) {
+          ++explicitPairs;
+          BOOST_CHECK_EQUAL(pairBounds->lower, boundsMatrix(j, i));
+          BOOST_CHECK_EQUAL(pairBounds->upper, boundsMatrix(i, j));
+        } else {
+          BOOST_CHECK(boundsMatrix(j, i) == 0.0 && boundsMatrix(i, j) == 0.0);
+        }
+      }
+    }
+    BOOST_CHECK_EQUAL(explicitPairs, bounds.size());
+
+    /* The sparse graph has edges for explicit bounds only and generates the
+     * van der Waals lower bounds of all other pairs
+     */
+    ExplicitBoundsGraph sparseGraph {molecule.graph().inner(), bounds};
+    ExplicitBoundsGraph denseGraph {molecule.graph().inner(), boundsMatrix};
+    const unsigned pairs = N * (N - 1) / 2;
+    BOOST_CHECK_EQUAL(boost::num_edges(sparseGraph.graph()), 6 * bounds.size());
+    BOOST_CHECK_EQUAL(
+      boost::num_edges(denseGraph.graph()),
+      6 * bounds.size() + 2 * (pairs - bounds.size())
+    );
+    for(AtomIndex i = 0; i < N; ++i) {
+      for(AtomIndex j = 0; j < N; ++j) {
+        if(i != j) {
+          BOOST_CHECK_EQUAL(sparseGraph.lowerBound(i, j), denseGraph.lowerBound(i, j));
+        }
+      }
+    }
+
+    // Shortest paths may sum up equally long paths in different order
+    auto sparseDistanceBounds = sparseGraph.makeDistanceBounds();
+    auto denseDistanceBounds = denseGraph.makeDistanceBounds();
+    BOOST_REQUIRE(sparseDistanceBounds && denseDistanceBounds);
+    const double boundsDeviation = (
+      sparseDistanceBounds.value() - denseDistanceBounds.value()
+    ).cwiseAbs().maxCoeff();
+    BOOST_CHECK_MESSAGE(
+      boundsDeviation < 1e-8,
+      "Distance bounds differ between sparse and dense bounds by "
+        << boundsDeviation << " for " << currentFilePath.string()
+    );
+
+    Random::Engine sparseEngine {1042};
+    Random::Engine denseEngine {sparseEngine};
+    auto sparseDistances = sparseGraph.makeDistanceMatrix(sparseEngine);
+    auto denseDistances = denseGraph.makeDistanceMatrix(denseEngine);
+    BOOST_REQUIRE(sparseDistances && denseDistances);
+    const double distancesDeviation = (
+      sparseDistances.value() - denseDistances.value()
+    ).cwiseAbs().maxCoeff();
+    BOOST_CHECK_MESSAGE(
+      distancesDeviation < 1e-8,
+      "Distance matrices differ between sparse and dense bounds by "
+        << distancesDeviation << " for " << currentFilePath.string()
+    );
+  }
+}
+
+namespace {
+
+using EG = Scine::Molassembler::DistanceGeometry::ExplicitBoundsGraph;
+
+//! Single-source shortest distances by Bellman-Ford, computed from scratch
+std::vector<double> bellmanFordDistances(
+  const EG::GraphType& graph,
+  const EG::VertexDescriptor source
+) {
+  const double unreached = std::numeric_limits<double>::max();
+  std::vector<double> distances(boost::num_vertices(graph), unreached);
+  distances.at(source) = 0.0;
+
+  const auto weights = boost::get(boost::edge_weight, graph);
+  bool changed = true;
+  while(changed) {
+    changed = false;
+    for(auto edges = boost::edges(graph); edges.first != edges.second; ++edges.first) {
+      const auto u = boost::source(*edges.first, graph);
+      if(distances.at(u) == unreached) {
+        continue;
+      }
+
+      const auto v = boost::target(*edges.first, graph);
+      const double candidate = distances.at(u) + weights[*edges.first];
+      if(candidate < distances.at(v)) {
+        distances.at(v) = candidate;
+        changed = true;
+      }
+    }
+  }
+
+  return distances;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(ExplicitBoundsGraphIncrementalPropagation, *boost::unit_test::label("DG")) {
+  using namespace Scine::Molassembler;
+  using namespace DistanceGeometry;
+
+  /* Metrization propagates each fixed distance incrementally. Replay it with
+   * the same random state, recomputing shortest paths from scratch after each
+   * fixed distance, and compare the resulting distances.
+   */
+  const Molecule molecule = IO::Experimental::parseSmilesSingleMolecule("CC(O)C=CC(N)Cl");
+  const AtomIndex N = molecule.graph().N();
+  SpatialModel spatialModel {molecule, Configuration {}};
+  const PairwiseBounds bounds = spatialModel.makePairwiseBounds();
+
+  Random::Engine incrementalEngine {1042};
+  Random::Engine referenceEngine {incrementalEngine};
+
+  EG incrementalGraph {molecule.graph().inner(), bounds};
+  auto incrementalResult = incrementalGraph.makeDistanceMatrix(incrementalEngine);
+  BOOST_REQUIRE(incrementalResult);
+  const Eigen::MatrixXd incremental = incrementalResult.value();
+
+  // The reference graph has explicit edges for all lower bounds
+  EG referenceGraph {molecule.graph().inner(), bounds.toMatrix()};
+  Eigen::MatrixXd reference = Eigen::MatrixXd::Zero(N, N);
+
+  std::vector<AtomIndex> indices(N);
+  std::iota(std::begin(indices), std::end(indices), 0);
+  Temple::Random::shuffle(indices, referenceEngine);
+
+  for(const AtomIndex a : indices) {
+    std::vector<AtomIndex> otherIndices;
+    for(AtomIndex b = 0; b < N; ++b) {
+      if(b != a && reference(std::min(a, b), std::max(a, b)) == 0) {
+        otherIndices.push_back(b);
+      }
+    }
+
+    Temple::Random::shuffle(otherIndices, referenceEngine);
+
+    for(const AtomIndex b : otherIndices) {
+      const auto distances = bellmanFordDistances(referenceGraph.graph(), EG::left(a));
+      const double lower = -distances.at(EG::right(b));
+      const double upper = distances.at(EG::left(b));
+      BOOST_REQUIRE_LE(lower, upper);
+
+      const double fixed = Temple::Random::getSingle<double>(lower, upper, referenceEngine);
+      reference(std::min(a, b), std::max(a, b)) = fixed;
+      // Parallel edges with tighter weights dominate in shortest paths
+      referenceGraph.addBound(a, b, ValueBounds {fixed, fixed});
+    }
+  }
+
+  const double maxDeviation = (incremental - reference).cwiseAbs().maxCoeff();
+  BOOST_CHECK_MESSAGE(
+    maxDeviation < 1e-8,
+    "Incrementally propagated distances deviate from full recomputation by "
+      << maxDeviation
+  );
+}
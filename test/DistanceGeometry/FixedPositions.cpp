@@ -7,11 +7,16 @@
 #define BOOST_FILESYSTEM_NO_DEPRECATED
 
 #include "boost/filesystem.hpp"
+#include "boost/optional/optional_io.hpp"
 #include "boost/test/unit_test.hpp"
 
 #include "Molassembler/Conformers.h"
+#include "Molassembler/Graph.h"
 #include "Molassembler/Molecule.h"
 #include "Molassembler/IO.h"
+#include "Molassembler/IO/SmilesParser.h"
+#include "Molassembler/StereopermutatorList.h"
+#include "Molassembler/AtomStereopermutator.h"
 
 #include "Utils/Typenames.h"
 
@@ -86,3 +91,85 @@ BOOST_AUTO_TEST_CASE(FixedPositionsWork, *boost::unit_test::label("DG")) {
     "The ring-like positions aren't fixed as required."
   );
 }
+
+BOOST_AUTO_TEST_CASE(FrozenFixedPositions, *boost::unit_test::label("DG")) {
+  auto octadecane = IO::read("various/octadecane.mol");
+
+  // Take the positions of a generated conformer's first half as the core
+  DistanceGeometry::Configuration config;
+  auto referenceResult = generateRandomConformation(octadecane, config);
+  BOOST_REQUIRE_MESSAGE(referenceResult, "Could not generate a reference conformer for octadecane");
+  const Utils::PositionCollection& reference = referenceResult.value();
+
+  const AtomIndex N = octadecane.graph().N();
+  for(AtomIndex i = 0; i < N / 2; ++i) {
+    config.fixedPositions.emplace_back(i, reference.row(i));
+  }
+  config.freezeFixedPositions = true;
+
+  auto conformerResult = generateRandomConformation(octadecane, config);
+  BOOST_REQUIRE_MESSAGE(
+    conformerResult,
+    "Could not generate a conformer for octadecane with frozen fixed positions: "
+    << conformerResult.error().message()
+  );
+
+  for(const auto& fixedPositionPair : config.fixedPositions) {
+    BOOST_CHECK_MESSAGE(
+      conformerResult.value().row(fixedPositionPair.first).isApprox(
+        fixedPositionPair.second,
+        1e-6
+      ),
+      "Frozen atom " << fixedPositionPair.first << " moved from "
+      << fixedPositionPair.second << " to "
+      << conformerResult.value().row(fixedPositionPair.first)
+    );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(FrozenFewFixedPositionsKeepStereo, *boost::unit_test::label("DG")) {
+  /* One or two fixed atoms do not determine the handedness of a structure, so
+   * refinement must still be able to invert it to match the stereocenter
+   */
+  const Molecule alanine = IO::Experimental::parseSmilesSingleMolecule("N[C@@H](C)C(=O)O");
+  const AtomIndex stereocenter = 1;
+
+  auto fetchAssignment = [&](const Molecule& molecule) -> boost::optional<unsigned> {
+    const auto permutatorOption = molecule.stereopermutators().option(stereocenter);
+    if(!permutatorOption) {
+      return boost::none;
+    }
+    return permutatorOption->assigned();
+  };
+
+  const auto expectedAssignment = fetchAssignment(alanine);
+  BOOST_REQUIRE(expectedAssignment);
+
+  const auto referenceResult = generateConformation(alanine, 1010);
+  BOOST_REQUIRE_MESSAGE(referenceResult, "Could not generate a reference conformer for alanine");
+  const Utils::PositionCollection& reference = referenceResult.value();
+
+  const std::vector<std::vector<AtomIndex>> fixedAtomSets {{stereocenter}, {0, stereocenter}};
+  for(const auto& fixedAtoms : fixedAtomSets) {
+    DistanceGeometry::Configuration config;
+    for(const AtomIndex i : fixedAtoms) {
+      config.fixedPositions.emplace_back(i, reference.row(i));
+    }
+    config.freezeFixedPositions = true;
+
+    const auto ensemble = generateEnsemble(alanine, 8, 2020, config);
+    for(const auto& conformerResult : ensemble) {
+      BOOST_REQUIRE_MESSAGE(
+        conformerResult,
+        "Could not generate an alanine conformer with " << fixedAtoms.size()
+        << " frozen atoms: " << conformerResult.error().message()
+      );
+
+      const Molecule reinterpreted {
+        alanine.graph(),
+        AngstromPositions {conformerResult.value()}
+      };
+      BOOST_CHECK_EQUAL(fetchAssignment(reinterpreted), expectedAssignment);
+    }
+  }
+}
@@ -540,8 +540,11 @@ BOOST_AUTO_TEST_CASE(GraphShortestDistancesCorrectness, *boost::unit_test::label
 
     const auto boundsList = spatialModel.makePairwiseBounds();
 
-    DistanceGeometry::ExplicitBoundsGraph explicitGraph {sampleMol.graph().inner(), boundsList};
-    DistanceGeometry::DistanceBoundsMatrix spatialModelBounds {sampleMol.graph().inner(), boundsList};
+    const Eigen::MatrixXd denseBounds = boundsList.toMatrix();
+
+    // Shortest paths algorithms are applied to the fully explicit BGL graph
+    DistanceGeometry::ExplicitBoundsGraph explicitGraph {sampleMol.graph().inner(), denseBounds};
+    DistanceGeometry::DistanceBoundsMatrix spatialModelBounds {sampleMol.graph().inner(), denseBounds};
 
     // This conforms to the triangle inequality bounds
     auto boundsMatrix = DBM_FW_Functor {spatialModelBounds} ();
@@ -564,7 +567,7 @@ BOOST_AUTO_TEST_CASE(GraphShortestDistancesCorrectness, *boost::unit_test::label
      * perhaps direct access to the emerging distance matrix is necessary to
      * ensure O(1) bounds access!
      */
-    DistanceGeometry::ImplicitBoundsGraph implicitGraph {sampleMol.graph().inner(), boundsList};
+    DistanceGeometry::ImplicitBoundsGraph implicitGraph {sampleMol.graph().inner(), denseBounds};
 
     BOOST_REQUIRE_MESSAGE(
       graphsIdentical(explicitGraph, implicitGraph),
@@ -67,7 +67,7 @@ BOOST_AUTO_TEST_CASE(ImplicitBoundsGraphStructure, *boost::unit_test::label("DG"
 
     IG ig {
       molecule.graph().inner(),
-      spatialModel.makePairwiseBounds()
+      spatialModel.makePairwiseBounds().toMatrix()
     };
 
     IG::VertexDescriptor N = boost::num_vertices(ig);
@@ -182,7 +182,7 @@ BOOST_AUTO_TEST_CASE(MetricMatrixConstructionIsInvariantUnderOrderingSwap, *boos
 
     DistanceBoundsMatrix distanceBounds {
       molecule.graph().inner(),
-      DgData.bounds
+      DgData.bounds.toMatrix()
     };
 
     // choose a random reordering
@@ -63,7 +63,7 @@ struct RefinementBaseData {
 
     distanceBounds = DistanceBoundsMatrix {
       molecule.graph().inner(),
-      DgInfo.bounds
+      DgInfo.bounds.toMatrix()
     };
 
     chiralConstraints = std::move(DgInfo.chiralConstraints);
@@ -607,3 +607,95 @@ BOOST_AUTO_TEST_CASE(RefinementProblemEquivalence, *boost::unit_test::label("DG"
     "Not all refinement template argument of float variations match pair-wise!"
   );
 }
+
+BOOST_AUTO_TEST_CASE(RefinementProblemParallelChunks, *boost::unit_test::label("DG")) {
+  using RefinementType = EigenRefinementProblem<4, double, false>;
+  using VectorType = typename RefinementType::VectorType;
+
+  for(
+    const boost::filesystem::path& currentFilePath :
+    boost::filesystem::recursive_directory_iterator("ez_stereocenters")
+  ) {
+    RefinementBaseData baseData {currentFilePath.string()};
+    RefinementType functor {
+      baseData.squaredBounds(),
+      baseData.chiralConstraints,
+      baseData.dihedralConstraints
+    };
+    functor.dihedralTerms = true;
+
+    const VectorType positions = baseData.linearizeEmbeddedPositions();
+
+    double serialValue = 0;
+    VectorType serialGradient(positions.size());
+    functor(positions, serialValue, serialGradient);
+
+    for(unsigned chunks : {2u, 3u, 64u}) {
+      functor.parallelChunks = chunks;
+      double chunkedValue = 0;
+      VectorType chunkedGradient(positions.size());
+      functor(positions, chunkedValue, chunkedGradient);
+
+      BOOST_CHECK_MESSAGE(
+        Temple::Floating::isCloseRelative(serialValue, chunkedValue, 1e-10)
+        && chunkedGradient.isApprox(serialGradient, 1e-10),
+        "Serial and " << chunks << "-chunk refinement function evaluations "
+        << "do not match for " << currentFilePath.string()
+      );
+
+      // Reused task accumulators do not carry over between evaluations
+      double repeatedValue = 0;
+      VectorType repeatedGradient(positions.size());
+      functor(positions, repeatedValue, repeatedGradient);
+      BOOST_CHECK(repeatedValue == chunkedValue && repeatedGradient == chunkedGradient);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(RefinementProblemFixedAtoms, *boost::unit_test::label("DG")) {
+  using RefinementType = EigenRefinementProblem<4, double, false>;
+  using VectorType = typename RefinementType::VectorType;
+
+  for(
+    const boost::filesystem::path& currentFilePath :
+    boost::filesystem::recursive_directory_iterator("ez_stereocenters")
+  ) {
+    RefinementBaseData baseData {currentFilePath.string()};
+    RefinementType functor {
+      baseData.squaredBounds(),
+      baseData.chiralConstraints,
+      baseData.dihedralConstraints
+    };
+    functor.dihedralTerms = true;
+    functor.compressFourthDimension = true;
+
+    const VectorType positions = baseData.linearizeEmbeddedPositions();
+
+    double fullValue = 0;
+    VectorType fullGradient(positions.size());
+    functor(positions, fullValue, fullGradient);
+
+    // Fix every other atom
+    std::vector<AtomIndex> fixedAtoms;
+    const unsigned N = positions.size() / 4;
+    for(AtomIndex i = 0; i < N; i += 2) {
+      fixedAtoms.push_back(i);
+    }
+    functor.fixAtoms(fixedAtoms, positions);
+
+    const VectorType parameters = functor.reduce(positions);
+    BOOST_REQUIRE_EQUAL(parameters.size(), 4 * (N - fixedAtoms.size()));
+    BOOST_CHECK(functor.expand(parameters) == positions);
+
+    double reducedValue = 0;
+    VectorType reducedGradient(parameters.size());
+    functor(parameters, reducedValue, reducedGradient);
+
+    BOOST_CHECK_MESSAGE(
+      Temple::Floating::isCloseRelative(fullValue, reducedValue, 1e-10)
+      && reducedGradient.isApprox(functor.reduce(fullGradient), 1e-10),
+      "Refinement function evaluation with fixed atoms does not match the "
+      "free atoms' part of the full evaluation for " << currentFilePath.string()
+    );
+  }
+}
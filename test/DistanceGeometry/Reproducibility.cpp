@@ -123,3 +123,28 @@ BOOST_AUTO_TEST_CASE(ReproducibleEnsembles, *boost::unit_test::label("DG")) {
     "Not all conformers could be matched between two re-seeded ensemble generations"
   );
 }
+
+BOOST_AUTO_TEST_CASE(ReproducibleAbortedRefinementRetries, *boost::unit_test::label("DG")) {
+  const unsigned seed = 6564;
+  auto& prng = randomnessEngine();
+
+  DistanceGeometry::Configuration configuration;
+  configuration.abortStagnantRefinement = true;
+
+  Molecule mol = IO::read("stereocenter_detection_molecules/RSs-halogenated-propane.mol");
+  prng.seed(seed);
+  const auto a = generateRandomConformation(mol, configuration);
+  prng.seed(seed);
+  const auto b = generateRandomConformation(mol, configuration);
+
+  BOOST_REQUIRE_MESSAGE(
+    a.has_value() && b.has_value(),
+    "Molecule generation with aborting of stagnant refinements failed to yield two conformers for RSs-halogenated-propane"
+  );
+
+  BOOST_CHECK_MESSAGE(
+    a.value().isApprox(b.value(), 1e-3),
+    "Retrying aborted refinements does not preserve reproducibility."
+    << " Difference norm is " << (a.value() - b.value()).norm()
+  );
+}
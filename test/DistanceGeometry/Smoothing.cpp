@@ -9,6 +9,9 @@
 #include "Molassembler/DistanceGeometry/DistanceBoundsMatrix.h"
 #include "Molassembler/DistanceGeometry/TetrangleSmoothing.h"
 
+#include <algorithm>
+#include <random>
+
 using namespace Scine::Molassembler;
 using namespace DistanceGeometry;
 
@@ -36,6 +39,64 @@ BOOST_AUTO_TEST_CASE(TriangleSmoothingFloydExplicit, *boost::unit_test::label("D
   );
 }
 
+BOOST_AUTO_TEST_CASE(TriangleSmoothingBlocked, *boost::unit_test::label("DG")) {
+  /* Compare against a textbook Floyd smoothing for sizes spanning several
+   * tiles of the blocked implementation
+   */
+  auto textbookSmooth = [](Eigen::MatrixXd& matrix) {
+    const unsigned N = matrix.cols();
+    for(unsigned k = 0; k < N; ++k) {
+      for(unsigned i = 0; i < N; ++i) {
+        for(unsigned j = i + 1; j < N; ++j) {
+          if(i == k || j == k) {
+            continue;
+          }
+
+          const double upperIK = DistanceBoundsMatrix::upperBound(matrix, i, k);
+          const double lowerIK = DistanceBoundsMatrix::lowerBound(matrix, i, k);
+          const double upperJK = DistanceBoundsMatrix::upperBound(matrix, j, k);
+          const double lowerJK = DistanceBoundsMatrix::lowerBound(matrix, j, k);
+
+          matrix(i, j) = std::min(matrix(i, j), upperIK + upperJK);
+          matrix(j, i) = std::max({matrix(j, i), lowerIK - upperJK, lowerJK - upperIK});
+        }
+      }
+    }
+  };
+
+  std::mt19937 prng {42};
+  std::uniform_real_distribution<double> coordinate {0.0, 10.0};
+  for(const unsigned N : {3u, 64u, 65u, 150u}) {
+    Eigen::Matrix3Xd positions(3, N);
+    for(unsigned i = 0; i < N; ++i) {
+      positions.col(i) << coordinate(prng), coordinate(prng), coordinate(prng);
+    }
+
+    // Tight bounds for near neighbors, loose bounds otherwise
+    Eigen::MatrixXd bounds = Eigen::MatrixXd::Zero(N, N);
+    for(unsigned i = 0; i < N; ++i) {
+      for(unsigned j = i + 1; j < N; ++j) {
+        const double distance = (positions.col(i) - positions.col(j)).norm();
+        if(j - i <= 3) {
+          bounds(i, j) = 1.1 * distance;
+          bounds(j, i) = 0.9 * distance;
+        } else {
+          bounds(i, j) = DistanceBoundsMatrix::defaultUpper;
+          bounds(j, i) = 0.5;
+        }
+      }
+    }
+
+    Eigen::MatrixXd expected = bounds;
+    textbookSmooth(expected);
+    DistanceBoundsMatrix::smooth(bounds);
+    BOOST_CHECK_MESSAGE(
+      bounds.isApprox(expected, 1e-10),
+      "Blocked triangle smoothing deviates from textbook smoothing for N = " << N
+    );
+  }
+}
+
 BOOST_AUTO_TEST_CASE(TetrangleSmoothingExplicit, *boost::unit_test::label("DG")) {
   Eigen::Matrix4d input;
   input <<   0.0,   1.0, 100.0,   1.0,
@@ -0,0 +1,105 @@
+/*!@file
+ * @copyright This code is licensed under the 3-clause BSD license.
+ *   Copyright ETH Zurich, Laboratory of Physical Chemistry, Reiher Group.
+ *   See LICENSE.txt for details.
+ */
+
+#include "boost/test/unit_test.hpp"
+
+#include "Molassembler/DistanceGeometry/ConformerGeneration.h"
+#include "Molassembler/DistanceGeometry/RefinementMeta.h"
+
+using namespace Scine::Molassembler;
+using namespace DistanceGeometry;
+
+BOOST_AUTO_TEST_CASE(StagnationMonitorWindows, *boost::unit_test::label("DG")) {
+  StagnationMonitor monitor;
+  monitor.window = 2;
+  monitor.patience = 2;
+  monitor.relativeImprovement = 0.1;
+
+  // Nothing is evaluated at iteration zero or within a window
+  monitor.observe(0, 10.0, 10.0);
+  monitor.observe(1, 10.0, 10.0);
+  BOOST_CHECK(!monitor.doomed);
+
+  // The first window always improves over the initial state
+  monitor.observe(2, 10.0, 10.0);
+  BOOST_CHECK(!monitor.doomed);
+
+  // Improvements below the relative threshold are stagnant
+  monitor.observe(3, 9.5, 9.5);
+  monitor.observe(4, 9.5, 9.5);
+  BOOST_CHECK(!monitor.doomed);
+  monitor.observe(5, 9.0, 9.0);
+  monitor.observe(6, 9.0, 9.0);
+  BOOST_CHECK_MESSAGE(monitor.doomed, "Two stagnant windows do not doom the refinement");
+
+  // A sufficient improvement of the gradient norm alone resets the patience
+  monitor.observe(7, 9.0, 1.0);
+  monitor.observe(8, 9.0, 1.0);
+  BOOST_CHECK(!monitor.doomed);
+
+  // As does any improvement of the proportion of correct chiral constraints
+  monitor.observe(10, 9.0, 1.0);
+  monitor.observe(12, 9.0, 1.0, 0.5);
+  BOOST_CHECK(!monitor.doomed);
+  monitor.observe(14, 9.0, 1.0, 0.5);
+  monitor.observe(16, 9.0, 1.0, 0.5);
+  BOOST_CHECK(monitor.doomed);
+
+  // Worse values do not count as improvements
+  StagnationMonitor worsening;
+  worsening.window = 1;
+  worsening.patience = 1;
+  worsening.observe(1, 1.0, 1.0);
+  BOOST_CHECK(!worsening.doomed);
+  worsening.observe(2, 2.0, 2.0);
+  BOOST_CHECK(worsening.doomed);
+}
+
+BOOST_AUTO_TEST_CASE(AbortedRefinementRetries, *boost::unit_test::label("DG")) {
+  using ResultType = outcome::result<AngstromPositions>;
+
+  // Generation succeeding after a number of aborted refinements
+  auto generator = [](const unsigned aborts, unsigned& calls) {
+    return [aborts, &calls]() -> ResultType {
+      ++calls;
+      if(calls <= aborts) {
+        return DgError::RefinementAborted;
+      }
+      return AngstromPositions {2};
+    };
+  };
+
+  unsigned calls = 0;
+  auto result = retryAbortedRefinements(3, generator(2, calls));
+  BOOST_CHECK(result);
+  BOOST_CHECK_EQUAL(calls, 3u);
+
+  // Retries are limited
+  calls = 0;
+  result = retryAbortedRefinements(3, generator(10, calls));
+  BOOST_REQUIRE(!result);
+  BOOST_CHECK(result.error() == DgError::RefinementAborted);
+  BOOST_CHECK_EQUAL(calls, 4u);
+
+  // Without retries, generation runs once
+  calls = 0;
+  result = retryAbortedRefinements(0, generator(1, calls));
+  BOOST_CHECK(!result);
+  BOOST_CHECK_EQUAL(calls, 1u);
+
+  // Other failures are not retried
+  calls = 0;
+  result = retryAbortedRefinements(
+    3,
+    [&calls]() -> ResultType {
+      ++calls;
+      return DgError::RefinedChiralsWrong;
+    }
+  );
+  BOOST_REQUIRE(!result);
+  BOOST_CHECK(result.error() == DgError::RefinedChiralsWrong);
+  BOOST_CHECK_EQUAL(calls, 1u);
+}
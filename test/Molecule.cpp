@@ -22,6 +22,7 @@
 #include "Molassembler/Temple/Optionals.h"
 
 #include "Molassembler/Graph.h"
+#include "Molassembler/Graph/Canonicalization.h"
 #include "Molassembler/Graph/PrivateGraph.h"
 #include "Molassembler/IO.h"
 #include "Molassembler/IO/SmilesParser.h"
@@ -247,6 +248,47 @@ BOOST_AUTO_TEST_CASE(AtomEnvironmentHashesDoNotCollide, *boost::unit_test::label
   }
 }
 
+// Hashes from contiguous graph snapshots match hashes from gathered bonds
+BOOST_AUTO_TEST_CASE(AtomEnvironmentHashesFromSnapshot, *boost::unit_test::label("Molassembler")) {
+  // Bond hashes of more than ten bonds cross a word boundary of the wide hash
+  const Hashes::WideHashType crossing = Hashes::WideHashType {}.addBits(0x3f, 62);
+  BOOST_CHECK_EQUAL(crossing.low, 0xc000000000000000ull);
+  BOOST_CHECK_EQUAL(crossing.high, 0xfull);
+  BOOST_CHECK(Hashes::WideHashType(1) < crossing);
+
+  // Overlapping fields are summed and carry into the most significant word
+  const Hashes::WideHashType carried = Hashes::WideHashType {}
+    .addBits(0x3f, 62)
+    .addBits(0x1, 62);
+  BOOST_CHECK_EQUAL(carried.low, 0ull);
+  BOOST_CHECK_EQUAL(carried.high, 0x10ull);
+
+  for(const std::string filename : {"ez_stereocenters/but-2E-ene.mol", "inorganics/haptic/05.mol"}) {
+    const Molecule molecule = IO::read(filename);
+    const auto& inner = molecule.graph().inner();
+    const auto hashes = Hashes::generate(inner, molecule.stereopermutators(), AtomEnvironmentComponents::All);
+    for(const AtomIndex i : molecule.graph().atoms()) {
+      boost::optional<Shapes::Shape> shapeOption;
+      boost::optional<unsigned> assignmentOption;
+      if(auto permutatorOption = molecule.stereopermutators().option(i)) {
+        shapeOption = permutatorOption->getShape();
+        assignmentOption = permutatorOption->assigned();
+      }
+
+      BOOST_CHECK_EQUAL(
+        hashes.at(i),
+        Hashes::hash(
+          AtomEnvironmentComponents::All,
+          molecule.graph().elementType(i),
+          Hashes::gatherBonds(inner, molecule.stereopermutators(), AtomEnvironmentComponents::All, i),
+          shapeOption,
+          assignmentOption
+        )
+      );
+    }
+  }
+}
+
 /* Hashes, stereopermutator lists and graphs are identical across two molecules
  * generated by applying a random permutation to the intermediate data (atoms
  * and BOs) and applying the same permutation via .applyPermutation(perm)
@@ -392,6 +434,46 @@ BOOST_AUTO_TEST_CASE(MoleculeCanonicalization, *boost::unit_test::label("Molasse
   }
 }
 
+// Batch canonicalization yields the same results as individual calls
+BOOST_AUTO_TEST_CASE(MoleculeBatchCanonicalization, *boost::unit_test::label("Molassembler")) {
+  boost::filesystem::path directoryBase("isomorphisms");
+
+  std::vector<Molecule> molecules;
+  for(
+    const boost::filesystem::path& currentFilePath :
+    boost::filesystem::recursive_directory_iterator(directoryBase)
+  ) {
+    if(currentFilePath.extension() != ".mol") {
+      continue;
+    }
+
+    Molecule a;
+    Molecule b;
+    std::tie(a, b, std::ignore) = readIsomorphism(currentFilePath);
+    molecules.push_back(std::move(a));
+    molecules.push_back(std::move(b));
+  }
+
+  std::vector<Molecule> individually = molecules;
+  std::vector<std::vector<AtomIndex>> individualPermutations;
+  for(Molecule& molecule : individually) {
+    individualPermutations.push_back(molecule.canonicalize());
+  }
+
+  const auto batchPermutations = Molecule::canonicalize(molecules);
+  BOOST_REQUIRE_EQUAL(batchPermutations.size(), molecules.size());
+  for(unsigned i = 0; i < molecules.size(); ++i) {
+    BOOST_CHECK(batchPermutations.at(i) == individualPermutations.at(i));
+    BOOST_CHECK(molecules.at(i).canonicalComponents() == AtomEnvironmentComponents::All);
+    BOOST_CHECK(molecules.at(i).graph().inner().identicalGraph(individually.at(i).graph().inner()));
+  }
+
+  // Pairs of isomorphic molecules are identical after canonicalization
+  for(unsigned i = 0; i + 1 < molecules.size(); i += 2) {
+    BOOST_CHECK(molecules.at(i).canonicalCompare(molecules.at(i + 1)));
+  }
+}
+
 BOOST_AUTO_TEST_CASE(MoleculeHashes, *boost::unit_test::label("Molassembler")) {
   boost::filesystem::path directoryBase("isomorphisms");
 
@@ -618,6 +700,133 @@ BOOST_AUTO_TEST_CASE(PropagateGraphChangeTests, *boost::unit_test::label("Molass
   );
 }
 
+BOOST_AUTO_TEST_CASE(MoleculeDeferredStereopermutators, *boost::unit_test::label("Molassembler")) {
+  const Molecule reference = IO::Experimental::parseSmilesSingleMolecule("CC(O)C=CC(N)Cl");
+  const Molecule::DeferStereopermutatorsTag defer {};
+
+  // Detection on first access yields the same stereopermutators
+  const Molecule deferred {reference.graph(), defer};
+  BOOST_CHECK(deferred.stereopermutators() == Molecule {reference.graph()}.stereopermutators());
+
+  // Graph-only canonicalization need not detect stereopermutators
+  using C = AtomEnvironmentComponents;
+  const C graphComponents = C::ElementTypes | C::BondOrders;
+  Molecule a {reference.graph(), defer};
+  a.canonicalize(graphComponents);
+  Molecule b {reference.graph()};
+  b.canonicalize(graphComponents);
+  BOOST_CHECK_EQUAL(a.hash(), b.hash());
+  BOOST_CHECK(a.graph().inner().identicalGraph(b.graph().inner()));
+  BOOST_CHECK(a.stereopermutators() == b.stereopermutators());
+
+  // Graph edits before detection are equivalent to edits after detection
+  Molecule c {reference.graph(), defer};
+  c.addAtom(Utils::ElementType::Br, 0);
+  Molecule d {reference.graph()};
+  d.addAtom(Utils::ElementType::Br, 0);
+  BOOST_CHECK(c.stereopermutators() == d.stereopermutators());
+  BOOST_CHECK(c == d);
+}
+
+BOOST_AUTO_TEST_CASE(MoleculeEditTransactions, *boost::unit_test::label("Molassembler")) {
+  Molecule reference = IO::Experimental::parseSmilesSingleMolecule("CC(O)C=CC(N)Cl");
+  std::vector<AtomIndex> stereocenters;
+  for(const auto& permutator : reference.stereopermutators().atomStereopermutators()) {
+    if(permutator.numAssignments() > 1) {
+      stereocenters.push_back(permutator.placement());
+    }
+  }
+  for(const AtomIndex i : stereocenters) {
+    if(reference.stereopermutators().option(i)) {
+      reference.assignStereopermutator(i, 0);
+    }
+  }
+
+  // Includes a change of two sites at the oxygen atom
+  auto edit = [](Molecule& molecule) {
+    const AtomIndex carbon = molecule.addAtom(Utils::ElementType::C, 2);
+    molecule.addAtom(Utils::ElementType::C, 2);
+    molecule.addAtom(Utils::ElementType::Br, carbon);
+    molecule.setElementType(6, Utils::ElementType::P);
+    molecule.setBondType(3, 4, BondType::Single);
+  };
+
+  Molecule sequential = reference;
+  edit(sequential);
+
+  Molecule batched = reference;
+  batched.beginEdit();
+  batched.beginEdit();
+  edit(batched);
+  batched.commitEdit();
+  batched.commitEdit();
+
+  BOOST_CHECK(batched.stereopermutators() == sequential.stereopermutators());
+  BOOST_CHECK(batched == sequential);
+  BOOST_CHECK_THROW(batched.commitEdit(), std::logic_error);
+
+  // Guards close their transaction even if an edit throws
+  Molecule guarded = reference;
+  try {
+    Molecule::EditGuard guard {guarded};
+    edit(guarded);
+    guarded.addAtom(Utils::ElementType::H, guarded.graph().N());
+  } catch(const std::out_of_range& /* e */) {}
+  BOOST_CHECK_THROW(guarded.commitEdit(), std::logic_error);
+  BOOST_CHECK(guarded == sequential);
+
+  // Element type changes can form haptic sites at the edited atom
+  const Molecule cyclopropene = IO::Experimental::parseSmilesSingleMolecule("C1=CC1");
+  Molecule metalated = cyclopropene;
+  metalated.setElementType(2, Utils::ElementType::Fe);
+  Molecule guardedMetalated = cyclopropene;
+  {
+    Molecule::EditGuard guard {guardedMetalated};
+    guardedMetalated.setElementType(2, Utils::ElementType::Fe);
+    guard.commit();
+    BOOST_CHECK_THROW(guard.commit(), std::logic_error);
+  }
+  BOOST_CHECK(guardedMetalated.stereopermutators() == metalated.stereopermutators());
+  BOOST_CHECK(guardedMetalated == metalated);
+}
+
+BOOST_AUTO_TEST_CASE(MoleculeCopyOnWrite, *boost::unit_test::label("Molassembler")) {
+  const Molecule original = IO::Experimental::parseSmilesSingleMolecule("CC(O)C=CC(N)Cl");
+  BOOST_REQUIRE(original.stereopermutators().option(1));
+
+  // Copies share the graph and stereopermutator cores
+  Molecule copy = original;
+  BOOST_CHECK(copy.graph().inner().sharesStorage(original.graph().inner()));
+  BOOST_CHECK(
+    &copy.stereopermutators().option(1)->getFeasible()
+    == &original.stereopermutators().option(1)->getFeasible()
+  );
+
+  // Edits to the copy leave the original untouched
+  copy.setElementType(7, Utils::ElementType::Br);
+  BOOST_CHECK(!copy.graph().inner().sharesStorage(original.graph().inner()));
+  BOOST_CHECK(original.graph().elementType(7) == Utils::ElementType::Cl);
+  BOOST_CHECK(copy != original);
+
+  // Assigning a copy's stereopermutator leaves the original's unchanged
+  Molecule assigned = original;
+  const auto originalAssignment = original.stereopermutators().option(1)->assigned();
+  BOOST_REQUIRE(original.stereopermutators().option(1)->numAssignments() > 1);
+  const unsigned newAssignment = (originalAssignment.value_or(0) + 1)
+    % original.stereopermutators().option(1)->numAssignments();
+  assigned.assignStereopermutator(1, newAssignment);
+  BOOST_CHECK(assigned.stereopermutators().option(1)->assigned() == newAssignment);
+  BOOST_CHECK(original.stereopermutators().option(1)->assigned() == originalAssignment);
+
+  // References taken before copying a list do not alias the copy
+  StereopermutatorList list = original.stereopermutators();
+  AtomStereopermutator& permutator = list.option(1).value();
+  const StereopermutatorList listCopy = list;
+  permutator.assign(newAssignment);
+  BOOST_CHECK(list.option(1)->assigned() == newAssignment);
+  BOOST_CHECK(listCopy.option(1)->assigned() == originalAssignment);
+}
+
 BOOST_AUTO_TEST_CASE(MoleculeSplitRecognition, *boost::unit_test::label("Molassembler")) {
   std::vector<Molecule> molSplat;
   std::vector<Molecule> xyzSplat;
@@ -824,3 +1033,89 @@ BOOST_AUTO_TEST_CASE(ShapeClassification, *boost::unit_test::label("Molassembler
   auto trigbipy = IO::read("shape_classification/trig_bipy.mol");
   checkAtomStereopermutator(trigbipy, 0, Shapes::Shape::TrigonalBipyramid);
 }
+
+BOOST_AUTO_TEST_CASE(SymmetryEquivalentStereopermutators, *boost::unit_test::label("Molassembler")) {
+  std::vector<Molecule> molecules {
+    IO::Experimental::parseSmilesSingleMolecule("CC(C)(C)C"),
+    IO::Experimental::parseSmilesSingleMolecule("C1CCCCC1"),
+    IO::Experimental::parseSmilesSingleMolecule("C1=CC=CC=C1"),
+    IO::Experimental::parseSmilesSingleMolecule("[Fe](Cl)(Cl)(Cl)(Cl)(Cl)Cl")
+  };
+  for(const std::string filename : {"inorganics/haptic/05.mol", "inorganics/haptic/10.mol"}) {
+    // Construct from the graph alone, not from positions
+    molecules.emplace_back(IO::read(filename).graph());
+  }
+
+  for(const Molecule& molecule : molecules) {
+    const PrivateGraph& inner = molecule.graph().inner();
+    const auto generators = automorphismGenerators(
+      inner,
+      Hashes::generate(
+        inner,
+        boost::none,
+        AtomEnvironmentComponents::ElementTypes | AtomEnvironmentComponents::BondOrders
+      )
+    );
+    const AutomorphismOrbits orbits {inner.N(), generators};
+    BOOST_CHECK_LE(orbits.size(), inner.N());
+
+    // Generators preserve bond types
+    for(const auto& generator : generators) {
+      for(const auto& edge : inner.edges()) {
+        const auto a = inner.source(edge);
+        const auto b = inner.target(edge);
+        BOOST_CHECK(
+          inner.bondType(inner.edge(generator.at(a), generator.at(b)))
+          == inner.bondType(edge)
+        );
+      }
+    }
+
+    for(const AtomIndex i : molecule.graph().atoms()) {
+      BOOST_CHECK_EQUAL(orbits.automorphism(i).at(orbits.representative(i)), i);
+
+      // Transferred stereopermutators match directly calculated rankings
+      const auto permutatorOption = molecule.stereopermutators().option(i);
+      if(!permutatorOption) {
+        continue;
+      }
+
+      const RankingInformation direct = molecule.rankPriority(i);
+      const RankingInformation& transferred = permutatorOption->getRanking();
+      BOOST_CHECK(direct.sites == transferred.sites);
+      BOOST_CHECK(direct.substituentRanking == transferred.substituentRanking);
+      BOOST_CHECK(direct == transferred);
+
+      const auto representativeOption = molecule.stereopermutators().option(
+        orbits.representative(i)
+      );
+      BOOST_REQUIRE(representativeOption);
+      BOOST_CHECK(representativeOption->getShape() == permutatorOption->getShape());
+      BOOST_CHECK_EQUAL(
+        representativeOption->numAssignments(),
+        permutatorOption->numAssignments()
+      );
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TrivialAutomorphismGroups, *boost::unit_test::label("Molassembler")) {
+  auto generators = [](const std::string& smiles) {
+    const Molecule molecule = IO::Experimental::parseSmilesSingleMolecule(smiles);
+    const PrivateGraph& inner = molecule.graph().inner();
+    return automorphismGenerators(
+      inner,
+      Hashes::generate(
+        inner,
+        boost::none,
+        AtomEnvironmentComponents::ElementTypes | AtomEnvironmentComponents::BondOrders
+      )
+    );
+  };
+
+  // Asymmetric graphs have only the identity, which is not a generator
+  BOOST_CHECK(generators("FC(Cl)(Br)I").empty());
+  // Symmetric graphs still have non-trivial automorphisms
+  BOOST_CHECK(!generators("C1CCCCC1").empty());
+  BOOST_CHECK(!generators("FC(Cl)(F)Br").empty());
+}
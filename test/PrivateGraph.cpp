@@ -7,6 +7,8 @@
 #include <boost/test/unit_test.hpp>
 
 #include "Molassembler/Graph/PrivateGraph.h"
+#include "Molassembler/Cycles.h"
+#include "Molassembler/Graph/GraphAlgorithms.h"
 
 #include "Molassembler/Temple/Functional.h"
 
@@ -14,6 +16,8 @@
 #include "Molassembler/Molecule.h"
 #include "Molassembler/Graph.h"
 
+#include <numeric>
+
 using namespace Scine;
 using namespace Molassembler;
 
@@ -79,3 +83,166 @@ BOOST_AUTO_TEST_CASE(BridgeEdges, *boost::unit_test::label("Molassembler")) {
   BOOST_CHECK(e.graph().adjacent(0, 1));
   BOOST_CHECK(!e.graph().canRemove(BondIndex {0, 1}));
 }
+
+BOOST_AUTO_TEST_CASE(IncrementalCachedProperties, *boost::unit_test::label("Molassembler")) {
+  auto freshSafetyData = [](const PrivateGraph& graph) {
+    PrivateGraph copy = graph;
+    // Non-const access to the underlying graph discards all cached data
+    copy.bgl();
+    return copy.removalSafetyData();
+  };
+
+  auto checkRemovalSafety = [&](const PrivateGraph& graph) {
+    const auto& cached = graph.removalSafetyData();
+    const auto fresh = freshSafetyData(graph);
+    BOOST_CHECK(cached.articulationVertices == fresh.articulationVertices);
+    BOOST_CHECK(cached.blockCounts == fresh.blockCounts);
+    BOOST_CHECK_EQUAL(cached.bridges.size(), fresh.bridges.size());
+    for(const auto& bridge : cached.bridges) {
+      BOOST_CHECK(!graph.canRemove(bridge));
+    }
+  };
+
+  // Cyclopropane with a methyl substituent
+  auto molecule = IO::Experimental::parseSmilesSingleMolecule("CC1CC1");
+  PrivateGraph graph = molecule.graph().inner();
+  checkRemovalSafety(graph);
+  BOOST_CHECK_EQUAL(graph.cycles().numCycleFamilies(), 1);
+
+  // Adding a vertex and a bridge to it keeps cached data consistent
+  const auto newVertex = graph.addVertex(Utils::ElementType::Cl);
+  const auto bridge = graph.addEdge(1, newVertex, BondType::Single);
+  checkRemovalSafety(graph);
+  BOOST_CHECK(!graph.canRemove(bridge));
+  BOOST_CHECK_EQUAL(graph.cycles().numCycleFamilies(newVertex), 0);
+  BOOST_CHECK_EQUAL(graph.cycles().numCycleFamilies(1), 1);
+
+  // Removing the bridge again
+  graph.removeEdge(bridge);
+  checkRemovalSafety(graph);
+
+  // Permutations remap removal safety data and cycles
+  const RDL_data* const ringDecomposition = graph.cycles().dataPtr();
+  std::vector<PrivateGraph::Vertex> permutation(graph.N());
+  std::iota(std::rbegin(permutation), std::rend(permutation), 0);
+  graph.applyPermutation(permutation);
+  checkRemovalSafety(graph);
+  BOOST_CHECK(graph.cycles().dataPtr() == ringDecomposition);
+  BOOST_CHECK_EQUAL(graph.cycles().numCycleFamilies(permutation.at(1)), 1);
+  BOOST_CHECK_EQUAL(graph.cycles().numCycleFamilies(permutation.at(0)), 0);
+  BOOST_CHECK_EQUAL(graph.cycles().numCycleFamilies(permutation.at(newVertex)), 0);
+  for(const auto& cycleBonds : graph.cycles()) {
+    for(const BondIndex& bond : cycleBonds) {
+      BOOST_CHECK(graph.edgeOption(bond.first, bond.second));
+    }
+  }
+  for(const auto& cycleBonds : graph.cycles().containing(permutation.at(1))) {
+    BOOST_CHECK_EQUAL(cycleBonds.size(), 3);
+  }
+
+  // Bridges to disconnected vertices keep the permuted cycles
+  graph.addEdge(permutation.at(1), permutation.at(newVertex), BondType::Single);
+  checkRemovalSafety(graph);
+  BOOST_CHECK(graph.cycles().dataPtr() == ringDecomposition);
+
+  // Closing a cycle discards cached data
+  graph.addEdge(permutation.at(0), permutation.at(2), BondType::Single);
+  checkRemovalSafety(graph);
+  BOOST_CHECK_EQUAL(graph.cycles().numCycleFamilies(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(CompressedSparseRowSnapshot, *boost::unit_test::label("Molassembler")) {
+  auto molecule = IO::Experimental::parseSmilesSingleMolecule("OC(=O)C1CC1");
+  PrivateGraph graph = molecule.graph().inner();
+
+  auto checkSnapshot = [](const PrivateGraph& g) {
+    const CsrGraph& csr = g.csr();
+    BOOST_REQUIRE_EQUAL(csr.N(), g.N());
+    BOOST_CHECK_EQUAL(csr.B(), g.B());
+    for(const PrivateGraph::Vertex i : g.vertices()) {
+      BOOST_CHECK(csr.elementType(i) == g.elementType(i));
+      BOOST_REQUIRE_EQUAL(csr.degree(i), g.degree(i));
+      // Adjacencies are in the same order
+      BOOST_CHECK(
+        std::equal(
+          std::begin(csr.adjacents(i)),
+          std::end(csr.adjacents(i)),
+          std::begin(g.adjacents(i))
+        )
+      );
+      for(const PrivateGraph::Vertex j : g.adjacents(i)) {
+        BOOST_CHECK(csr.adjacent(i, j));
+        BOOST_CHECK(csr.bondType(i, j) == g.bondType(g.edge(i, j)));
+      }
+    }
+  };
+
+  checkSnapshot(graph);
+
+  // Modifications discard the snapshot
+  graph.bondType(graph.edge(1, 2)) = BondType::Single;
+  checkSnapshot(graph);
+  graph.elementType(0) = Utils::ElementType::S;
+  checkSnapshot(graph);
+  const auto newVertex = graph.addVertex(Utils::ElementType::Cl);
+  graph.addEdge(4, newVertex, BondType::Single);
+  checkSnapshot(graph);
+
+  const auto distances = GraphAlgorithms::distance(0, graph);
+  BOOST_CHECK_EQUAL(distances.at(0), 0);
+  BOOST_CHECK_EQUAL(distances.at(1), 1);
+  BOOST_CHECK_EQUAL(distances.at(3), 2);
+  BOOST_CHECK_EQUAL(distances.at(newVertex), 4);
+}
+
+BOOST_AUTO_TEST_CASE(CopyOnWriteGraph, *boost::unit_test::label("Molassembler")) {
+  auto molecule = IO::Experimental::parseSmilesSingleMolecule("CC1CC1");
+  const PrivateGraph original = molecule.graph().inner();
+  original.populateProperties();
+
+  // Copies share the graph and any cached properties
+  PrivateGraph copy = original;
+  BOOST_CHECK(copy.sharesStorage(original));
+  BOOST_CHECK(&copy.cycles() == &original.cycles());
+  BOOST_CHECK(&copy.removalSafetyData() == &original.removalSafetyData());
+
+  // Modifying a copy through an edge fetched before detaching
+  const PrivateGraph::Edge bridge = copy.edge(0, 1);
+  copy.bondType(bridge) = BondType::Double;
+  BOOST_CHECK(!copy.sharesStorage(original));
+  BOOST_CHECK(copy.bondType(copy.edge(0, 1)) == BondType::Double);
+  BOOST_CHECK(original.bondType(original.edge(0, 1)) == BondType::Single);
+
+  // Removal safety data is mapped onto the detached graph
+  BOOST_CHECK(!copy.canRemove(copy.edge(0, 1)));
+  BOOST_CHECK(copy.canRemove(copy.edge(1, 2)));
+  BOOST_CHECK(!original.canRemove(original.edge(0, 1)));
+
+  PrivateGraph other = original;
+  other.removeEdge(other.edge(1, 2));
+  BOOST_CHECK_EQUAL(other.B(), original.B() - 1);
+  BOOST_CHECK(original.edgeOption(1, 2));
+  BOOST_CHECK(!other.canRemove(other.edge(2, 3)));
+
+  // Const reads through edges fetched before detaching
+  PrivateGraph stale = original;
+  const PrivateGraph::Edge staleBridge = stale.edge(0, 1);
+  const PrivateGraph::Edge staleRingEdge = stale.edge(1, 2);
+  stale.bondType(stale.edge(1, 2)) = BondType::Double;
+  BOOST_CHECK(!stale.sharesStorage(original));
+  BOOST_CHECK(stale.bondType(staleRingEdge) == BondType::Double);
+  BOOST_CHECK(!stale.canRemove(staleBridge));
+  BOOST_CHECK(stale.canRemove(staleRingEdge));
+  const auto sides = stale.splitAlongBridge(staleBridge);
+  BOOST_CHECK_EQUAL(sides.first.size() + sides.second.size(), stale.N());
+  const auto onFirstSide = Temple::makeContainsPredicate(sides.first);
+  BOOST_CHECK(onFirstSide(0) != onFirstSide(1));
+
+  // Moved-from graphs are empty and remain usable
+  PrivateGraph moved = std::move(other);
+  BOOST_CHECK_EQUAL(moved.B(), original.B() - 1);
+  BOOST_CHECK_EQUAL(other.N(), 0u);
+  other.addVertex(Utils::ElementType::H);
+  BOOST_CHECK_EQUAL(other.N(), 1u);
+  BOOST_CHECK_EQUAL(PrivateGraph {}.N(), 0u);
+}
@@ -0,0 +1,40 @@
+/*!@file
+ * @copyright This code is licensed under the 3-clause BSD license.
+ *   Copyright ETH Zurich, Laboratory of Physical Chemistry, Reiher Group.
+ *   See LICENSE.txt for details.
+ */
+
+#include "boost/test/unit_test.hpp"
+
+#include "Molassembler/Profiling.h"
+
+using namespace Scine::Molassembler;
+
+BOOST_AUTO_TEST_CASE(ProfilingAggregation, *boost::unit_test::label("Molassembler")) {
+  Profiling::reset();
+  Profiling::recordTraceEvents = true;
+
+  const unsigned timerName = Profiling::Detail::registerName("TestTimer");
+  const unsigned counterName = Profiling::Detail::registerName("TestCounter");
+  BOOST_CHECK_EQUAL(Profiling::Detail::registerName("TestTimer"), timerName);
+
+  auto instrumented = [&]() {
+    const Profiling::Detail::ScopedTimer timer {timerName};
+    Profiling::Detail::count(counterName, 2);
+  };
+
+  instrumented();
+  instrumented();
+
+  const std::string json = Profiling::json();
+  BOOST_CHECK(json.find("\"TestTimer\":{\"calls\":2") != std::string::npos);
+  BOOST_CHECK(json.find("\"TestCounter\":4") != std::string::npos);
+
+  const std::string trace = Profiling::chromeTrace();
+  BOOST_CHECK(trace.find("\"name\":\"TestTimer\"") != std::string::npos);
+
+  Profiling::recordTraceEvents = false;
+  Profiling::reset();
+  BOOST_CHECK(Profiling::json().find("TestTimer") == std::string::npos);
+  BOOST_CHECK(Profiling::chromeTrace().find("TestTimer") == std::string::npos);
+}
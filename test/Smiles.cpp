@@ -117,6 +117,8 @@ BOOST_AUTO_TEST_CASE(AcceptValidSmiles, *boost::unit_test::label("Molassembler")
     "C1CCCCC1C1CCCCC1",
     "C12(CCCCC1)CCCCC2",
     "F/C(CC)=C/F",
+    "CC:C",
+    "C:1CCCCC=1",
   };
 
   std::vector<Molecule> results;
@@ -256,3 +258,68 @@ BOOST_AUTO_TEST_CASE(SmilesWithMultipleMolecules, *boost::unit_test::label("Mola
     );
   }
 }
+
+BOOST_AUTO_TEST_CASE(BulkSmilesParsing, *boost::unit_test::label("Molassembler")) {
+  const std::vector<std::string> validSmiles {
+    "[HH0]",
+    "CCO",
+    "[Rh-](Cl)(Cl)(Cl)(Cl)$[Rh-](Cl)(Cl)(Cl)Cl",
+    "OS(=O)(=S)O",
+    "C12(CCCCC1)CCCCC2",
+    "F/C(CC)=C/F",
+    "[NH4+].[NH4+].[O-]S(=O)(=O)[S-]",
+    "N[C@@H](C)C(=O)O",
+    "Br[Co@OH12](Cl)(I)(F)(S)C",
+    "C:1CCCCC=1"
+  };
+
+  const std::vector<std::string> invalidSmiles {
+    "[HH1]",
+    "C1CCC",
+    "CC(CC",
+    "CC)CC",
+    "[NH2+251]C",
+    "C.1CCCCC.1",
+    R"y(C/C(\F)=C/F)y"
+  };
+
+  // Interleave valid and invalid lines, with names, carriage returns and blanks
+  std::string lines;
+  for(const auto& smiles : validSmiles) {
+    lines += smiles + " name\r\n";
+  }
+  for(const auto& smiles : invalidSmiles) {
+    lines += smiles + "\n";
+  }
+  lines += "\n";
+
+  for(const bool defer : {false, true}) {
+    const auto results = IO::Experimental::parseSmilesLines(lines, defer);
+    BOOST_REQUIRE_EQUAL(results.size(), validSmiles.size() + invalidSmiles.size() + 1);
+
+    for(unsigned i = 0; i < validSmiles.size(); ++i) {
+      BOOST_CHECK_MESSAGE(
+        results.at(i).error.empty(),
+        "Unexpected error '" << results.at(i).error << "' for " << validSmiles.at(i)
+      );
+      const auto expected = IO::Experimental::parseSmiles(validSmiles.at(i));
+      BOOST_REQUIRE_EQUAL(results.at(i).molecules.size(), expected.size());
+      for(unsigned j = 0; j < expected.size(); ++j) {
+        BOOST_CHECK_MESSAGE(
+          results.at(i).molecules.at(j) == expected.at(j),
+          "Bulk parse of " << validSmiles.at(i) << " differs from regular parse"
+        );
+      }
+    }
+
+    for(unsigned i = validSmiles.size(); i < results.size(); ++i) {
+      BOOST_CHECK(results.at(i).molecules.empty());
+      BOOST_CHECK(!results.at(i).error.empty());
+    }
+  }
+  // A final line without a newline is parsed too
+  const auto unterminated = IO::Experimental::parseSmilesLines("CCO\nCC");
+  BOOST_REQUIRE_EQUAL(unterminated.size(), 2u);
+  BOOST_CHECK(unterminated.back().error.empty());
+  BOOST_CHECK_EQUAL(unterminated.back().molecules.size(), 1u);
+}
@@ -7,11 +7,13 @@
 #include <boost/test/unit_test.hpp>
 
 #include "Molassembler/Subgraphs.h"
+#include "Molassembler/Graph.h"
 #include "Molassembler/Molecule.h"
 #include "Molassembler/IO.h"
 #include "Molassembler/IO/SmilesParser.h"
 
 #include <iostream>
+#include <map>
 #include "Molassembler/Temple/Stringify.h"
 
 using namespace Scine;
@@ -50,3 +52,173 @@ BOOST_AUTO_TEST_CASE(SubgraphOligopeptide, *boost::unit_test::label("Molassemble
   // Arguments are not symmetric!
   BOOST_CHECK_EQUAL(Subgraphs::complete(tetrapeptide, bondPattern).size(), 0);
 }
+
+BOOST_AUTO_TEST_CASE(SubgraphAnytimeMaximum, *boost::unit_test::label("Molassembler")) {
+  const Molecule neopentane = IO::Experimental::parseSmilesSingleMolecule("CC(C)(C)C");
+  const Molecule methyl = IO::Experimental::parseSmilesSingleMolecule("[CH3]");
+
+  // Matches the size of the exhaustive search
+  const auto result = Subgraphs::anytimeMaximum(methyl.graph(), neopentane.graph());
+  BOOST_CHECK(result.optimal);
+  BOOST_CHECK_EQUAL(result.mapping.size(), Subgraphs::maximum(methyl, neopentane).front().size());
+
+  const Molecule isobutanol = IO::Experimental::parseSmilesSingleMolecule("CC(C)CO");
+  const Molecule isobutylamine = IO::Experimental::parseSmilesSingleMolecule("CC(C)CN");
+  Subgraphs::SearchBudget budget;
+  budget.parallel = true;
+  const auto parallelResult = Subgraphs::anytimeMaximum(isobutanol.graph(), isobutylamine.graph(), budget);
+  BOOST_CHECK(parallelResult.optimal);
+  /* The carbon skeleton with its hydrogens, and the hydroxyl hydrogen as an
+   * isolated vertex mapped onto an amine hydrogen
+   */
+  BOOST_CHECK_EQUAL(parallelResult.mapping.size(), 4 + 9 + 1);
+
+  // The mapping is a common induced subgraph
+  const auto& a = isobutanol.graph();
+  const auto& b = isobutylamine.graph();
+  for(const auto& first : parallelResult.mapping.left) {
+    BOOST_CHECK(a.elementType(first.first) == b.elementType(first.second));
+    for(const auto& second : parallelResult.mapping.left) {
+      BOOST_CHECK_EQUAL(
+        static_cast<bool>(a.bond(first.first, second.first)),
+        static_cast<bool>(b.bond(first.second, second.second))
+      );
+    }
+  }
+
+  // A budget of a single node yields an unproven result
+  Subgraphs::SearchBudget tinyBudget;
+  tinyBudget.nodes = 1;
+  const auto budgetResult = Subgraphs::anytimeMaximum(isobutanol.graph(), isobutylamine.graph(), tinyBudget);
+  BOOST_CHECK(!budgetResult.optimal);
+  BOOST_CHECK_LE(budgetResult.mapping.size(), parallelResult.mapping.size());
+}
+
+BOOST_AUTO_TEST_CASE(SubgraphMatcherModes, *boost::unit_test::label("Molassembler")) {
+  const Molecule neopentane = IO::Experimental::parseSmilesSingleMolecule("CC(C)(C)C");
+  const Molecule methyl = IO::Experimental::parseSmilesSingleMolecule("[CH3]");
+
+  // Each of the four methyl groups, with all permutations of its hydrogens
+  const Subgraphs::Matcher methylMatcher {methyl.graph()};
+  BOOST_CHECK_EQUAL(methylMatcher.count(neopentane.graph()), 24);
+  BOOST_CHECK_EQUAL(methylMatcher.find(neopentane.graph(), 5).size(), 5);
+  const auto firstOption = methylMatcher.first(neopentane.graph());
+  BOOST_REQUIRE(firstOption);
+  BOOST_CHECK_EQUAL(firstOption->size(), methyl.graph().N());
+  for(const auto& mapping : firstOption->left) {
+    BOOST_CHECK(methyl.graph().elementType(mapping.first) == neopentane.graph().elementType(mapping.second));
+  }
+
+  // Suppressing automorphic mappings matches complete()
+  const Subgraphs::Matcher uniqueMethylMatcher {
+    methyl.graph(),
+    Subgraphs::VertexStrictness::ElementType,
+    Subgraphs::EdgeStrictness::Topographic,
+    true
+  };
+  BOOST_CHECK_EQUAL(
+    uniqueMethylMatcher.count(neopentane.graph()),
+    Subgraphs::complete(methyl, neopentane).size()
+  );
+
+  // A ring needle does not map onto chains
+  const Molecule benzene = IO::Experimental::parseSmilesSingleMolecule("c1ccccc1");
+  const Molecule cyclohexane = IO::Experimental::parseSmilesSingleMolecule("C1CCCCC1");
+  const Molecule hexane = IO::Experimental::parseSmilesSingleMolecule("CCCCCC");
+  const Molecule ring = IO::Experimental::parseSmilesSingleMolecule("[C]1[C][C][C][C][C]1");
+  const Subgraphs::Matcher ringMatcher {ring.graph()};
+  BOOST_CHECK_EQUAL(ringMatcher.count(benzene.graph()), 12);
+  BOOST_CHECK_EQUAL(ringMatcher.count(cyclohexane.graph()), 12);
+  BOOST_CHECK_EQUAL(ringMatcher.count(hexane.graph()), 0);
+  const Subgraphs::Matcher uniqueRingMatcher {
+    ring.graph(),
+    Subgraphs::VertexStrictness::ElementType,
+    Subgraphs::EdgeStrictness::Topographic,
+    true
+  };
+  BOOST_CHECK_EQUAL(uniqueRingMatcher.count(benzene.graph()), 1);
+
+  // Bond type strictness and streaming with early termination
+  const Molecule tetrapeptide = IO::Experimental::parseSmilesSingleMolecule("CC(C)C(N)C(=O)NCC(=O)NC(CO)C(=O)NC(C)C(=O)O");
+  const auto bondPattern = IO::Experimental::parseSmilesSingleMolecule("[C](=O)[NH]");
+  const Subgraphs::Matcher peptideMatcher {
+    bondPattern.graph(),
+    Subgraphs::VertexStrictness::ElementType,
+    Subgraphs::EdgeStrictness::BondType
+  };
+  BOOST_CHECK_EQUAL(
+    peptideMatcher.count(tetrapeptide.graph()),
+    Subgraphs::complete(bondPattern, tetrapeptide, Subgraphs::VertexStrictness::ElementType, Subgraphs::EdgeStrictness::BondType).size()
+  );
+  unsigned calls = 0;
+  const unsigned reported = peptideMatcher.stream(
+    tetrapeptide.graph(),
+    [&](const Subgraphs::Matcher::Mapping& mapping) -> bool {
+      BOOST_CHECK_EQUAL(mapping.size(), bondPattern.graph().N());
+      return ++calls < 2;
+    }
+  );
+  BOOST_CHECK_EQUAL(reported, 2);
+  BOOST_CHECK_EQUAL(peptideMatcher.count(bondPattern.graph()), 1);
+  BOOST_CHECK(!peptideMatcher.first(hexane.graph()));
+}
+
+BOOST_AUTO_TEST_CASE(SubgraphLibraryScreening, *boost::unit_test::label("Molassembler")) {
+  const std::vector<std::string> librarySmiles {
+    "CC(C)C(N)C(=O)NCC(=O)NC(CO)C(=O)NC(C)C(=O)O",
+    "CCCCCC",
+    "CC(=O)OC",
+    "NCC(=O)NCC(=O)O",
+    "c1ccccc1"
+  };
+  std::vector<Molecule> molecules;
+  for(const auto& smiles : librarySmiles) {
+    molecules.push_back(IO::Experimental::parseSmilesSingleMolecule(smiles));
+  }
+  const Subgraphs::Library library {molecules};
+  BOOST_REQUIRE_EQUAL(library.size(), librarySmiles.size());
+
+  const auto bondPattern = IO::Experimental::parseSmilesSingleMolecule("[C](=O)[NH]");
+
+  // Screening never discards a molecule that contains the needle
+  for(const auto edgeStrictness : {Subgraphs::EdgeStrictness::Topographic, Subgraphs::EdgeStrictness::BondType}) {
+    const auto candidates = library.screen(bondPattern.graph(), edgeStrictness);
+    for(unsigned i = 0; i < library.size(); ++i) {
+      if(!Subgraphs::complete(bondPattern.graph(), library.at(i).graph(), Subgraphs::VertexStrictness::ElementType, edgeStrictness).empty()) {
+        BOOST_CHECK(std::find(std::begin(candidates), std::end(candidates), i) != std::end(candidates));
+      }
+    }
+  }
+
+  // Neither the alkane nor benzene contain nitrogen
+  const auto candidates = library.screen(bondPattern.graph());
+  BOOST_CHECK(std::find(std::begin(candidates), std::end(candidates), 1) == std::end(candidates));
+  BOOST_CHECK(std::find(std::begin(candidates), std::end(candidates), 4) == std::end(candidates));
+
+  BOOST_CHECK_EQUAL(library.count(bondPattern.graph()), 2);
+
+  std::map<unsigned, unsigned> mappingCounts;
+  library.search(
+    bondPattern.graph(),
+    [&](const unsigned i, std::vector<Subgraphs::IndexMap> mappings) -> bool {
+      mappingCounts[i] = mappings.size();
+      return true;
+    }
+  );
+  BOOST_CHECK_EQUAL(mappingCounts.size(), 2);
+  BOOST_CHECK_EQUAL(mappingCounts[0], 3);
+  BOOST_CHECK_EQUAL(mappingCounts[3], 1);
+
+  // Stopping after the first matching molecule with a single mapping
+  unsigned calls = 0;
+  library.search(
+    bondPattern.graph(),
+    [&](const unsigned /* i */, std::vector<Subgraphs::IndexMap> mappings) -> bool {
+      ++calls;
+      BOOST_CHECK_EQUAL(mappings.size(), 1);
+      return false;
+    },
+    Subgraphs::Library::Matches::First
+  );
+  BOOST_CHECK_EQUAL(calls, 1);
+}